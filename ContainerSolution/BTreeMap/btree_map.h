@@ -0,0 +1,1025 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace STDev
+{
+	// B+ tree ordinato con la stessa interfaccia di map.
+	// Ogni nodo occupa circa NodeBytes byte: le chiavi sono in un array contiguo (la ricerca
+	// nel nodo e' una binary search senza salti, tutta dentro poche cache line) e ogni livello
+	// costa un solo cache miss invece di uno per nodo come nel RB-Tree.
+	// I valori stanno solo nelle foglie, collegate in lista doppia per l'iterazione ordinata.
+	//
+	// Split e merge sono fatti scendendo (preemptive): insert ed erase fanno una sola discesa
+	// dalla radice, senza parent pointer e senza ricorsione.
+	//
+	// Requisiti: K e V default-constructible e assegnabili (gli slot dei nodi sono array).
+	template<typename K, typename V, size_t NodeBytes = 256>
+	class btree_map
+	{
+	private:
+
+		struct NodeBase
+		{
+			bool leaf;
+			uint16_t count; // chiavi in uso
+		};
+
+		static constexpr size_t slots_for(size_t payload, size_t per_slot)
+		{
+			return (NodeBytes > payload && (NodeBytes - payload) / per_slot > 4) ? (NodeBytes - payload) / per_slot : 4;
+		}
+
+	public:
+
+		static constexpr int LEAF_SLOTS = static_cast<int>(slots_for(sizeof(NodeBase) + 2 * sizeof(void*), sizeof(K) + sizeof(V)));
+		static constexpr int INNER_SLOTS = static_cast<int>(slots_for(sizeof(NodeBase) + sizeof(void*), sizeof(K) + sizeof(void*)));
+
+	private:
+
+		static_assert(LEAF_SLOTS < 65536 && INNER_SLOTS < 65536, "btree_map: NodeBytes troppo grande per count a 16 bit");
+
+		// minimo di chiavi per i nodi non radice
+		static constexpr int LEAF_MIN = LEAF_SLOTS / 2;
+		static constexpr int INNER_MIN = (INNER_SLOTS - 1) / 2;
+
+		struct Leaf : NodeBase
+		{
+			K keys[LEAF_SLOTS];
+			V values[LEAF_SLOTS];
+			Leaf* prev;
+			Leaf* next;
+
+			Leaf() : NodeBase{ true, 0 }, prev(nullptr), next(nullptr)
+			{}
+		};
+
+		// count chiavi separano count + 1 figli: children[i] < keys[i] <= children[i + 1]
+		struct Inner : NodeBase
+		{
+			K keys[INNER_SLOTS];
+			NodeBase* children[INNER_SLOTS + 1];
+
+			Inner() : NodeBase{ false, 0 }
+			{}
+		};
+
+		NodeBase* root;
+		Leaf* first_leaf;
+		Leaf* last_leaf;
+		size_t _size;
+		int _height; // livelli, 0 se vuoto
+
+		static Leaf* as_leaf(NodeBase* node) { return static_cast<Leaf*>(node); }
+		static Inner* as_inner(NodeBase* node) { return static_cast<Inner*>(node); }
+		static const Leaf* as_leaf(const NodeBase* node) { return static_cast<const Leaf*>(node); }
+		static const Inner* as_inner(const NodeBase* node) { return static_cast<const Inner*>(node); }
+
+		// primo indice con keys[i] >= key. Binary search senza salti: il confronto sceglie
+		// solo di quanto avanzare (cmov), quindi niente branch misprediction dentro il nodo
+		static int lower_index(const K* keys, int count, const K& key)
+		{
+			if (count == 0)
+				return 0;
+
+			const K* base = keys;
+			int length = count;
+			while (length > 1)
+			{
+				int half = length / 2;
+				base += (base[half - 1] < key) ? half : 0;
+				length -= half;
+			}
+			return static_cast<int>(base - keys) + (*base < key ? 1 : 0);
+		}
+
+		// primo indice con keys[i] > key: il figlio da seguire in un nodo interno
+		static int upper_index(const K* keys, int count, const K& key)
+		{
+			if (count == 0)
+				return 0;
+
+			const K* base = keys;
+			int length = count;
+			while (length > 1)
+			{
+				int half = length / 2;
+				base += (key < base[half - 1]) ? 0 : half;
+				length -= half;
+			}
+			return static_cast<int>(base - keys) + (key < *base ? 0 : 1);
+		}
+
+		static bool is_full(const NodeBase* node)
+		{
+			return node->count == (node->leaf ? LEAF_SLOTS : INNER_SLOTS);
+		}
+
+		static bool at_minimum(const NodeBase* node)
+		{
+			return node->count <= (node->leaf ? LEAF_MIN : INNER_MIN);
+		}
+
+		// foglia e posizione della chiave, nullptr se assente
+		const Leaf* find_leaf(const K& key, int& index) const
+		{
+			const NodeBase* node = root;
+			if (node == nullptr)
+				return nullptr;
+
+			while (!node->leaf)
+			{
+				const Inner* inner = as_inner(node);
+				node = inner->children[upper_index(inner->keys, inner->count, key)];
+			}
+
+			const Leaf* leaf = as_leaf(node);
+			index = lower_index(leaf->keys, leaf->count, key);
+			if (index < leaf->count && !(key < leaf->keys[index]))
+				return leaf;
+			return nullptr;
+		}
+
+		// primo elemento >= key (o > key se strict) come coppia foglia/indice; foglia nullptr = end
+		std::pair<const Leaf*, int> bound(const K& key, bool strict) const
+		{
+			const NodeBase* node = root;
+			if (node == nullptr)
+				return { nullptr, 0 };
+
+			while (!node->leaf)
+			{
+				const Inner* inner = as_inner(node);
+				node = inner->children[upper_index(inner->keys, inner->count, key)];
+			}
+
+			const Leaf* leaf = as_leaf(node);
+			int index = strict ? upper_index(leaf->keys, leaf->count, key) : lower_index(leaf->keys, leaf->count, key);
+			if (index == leaf->count)
+			{
+				leaf = leaf->next;
+				index = 0;
+			}
+			return { leaf, index };
+		}
+
+		// divide il figlio pieno parent->children[i]; la meta' destra diventa children[i + 1]
+		void split_child(Inner* parent, int i)
+		{
+			NodeBase* child = parent->children[i];
+			K separator;
+			NodeBase* right_node;
+
+			if (child->leaf)
+			{
+				Leaf* left = as_leaf(child);
+				Leaf* right = new Leaf();
+				int keep = left->count / 2;
+
+				for (int k = keep; k < left->count; ++k)
+				{
+					right->keys[k - keep] = std::move(left->keys[k]);
+					right->values[k - keep] = std::move(left->values[k]);
+				}
+				right->count = static_cast<uint16_t>(left->count - keep);
+				left->count = static_cast<uint16_t>(keep);
+
+				right->next = left->next;
+				right->prev = left;
+				if (left->next != nullptr)
+					left->next->prev = right;
+				else
+					last_leaf = right;
+				left->next = right;
+
+				separator = right->keys[0]; // in un B+ tree la chiave resta anche nella foglia
+				right_node = right;
+			}
+			else
+			{
+				Inner* left = as_inner(child);
+				Inner* right = new Inner();
+				int mid = left->count / 2;
+
+				for (int k = mid + 1; k < left->count; ++k)
+					right->keys[k - mid - 1] = std::move(left->keys[k]);
+				for (int k = mid + 1; k <= left->count; ++k)
+					right->children[k - mid - 1] = left->children[k];
+
+				right->count = static_cast<uint16_t>(left->count - mid - 1);
+				separator = std::move(left->keys[mid]); // sale nel padre
+				left->count = static_cast<uint16_t>(mid);
+				right_node = right;
+			}
+
+			for (int k = parent->count; k > i; --k)
+			{
+				parent->keys[k] = std::move(parent->keys[k - 1]);
+				parent->children[k + 1] = parent->children[k];
+			}
+			parent->keys[i] = std::move(separator);
+			parent->children[i + 1] = right_node;
+			parent->count++;
+		}
+
+		// garantisce che parent->children[i] abbia piu' del minimo prima di scenderci,
+		// prestando da un fratello o fondendo; ritorna l'indice del figlio da seguire
+		int fix_child(Inner* parent, int i)
+		{
+			NodeBase* left = i > 0 ? parent->children[i - 1] : nullptr;
+			NodeBase* right = i < parent->count ? parent->children[i + 1] : nullptr;
+
+			if (left != nullptr && !at_minimum(left))
+			{
+				borrow_from_left(parent, i);
+				return i;
+			}
+			if (right != nullptr && !at_minimum(right))
+			{
+				borrow_from_right(parent, i);
+				return i;
+			}
+
+			if (left != nullptr)
+			{
+				merge_children(parent, i - 1);
+				return i - 1;
+			}
+			merge_children(parent, i);
+			return i;
+		}
+
+		void borrow_from_left(Inner* parent, int i)
+		{
+			NodeBase* child = parent->children[i];
+			NodeBase* sibling = parent->children[i - 1];
+
+			if (child->leaf)
+			{
+				Leaf* c = as_leaf(child);
+				Leaf* l = as_leaf(sibling);
+				for (int k = c->count; k > 0; --k)
+				{
+					c->keys[k] = std::move(c->keys[k - 1]);
+					c->values[k] = std::move(c->values[k - 1]);
+				}
+				c->keys[0] = std::move(l->keys[l->count - 1]);
+				c->values[0] = std::move(l->values[l->count - 1]);
+				parent->keys[i - 1] = c->keys[0];
+			}
+			else
+			{
+				Inner* c = as_inner(child);
+				Inner* l = as_inner(sibling);
+				for (int k = c->count; k > 0; --k)
+					c->keys[k] = std::move(c->keys[k - 1]);
+				for (int k = c->count + 1; k > 0; --k)
+					c->children[k] = c->children[k - 1];
+				c->keys[0] = std::move(parent->keys[i - 1]);
+				c->children[0] = l->children[l->count];
+				parent->keys[i - 1] = std::move(l->keys[l->count - 1]);
+			}
+
+			child->count++;
+			sibling->count--;
+		}
+
+		void borrow_from_right(Inner* parent, int i)
+		{
+			NodeBase* child = parent->children[i];
+			NodeBase* sibling = parent->children[i + 1];
+
+			if (child->leaf)
+			{
+				Leaf* c = as_leaf(child);
+				Leaf* r = as_leaf(sibling);
+				c->keys[c->count] = std::move(r->keys[0]);
+				c->values[c->count] = std::move(r->values[0]);
+				for (int k = 1; k < r->count; ++k)
+				{
+					r->keys[k - 1] = std::move(r->keys[k]);
+					r->values[k - 1] = std::move(r->values[k]);
+				}
+				parent->keys[i] = r->keys[0];
+			}
+			else
+			{
+				Inner* c = as_inner(child);
+				Inner* r = as_inner(sibling);
+				c->keys[c->count] = std::move(parent->keys[i]);
+				c->children[c->count + 1] = r->children[0];
+				parent->keys[i] = std::move(r->keys[0]);
+				for (int k = 1; k < r->count; ++k)
+					r->keys[k - 1] = std::move(r->keys[k]);
+				for (int k = 1; k <= r->count; ++k)
+					r->children[k - 1] = r->children[k];
+			}
+
+			child->count++;
+			sibling->count--;
+		}
+
+		// fonde children[i + 1] dentro children[i] e toglie il separatore keys[i] dal padre
+		void merge_children(Inner* parent, int i)
+		{
+			NodeBase* left_node = parent->children[i];
+			NodeBase* right_node = parent->children[i + 1];
+
+			if (left_node->leaf)
+			{
+				Leaf* l = as_leaf(left_node);
+				Leaf* r = as_leaf(right_node);
+				for (int k = 0; k < r->count; ++k)
+				{
+					l->keys[l->count + k] = std::move(r->keys[k]);
+					l->values[l->count + k] = std::move(r->values[k]);
+				}
+				l->count = static_cast<uint16_t>(l->count + r->count);
+
+				l->next = r->next;
+				if (r->next != nullptr)
+					r->next->prev = l;
+				else
+					last_leaf = l;
+				delete r;
+			}
+			else
+			{
+				Inner* l = as_inner(left_node);
+				Inner* r = as_inner(right_node);
+				l->keys[l->count] = std::move(parent->keys[i]);
+				for (int k = 0; k < r->count; ++k)
+					l->keys[l->count + 1 + k] = std::move(r->keys[k]);
+				for (int k = 0; k <= r->count; ++k)
+					l->children[l->count + 1 + k] = r->children[k];
+				l->count = static_cast<uint16_t>(l->count + 1 + r->count);
+				delete r;
+			}
+
+			for (int k = i; k < parent->count - 1; ++k)
+			{
+				parent->keys[k] = std::move(parent->keys[k + 1]);
+				parent->children[k + 1] = parent->children[k + 2];
+			}
+			parent->count--;
+		}
+
+		void destroy(NodeBase* node)
+		{
+			if (node == nullptr)
+				return;
+
+			if (node->leaf)
+			{
+				delete as_leaf(node);
+				return;
+			}
+
+			Inner* inner = as_inner(node);
+			for (int k = 0; k <= inner->count; ++k)
+				destroy(inner->children[k]);
+			delete inner;
+		}
+
+		// copia ricorsiva (profondita' = altezza, pochi livelli); prev ricollega le foglie in ordine
+		NodeBase* clone(const NodeBase* node, Leaf*& prev)
+		{
+			if (node->leaf)
+			{
+				const Leaf* source = as_leaf(node);
+				Leaf* copy = new Leaf();
+				for (int k = 0; k < source->count; ++k)
+				{
+					copy->keys[k] = source->keys[k];
+					copy->values[k] = source->values[k];
+				}
+				copy->count = source->count;
+
+				copy->prev = prev;
+				if (prev != nullptr)
+					prev->next = copy;
+				else
+					first_leaf = copy;
+				prev = copy;
+				return copy;
+			}
+
+			const Inner* source = as_inner(node);
+			Inner* copy = new Inner();
+			for (int k = 0; k < source->count; ++k)
+				copy->keys[k] = source->keys[k];
+			for (int k = 0; k <= source->count; ++k)
+				copy->children[k] = clone(source->children[k], prev);
+			copy->count = source->count;
+			return copy;
+		}
+
+		void copy_from(const btree_map& other)
+		{
+			if (other.root != nullptr)
+			{
+				Leaf* prev = nullptr;
+				root = clone(other.root, prev);
+				last_leaf = prev;
+			}
+			_size = other._size;
+			_height = other._height;
+		}
+
+		// -1 se il sottoalbero viola ordine, riempimento o profondita' uniforme delle foglie
+		int check_node(const NodeBase* node, const K* low, const K* high, bool is_root) const
+		{
+			int minimum = node->leaf ? LEAF_MIN : INNER_MIN;
+			if (!is_root && node->count < minimum)
+			{
+				std::cout << "ERRORE: nodo con " << node->count << " chiavi (minimo " << minimum << ")" << std::endl;
+				return -1;
+			}
+
+			const K* keys = node->leaf ? as_leaf(node)->keys : as_inner(node)->keys;
+			for (int k = 0; k < node->count; ++k)
+			{
+				if ((k > 0 && !(keys[k - 1] < keys[k])) ||
+					(low != nullptr && keys[k] < *low) ||
+					(high != nullptr && !(keys[k] < *high)))
+				{
+					std::cout << "ERRORE: chiave [" << keys[k] << "] fuori ordine" << std::endl;
+					return -1;
+				}
+			}
+
+			if (node->leaf)
+				return 1;
+
+			const Inner* inner = as_inner(node);
+			int depth = -1;
+			for (int k = 0; k <= inner->count; ++k)
+			{
+				const K* child_low = k > 0 ? &inner->keys[k - 1] : low;
+				const K* child_high = k < inner->count ? &inner->keys[k] : high;
+				int child_depth = check_node(inner->children[k], child_low, child_high, false);
+				if (child_depth < 0 || (depth != -1 && child_depth != depth))
+				{
+					if (child_depth >= 0)
+						std::cout << "ERRORE: foglie a profondita' diverse" << std::endl;
+					return -1;
+				}
+				depth = child_depth;
+			}
+			return depth + 1;
+		}
+
+		void print_node(const NodeBase* node, const std::string& prefix) const
+		{
+			std::cout << prefix << (node->leaf ? "Leaf [" : "Inner [");
+			const K* keys = node->leaf ? as_leaf(node)->keys : as_inner(node)->keys;
+			for (int k = 0; k < node->count; ++k)
+				std::cout << (k > 0 ? " " : "") << keys[k];
+			std::cout << "]" << std::endl;
+
+			if (!node->leaf)
+			{
+				const Inner* inner = as_inner(node);
+				for (int k = 0; k <= inner->count; ++k)
+					print_node(inner->children[k], prefix + "    ");
+			}
+		}
+
+	public:
+
+		class iterator;
+		class const_iterator;
+
+		btree_map() : root(nullptr), first_leaf(nullptr), last_leaf(nullptr), _size(0), _height(0)
+		{}
+
+		~btree_map()
+		{
+			destroy(root);
+		}
+
+		btree_map(const btree_map& other) : btree_map()
+		{
+			copy_from(other);
+		}
+
+		btree_map& operator=(const btree_map& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				copy_from(other);
+			}
+			return *this;
+		}
+
+		btree_map(btree_map&& other) noexcept
+			: root(other.root), first_leaf(other.first_leaf), last_leaf(other.last_leaf),
+			_size(other._size), _height(other._height)
+		{
+			other.root = nullptr;
+			other.first_leaf = nullptr;
+			other.last_leaf = nullptr;
+			other._size = 0;
+			other._height = 0;
+		}
+
+		btree_map& operator=(btree_map&& other) noexcept
+		{
+			if (this != &other)
+			{
+				destroy(root);
+				root = other.root;
+				first_leaf = other.first_leaf;
+				last_leaf = other.last_leaf;
+				_size = other._size;
+				_height = other._height;
+				other.root = nullptr;
+				other.first_leaf = nullptr;
+				other.last_leaf = nullptr;
+				other._size = 0;
+				other._height = 0;
+			}
+			return *this;
+		}
+
+		// costruisce il valore da args solo se la chiave manca
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			if (root == nullptr)
+			{
+				Leaf* leaf = new Leaf();
+				root = first_leaf = last_leaf = leaf;
+				_height = 1;
+			}
+
+			if (is_full(root))
+			{
+				Inner* new_root = new Inner();
+				new_root->children[0] = root;
+				root = new_root;
+				split_child(new_root, 0);
+				_height++;
+			}
+
+			NodeBase* node = root;
+			while (!node->leaf)
+			{
+				Inner* inner = as_inner(node);
+				int i = upper_index(inner->keys, inner->count, key);
+				if (is_full(inner->children[i]))
+				{
+					split_child(inner, i);
+					if (!(key < inner->keys[i]))
+						i++;
+				}
+				node = inner->children[i];
+			}
+
+			Leaf* leaf = as_leaf(node);
+			int index = lower_index(leaf->keys, leaf->count, key);
+			if (index < leaf->count && !(key < leaf->keys[index]))
+				return { iterator(this, leaf, index), false };
+
+			for (int k = leaf->count; k > index; --k)
+			{
+				leaf->keys[k] = std::move(leaf->keys[k - 1]);
+				leaf->values[k] = std::move(leaf->values[k - 1]);
+			}
+			leaf->keys[index] = key;
+			leaf->values[index] = V(std::forward<Args>(args)...);
+			leaf->count++;
+			_size++;
+
+			return { iterator(this, leaf, index), true };
+		}
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+		{
+			std::pair<iterator, bool> result = try_emplace(key);
+			result.first.value() = std::forward<M>(value);
+			return result;
+		}
+
+		// come map::insert: una chiave esistente viene sovrascritta
+		void insert(const K& key, const V& value)
+		{
+			insert_or_assign(key, value);
+		}
+
+		V& operator[](const K& key)
+		{
+			return try_emplace(key).first.value();
+		}
+
+		iterator find(const K& key)
+		{
+			int index = 0;
+			Leaf* leaf = const_cast<Leaf*>(find_leaf(key, index));
+			return iterator(this, leaf, leaf != nullptr ? index : 0);
+		}
+
+		const_iterator find(const K& key) const
+		{
+			int index = 0;
+			const Leaf* leaf = find_leaf(key, index);
+			return const_iterator(this, leaf, leaf != nullptr ? index : 0);
+		}
+
+		bool contains(const K& key) const
+		{
+			int index;
+			return find_leaf(key, index) != nullptr;
+		}
+
+		V& at(const K& key)
+		{
+			int index;
+			const Leaf* leaf = find_leaf(key, index);
+			if (!leaf)
+				throw std::out_of_range("btree_map::at: key not found");
+			return const_cast<Leaf*>(leaf)->values[index];
+		}
+
+		const V& at(const K& key) const
+		{
+			int index;
+			const Leaf* leaf = find_leaf(key, index);
+			if (!leaf)
+				throw std::out_of_range("btree_map::at: key not found");
+			return leaf->values[index];
+		}
+
+		bool erase(const K& key)
+		{
+			if (root == nullptr)
+				return false;
+
+			NodeBase* node = root;
+			while (!node->leaf)
+			{
+				Inner* inner = as_inner(node);
+				int i = upper_index(inner->keys, inner->count, key);
+				if (at_minimum(inner->children[i]))
+					i = fix_child(inner, i);
+				node = inner->children[i];
+			}
+
+			Leaf* leaf = as_leaf(node);
+			int index = lower_index(leaf->keys, leaf->count, key);
+			bool erased = index < leaf->count && !(key < leaf->keys[index]);
+			if (erased)
+			{
+				for (int k = index + 1; k < leaf->count; ++k)
+				{
+					leaf->keys[k - 1] = std::move(leaf->keys[k]);
+					leaf->values[k - 1] = std::move(leaf->values[k]);
+				}
+				leaf->count--;
+				_size--;
+			}
+
+			// una radice interna svuotata dai merge cede il posto al suo unico figlio
+			if (!root->leaf && root->count == 0)
+			{
+				Inner* old_root = as_inner(root);
+				root = old_root->children[0];
+				delete old_root;
+				_height--;
+			}
+			else if (root->leaf && root->count == 0)
+			{
+				delete as_leaf(root);
+				root = first_leaf = last_leaf = nullptr;
+				_height = 0;
+			}
+
+			return erased;
+		}
+
+		void clear()
+		{
+			destroy(root);
+			root = first_leaf = last_leaf = nullptr;
+			_size = 0;
+			_height = 0;
+		}
+
+		iterator lower_bound(const K& key)
+		{
+			std::pair<const Leaf*, int> position = bound(key, false);
+			return iterator(this, const_cast<Leaf*>(position.first), position.second);
+		}
+
+		const_iterator lower_bound(const K& key) const
+		{
+			std::pair<const Leaf*, int> position = bound(key, false);
+			return const_iterator(this, position.first, position.second);
+		}
+
+		iterator upper_bound(const K& key)
+		{
+			std::pair<const Leaf*, int> position = bound(key, true);
+			return iterator(this, const_cast<Leaf*>(position.first), position.second);
+		}
+
+		const_iterator upper_bound(const K& key) const
+		{
+			std::pair<const Leaf*, int> position = bound(key, true);
+			return const_iterator(this, position.first, position.second);
+		}
+
+		std::pair<iterator, iterator> equal_range(const K& key)
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		// visita in ordine le coppie con first <= chiave < last: una discesa, poi le foglie in sequenza
+		template<typename Func>
+		void for_each_in_range(const K& first, const K& last, Func func) const
+		{
+			std::pair<const Leaf*, int> position = bound(first, false);
+			for (const Leaf* leaf = position.first; leaf != nullptr; leaf = leaf->next)
+			{
+				for (int k = (leaf == position.first ? position.second : 0); k < leaf->count; ++k)
+				{
+					if (!(leaf->keys[k] < last))
+						return;
+					func(std::pair<const K&, const V&>(leaf->keys[k], leaf->values[k]));
+				}
+			}
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		bool empty() const
+		{
+			return _size == 0;
+		}
+
+		int height() const
+		{
+			return _height;
+		}
+
+		bool is_valid_btree() const
+		{
+			if (root == nullptr)
+				return _size == 0 && first_leaf == nullptr && last_leaf == nullptr;
+
+			int depth = check_node(root, nullptr, nullptr, true);
+			if (depth < 0)
+				return false;
+			if (depth != _height)
+			{
+				std::cout << "ERRORE: altezza " << _height << " invece di " << depth << std::endl;
+				return false;
+			}
+
+			// la catena delle foglie deve contenere tutti gli elementi, in entrambe le direzioni
+			size_t forward = 0;
+			const Leaf* previous = nullptr;
+			for (const Leaf* leaf = first_leaf; leaf != nullptr; leaf = leaf->next)
+			{
+				if (leaf->prev != previous)
+				{
+					std::cout << "ERRORE: link prev della foglia non coerente" << std::endl;
+					return false;
+				}
+				forward += leaf->count;
+				previous = leaf;
+			}
+			if (previous != last_leaf || forward != _size)
+			{
+				std::cout << "ERRORE: catena delle foglie con " << forward << " elementi invece di " << _size << std::endl;
+				return false;
+			}
+
+			return true;
+		}
+
+		void print_tree() const
+		{
+			std::cout << "\n=== B+ TREE STRUCTURE ===" << std::endl;
+			std::cout << "Size: " << _size << "  Height: " << _height
+				<< "  Slots: " << INNER_SLOTS << " inner / " << LEAF_SLOTS << " leaf" << std::endl;
+			if (root != nullptr)
+				print_node(root, "");
+			std::cout << "=========================\n" << std::endl;
+		}
+
+		// *it restituisce una coppia di riferimenti: chiavi e valori non sono contigui in memoria
+		class iterator // bidirectional iterator sulle foglie
+		{
+		private:
+			const btree_map* owner;
+			Leaf* leaf;
+			int index;
+
+			struct arrow_proxy
+			{
+				std::pair<const K&, V&> pair;
+				std::pair<const K&, V&>* operator->() { return &pair; }
+			};
+
+		public:
+			iterator(const btree_map* map = nullptr, Leaf* l = nullptr, int i = 0) : owner(map), leaf(l), index(i)
+			{}
+
+			const K& key() const { return leaf->keys[index]; }
+			V& value() const { return leaf->values[index]; }
+
+			std::pair<const K&, V&> operator*() const
+			{
+				return { leaf->keys[index], leaf->values[index] };
+			}
+
+			arrow_proxy operator->() const
+			{
+				return arrow_proxy{ { leaf->keys[index], leaf->values[index] } };
+			}
+
+			iterator& operator++()
+			{
+				if (++index == leaf->count)
+				{
+					leaf = leaf->next;
+					index = 0;
+				}
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			iterator& operator--()
+			{
+				if (leaf == nullptr) // --end()
+				{
+					leaf = owner->last_leaf;
+					index = leaf->count - 1;
+				}
+				else if (index-- == 0)
+				{
+					leaf = leaf->prev;
+					index = leaf->count - 1;
+				}
+				return *this;
+			}
+
+			iterator operator--(int)
+			{
+				iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return leaf == other.leaf && index == other.index;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+			friend class btree_map;
+			friend class const_iterator;
+		};//end iterator class
+
+		class const_iterator
+		{
+		private:
+			const btree_map* owner;
+			const Leaf* leaf;
+			int index;
+
+			struct arrow_proxy
+			{
+				std::pair<const K&, const V&> pair;
+				const std::pair<const K&, const V&>* operator->() const { return &pair; }
+			};
+
+		public:
+			const_iterator(const btree_map* map = nullptr, const Leaf* l = nullptr, int i = 0) : owner(map), leaf(l), index(i)
+			{}
+
+			const_iterator(const iterator& it) : owner(it.owner), leaf(it.leaf), index(it.index)
+			{}
+
+			const K& key() const { return leaf->keys[index]; }
+			const V& value() const { return leaf->values[index]; }
+
+			std::pair<const K&, const V&> operator*() const
+			{
+				return { leaf->keys[index], leaf->values[index] };
+			}
+
+			arrow_proxy operator->() const
+			{
+				return arrow_proxy{ { leaf->keys[index], leaf->values[index] } };
+			}
+
+			const_iterator& operator++()
+			{
+				if (++index == leaf->count)
+				{
+					leaf = leaf->next;
+					index = 0;
+				}
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			const_iterator& operator--()
+			{
+				if (leaf == nullptr)
+				{
+					leaf = owner->last_leaf;
+					index = leaf->count - 1;
+				}
+				else if (index-- == 0)
+				{
+					leaf = leaf->prev;
+					index = leaf->count - 1;
+				}
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return leaf == other.leaf && index == other.index;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+			friend class btree_map;
+		};//end const_iterator class
+
+		iterator begin()
+		{
+			return iterator(this, first_leaf, 0);
+		}
+
+		iterator end()
+		{
+			return iterator(this, nullptr, 0);
+		}
+
+		const_iterator begin() const
+		{
+			return const_iterator(this, first_leaf, 0);
+		}
+
+		const_iterator end() const
+		{
+			return const_iterator(this, nullptr, 0);
+		}
+
+		const_iterator cbegin() const
+		{
+			return begin();
+		}
+
+		const_iterator cend() const
+		{
+			return end();
+		}
+	};
+}
@@ -0,0 +1,543 @@
+#include "btree_map.h"
+#include "map.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+// nodi piccoli: pochi slot per nodo, quindi split e merge anche con poche chiavi
+typedef btree_map<int, int, 64> small_btree;
+
+template<typename Map>
+bool is_sorted_map(const Map& m)
+{
+	bool first = true;
+	int previous = 0;
+	size_t count = 0;
+	for (auto it = m.begin(); it != m.end(); ++it)
+	{
+		if (!first && !(previous < it->first))
+			return false;
+		previous = it->first;
+		first = false;
+		count++;
+	}
+	return count == m.size();
+}
+
+// ==================== TESTS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: BASIC OPERATIONS");
+
+	btree_map<int, std::string> m;
+
+	test_assert(m.empty(), "New btree is empty");
+	test_assert(m.size() == 0 && m.height() == 0, "New btree has size 0 and height 0");
+	test_assert(m.begin() == m.end(), "begin() == end() on empty btree");
+
+	m.insert(5, "five");
+	test_assert(!m.empty() && m.size() == 1, "Size is 1 after insert");
+	test_assert(m.height() == 1, "A single leaf is the root");
+
+	test_assert(m.find(5) != m.end() && m.find(5)->second == "five", "find() returns iterator to existing key");
+	test_assert(m.find(10) == m.end(), "find() returns end() for non-existing key");
+	test_assert(m.contains(5) && !m.contains(6), "contains() agrees with find()");
+	test_assert(m.at(5) == "five", "at() returns correct value");
+
+	m.insert(5, "FIVE");
+	test_assert(m.size() == 1, "Insert on existing key does not grow");
+	test_assert(m.at(5) == "FIVE", "Insert on existing key overwrites (like map)");
+
+	bool thrown = false;
+	try
+	{
+		m.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "at() throws on missing key");
+
+	const btree_map<int, std::string>& cm = m;
+	test_assert(cm.at(5) == "FIVE", "const at()");
+}
+
+void test_insert_variants()
+{
+	section_header("TEST 2: OPERATOR[], TRY_EMPLACE, INSERT_OR_ASSIGN");
+
+	btree_map<std::string, int> m;
+
+	m["apple"] = 5;
+	m["banana"] = 3;
+	test_assert(m.size() == 2, "operator[] inserts new keys");
+	test_assert(m["apple"] == 5, "operator[] reads existing key");
+
+	m["apple"] += 10;
+	test_assert(m.at("apple") == 15, "operator[] returns a modifiable reference");
+
+	int missing = m["cherry"];
+	test_assert(missing == 0 && m.size() == 3, "operator[] default-constructs missing value");
+
+	auto result = m.try_emplace("apple", 99);
+	test_assert(!result.second && result.first->second == 15, "try_emplace does not overwrite");
+
+	result = m.try_emplace("date", 7);
+	test_assert(result.second && result.first->first == "date" && result.first->second == 7, "try_emplace inserts new key");
+
+	result = m.insert_or_assign("date", 8);
+	test_assert(!result.second && m.at("date") == 8, "insert_or_assign overwrites existing key");
+
+	result = m.insert_or_assign("elder", 1);
+	test_assert(result.second && m.size() == 5, "insert_or_assign inserts new key");
+	test_assert(m.is_valid_btree(), "Valid after mixed inserts");
+}
+
+void test_splits()
+{
+	section_header("TEST 3: NODE SPLITS");
+
+	small_btree m;
+	std::cout << "Slots per nodo (NodeBytes = 64): " << small_btree::INNER_SLOTS << " inner, "
+		<< small_btree::LEAF_SLOTS << " leaf" << std::endl;
+
+	for (int i = 0; i < 1000; i++)
+		m.insert(i, i * 10);
+	test_assert(m.size() == 1000 && m.is_valid_btree(), "Ascending inserts keep the btree valid");
+	test_assert(m.height() > 2, "Ascending inserts grow the btree in height");
+
+	small_btree d;
+	for (int i = 1000; i > 0; i--)
+		d.insert(i, i);
+	test_assert(d.size() == 1000 && d.is_valid_btree(), "Descending inserts keep the btree valid");
+
+	bool all_found = true;
+	for (int i = 0; i < 1000; i++)
+		if (!m.contains(i) || m.at(i) != i * 10)
+			all_found = false;
+	test_assert(all_found, "Every key found after splits");
+	test_assert(is_sorted_map(m), "Order preserved after splits");
+
+	// nodi di default: pochi livelli anche con molte chiavi
+	btree_map<int, int> wide;
+	for (int i = 0; i < 100000; i++)
+		wide.insert(i, i);
+	test_assert(wide.height() <= 5, "100000 keys fit in at most 5 levels with 256-byte nodes");
+	test_assert(wide.is_valid_btree(), "Wide btree is valid");
+}
+
+void test_erase()
+{
+	section_header("TEST 4: ERASE, BORROW AND MERGE");
+
+	small_btree m;
+	for (int i = 0; i < 500; i++)
+		m.insert(i, i);
+
+	test_assert(m.erase(250), "Erase existing key returns true");
+	test_assert(!m.erase(250), "Erase missing key returns false");
+	test_assert(!m.contains(250) && m.size() == 499, "Erased key is gone");
+
+	bool valid = true;
+	for (int i = 0; i < 500; i += 2)
+	{
+		m.erase(i);
+		if (!m.is_valid_btree())
+			valid = false;
+	}
+	test_assert(valid, "Valid after every erase of the even keys");
+	test_assert(m.size() == 250 && is_sorted_map(m), "250 odd keys left in order");
+	test_assert(m.begin()->first == 1, "begin() moves after erasing the first key");
+
+	int height_before = m.height();
+	for (int i = 499; i > 50; i -= 2)
+		m.erase(i);
+	test_assert(m.height() < height_before, "Merges shrink the btree in height");
+	test_assert(m.is_valid_btree() && m.size() == 25, "Valid after descending erases");
+
+	for (int i = 1; i < 50; i += 2)
+		m.erase(i);
+	test_assert(m.empty() && m.height() == 0, "Erasing everything empties the btree");
+	test_assert(m.begin() == m.end() && m.is_valid_btree(), "Empty btree is valid");
+
+	m.insert(7, 70);
+	test_assert(m.size() == 1 && m.at(7) == 70, "Reusable after erasing everything");
+
+	m.clear();
+	test_assert(m.empty() && m.begin() == m.end(), "clear() empties the btree");
+}
+
+void test_iterators()
+{
+	section_header("TEST 5: ITERATORS");
+
+	small_btree m;
+	for (int i = 0; i < 100; i++)
+		m.insert((i * 37) % 100, i);
+
+	std::vector<int> visited;
+	for (auto it = m.begin(); it != m.end(); ++it)
+		visited.push_back(it->first);
+
+	bool in_order = visited.size() == 100;
+	for (int i = 0; i < static_cast<int>(visited.size()) && in_order; i++)
+		if (visited[i] != i)
+			in_order = false;
+	test_assert(in_order, "Iteration crosses leaves in order");
+
+	std::vector<int> reversed;
+	auto it = m.end();
+	while (it != m.begin())
+	{
+		--it;
+		reversed.push_back(it.key());
+	}
+	std::reverse(reversed.begin(), reversed.end());
+	test_assert(reversed == visited, "Backward iteration from end()");
+
+	for (auto pair : m)
+		pair.second = pair.first * 2;
+	test_assert(m.at(40) == 80, "Values modifiable through iterator");
+
+	int sum = 0;
+	for (auto [key, value] : m)
+		sum += value - key;
+	test_assert(sum == 4950, "Structured bindings on dereferenced iterator");
+
+	const small_btree& cm = m;
+	long long total = 0;
+	for (auto cit = cm.cbegin(); cit != cm.cend(); ++cit)
+		total += cit->first;
+	test_assert(total == 4950, "const_iterator visits all keys");
+
+	small_btree::const_iterator converted = m.begin();
+	test_assert(converted == cm.begin(), "iterator converts to const_iterator");
+}
+
+void test_range_scan()
+{
+	section_header("TEST 6: LOWER_BOUND, UPPER_BOUND AND RANGE SCAN");
+
+	small_btree m;
+	for (int i = 0; i < 1000; i += 10)
+		m.insert(i, i);
+
+	test_assert(m.lower_bound(30)->first == 30, "lower_bound on existing key");
+	test_assert(m.lower_bound(31)->first == 40, "lower_bound between keys");
+	test_assert(m.lower_bound(-5)->first == 0, "lower_bound before first key");
+	test_assert(m.lower_bound(995) == m.end(), "lower_bound after last key is end()");
+	test_assert(m.upper_bound(30)->first == 40, "upper_bound skips the equal key");
+	test_assert(m.upper_bound(990) == m.end(), "upper_bound of last key is end()");
+
+	auto range = m.equal_range(40);
+	test_assert(range.first->first == 40 && range.second->first == 50, "equal_range on existing key");
+	range = m.equal_range(45);
+	test_assert(range.first == range.second && range.first->first == 50, "equal_range on missing key is empty");
+
+	std::vector<int> in_range;
+	m.for_each_in_range(25, 65, [&in_range](const std::pair<const int&, const int&>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	std::vector<int> expected = { 30, 40, 50, 60 };
+	test_assert(in_range == expected, "for_each_in_range visits [25, 65)");
+
+	in_range.clear();
+	m.for_each_in_range(95, 705, [&in_range](const std::pair<const int&, const int&>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	test_assert(in_range.size() == 61 && in_range.front() == 100 && in_range.back() == 700,
+		"for_each_in_range across many leaves");
+
+	in_range.clear();
+	m.for_each_in_range(30, 30, [&in_range](const std::pair<const int&, const int&>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	test_assert(in_range.empty(), "Empty range visits nothing");
+}
+
+void test_copy_and_move()
+{
+	section_header("TEST 7: COPY AND MOVE");
+
+	btree_map<int, std::string, 64> m1;
+	for (int i = 0; i < 200; i++)
+		m1.insert(i, std::to_string(i));
+
+	btree_map<int, std::string, 64> m2(m1);
+	test_assert(m2.size() == 200 && m2.at(25) == "25", "Copy constructor copies all pairs");
+	test_assert(m2.height() == m1.height() && m2.is_valid_btree(), "Copy keeps the same shape and leaf links");
+
+	auto last = m2.end();
+	--last;
+	test_assert(last->first == 199, "--end() on the copy reaches its last leaf");
+
+	m2.insert(25, "changed");
+	test_assert(m1.at(25) == "25", "Copy is independent");
+
+	btree_map<int, std::string, 64> m3;
+	m3 = m1;
+	test_assert(m3.size() == 200 && is_sorted_map(m3), "Copy assignment");
+
+	btree_map<int, std::string, 64> m4(std::move(m1));
+	test_assert(m4.size() == 200 && m1.empty(), "Move constructor steals the nodes");
+
+	m1.insert(1, "one");
+	test_assert(m1.size() == 1, "Moved-from btree is reusable");
+
+	m3 = std::move(m4);
+	test_assert(m3.size() == 200 && m4.empty() && m3.is_valid_btree(), "Move assignment");
+}
+
+void test_stress_random()
+{
+	section_header("TEST 8: RANDOM STRESS AGAINST RB-TREE");
+
+	const int KEYS = 5000;
+	small_btree btree;
+	STDev::map<int, int> reference;
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> key_dist(0, KEYS);
+
+	bool same = true;
+	bool valid = true;
+	for (int i = 0; i < 50000; i++)
+	{
+		int key = key_dist(rng);
+		if (rng() % 3 == 0)
+		{
+			if (btree.erase(key) != reference.erase(key))
+				same = false;
+		}
+		else
+		{
+			btree.insert(key, i);
+			reference.insert(key, i);
+		}
+
+		if (i % 5000 == 0 && !btree.is_valid_btree())
+			valid = false;
+	}
+
+	test_assert(same, "erase() reports presence like the RB-Tree");
+	test_assert(valid && btree.is_valid_btree(), "Btree valid throughout");
+	test_assert(btree.size() == reference.size(), "Size matches reference");
+
+	auto it = btree.begin();
+	for (const auto& pair : reference)
+	{
+		if (it == btree.end() || it->first != pair.first || it->second != pair.second)
+		{
+			same = false;
+			break;
+		}
+		++it;
+	}
+	test_assert(same && it == btree.end(), "Same ordered contents as reference");
+}
+
+// ==================== BENCHMARKS ====================
+
+// la richiesta originale arriva a 10^8 chiavi; qui ci si ferma a 10^6 per restare in pochi
+// secondi e poche centinaia di MB (l'RB-Tree usa ~48 byte per nodo). Alzare MAX_KEYS per le misure grandi.
+const int MAX_KEYS = 1000000;
+
+void benchmark_vs_rbtree()
+{
+	section_header("BENCHMARK 1: B+ TREE VS RB-TREE");
+
+	std::cout << "\nbtree_map<int, int>: " << btree_map<int, int>::INNER_SLOTS << " chiavi per nodo interno, "
+		<< btree_map<int, int>::LEAF_SLOTS << " per foglia" << std::endl;
+	std::cout << "\nKeys\t\tOperation\tRB-Tree(ms)\tB+Tree(ms)" << std::endl;
+	std::cout << "--------------------------------------------------------------" << std::endl;
+
+	for (int n = 100000; n <= MAX_KEYS; n *= 10)
+	{
+		std::vector<int> keys(n);
+		for (int i = 0; i < n; i++)
+			keys[i] = i;
+		std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+		STDev::map<int, int> tree;
+		btree_map<int, int> btree;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int k : keys)
+			tree.insert(k, k);
+		auto end = std::chrono::high_resolution_clock::now();
+		auto tree_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int k : keys)
+			btree.insert(k, k);
+		end = std::chrono::high_resolution_clock::now();
+		auto btree_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		std::cout << n << "\t\tInsert\t\t" << tree_insert << "\t\t" << btree_insert << std::endl;
+
+		// lookup in ordine casuale diverso da quello di inserimento
+		std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+		size_t found = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int k : keys)
+			found += tree.contains(k);
+		end = std::chrono::high_resolution_clock::now();
+		auto tree_find = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int k : keys)
+			found += btree.contains(k);
+		end = std::chrono::high_resolution_clock::now();
+		auto btree_find = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		std::cout << n << "\t\tFind\t\t" << tree_find << "\t\t" << btree_find << std::endl;
+
+		// 1000 range scan da 1000 chiavi ciascuno
+		long long sum = 0;
+		std::mt19937 rng(3);
+		std::vector<int> starts(1000);
+		for (int& s : starts)
+			s = static_cast<int>(rng() % (n - 1000));
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int s : starts)
+			tree.for_each_in_range(s, s + 1000, [&sum](const std::pair<const int, int>& pair)
+				{
+					sum += pair.second;
+				});
+		end = std::chrono::high_resolution_clock::now();
+		auto tree_scan = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int s : starts)
+			btree.for_each_in_range(s, s + 1000, [&sum](const std::pair<const int&, const int&>& pair)
+				{
+					sum += pair.second;
+				});
+		end = std::chrono::high_resolution_clock::now();
+		auto btree_scan = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		std::cout << n << "\t\tRange scan\t" << tree_scan << "\t\t" << btree_scan << std::endl;
+
+		long long full = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (const auto& pair : tree)
+			full += pair.second;
+		end = std::chrono::high_resolution_clock::now();
+		auto tree_full = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		for (auto it = btree.begin(); it != btree.end(); ++it)
+			full += it.value();
+		end = std::chrono::high_resolution_clock::now();
+		auto btree_full = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		std::cout << n << "\t\tFull scan\t" << tree_full << "\t\t" << btree_full << std::endl;
+		std::cout << "(checksum " << found << " / " << sum << " / " << full
+			<< ", altezza RB " << tree.height() << " vs B+ " << btree.height() << ")" << std::endl;
+	}
+
+	std::cout << "\nNote: un livello del B+ tree e' un solo nodo contiguo (4 cache line)," << std::endl;
+	std::cout << "      l'RB-Tree fa un cache miss per ogni nodo lungo ~2*log2(n) livelli." << std::endl;
+}
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	btree_map<int, std::string, 64> m;
+	for (int i = 1; i <= 30; i++)
+		m.insert(i * 10, std::to_string(i));
+
+	m.print_tree();
+
+	std::cout << "Erase 100..200:" << std::endl;
+	for (int i = 100; i <= 200; i += 10)
+		m.erase(i);
+	m.print_tree();
+}
+
+// ==================== MAIN ====================
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   BTREE_MAP TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_insert_variants();
+	test_splits();
+	test_erase();
+	test_iterators();
+	test_range_scan();
+	test_copy_and_move();
+	test_stress_random();
+
+	g_stats.print_summary();
+
+	benchmark_vs_rbtree();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	return 0;
+}
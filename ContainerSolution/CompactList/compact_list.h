@@ -0,0 +1,655 @@
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace STDev
+{
+	// Array di nodi condiviso da piu' compact_list: i link sono indici a 32 bit
+	// dentro il pool invece di puntatori a 64 bit. I nodi stanno in blocchi che
+	// non vengono mai spostati (come la map di deque), cosi' crescere non sposta mai
+	// un valore gia' costruito e i riferimenti agli elementi restano validi.
+	// I primi blocchi raddoppiano (8, 8, 16, ... 512 slot) e poi sono tutti da 1024:
+	// una lista piccola con pool privato occupa poche decine di byte, non 12 KB.
+	// Non e' thread-safe: le liste di uno stesso pool vanno usate da un thread alla volta.
+	template<typename T>
+	class compact_pool
+	{
+	public:
+		typedef uint32_t index_type;
+
+		static const index_type NIL = UINT32_MAX; // fine della free-list
+
+	private:
+		static const index_type FIRST_BLOCK_SHIFT = 3;
+		static const index_type FIRST_BLOCK_SIZE = index_type(1) << FIRST_BLOCK_SHIFT;
+		static const index_type BLOCK_SHIFT = 10;
+		static const index_type BLOCK_SIZE = index_type(1) << BLOCK_SHIFT;
+		// blocchi che coprono gli indici [0, BLOCK_SIZE): 8, 8, 16, ... 512
+		static const index_type SMALL_BLOCKS = BLOCK_SHIFT - FIRST_BLOCK_SHIFT + 1;
+
+		// int: 12 byte contro i 24 di Node<int> di list
+		struct Slot
+		{
+			index_type next;     // successore, o prossimo slot libero
+			index_type previous; // predecessore
+			alignas(T) unsigned char storage[sizeof(T)]; // costruito solo per i nodi con valore
+		};
+
+		std::vector<std::unique_ptr<Slot[]>> blocks;
+		index_type _capacity;
+		index_type free_head;
+		size_t _in_use;
+
+		// posizione del bit 1 piu' significativo, index != 0
+		static unsigned highest_bit(index_type index)
+		{
+#if defined(_MSC_VER)
+			unsigned long position;
+			_BitScanReverse(&position, index);
+			return static_cast<unsigned>(position);
+#else
+			return 31u - static_cast<unsigned>(__builtin_clz(index));
+#endif
+		}
+
+		void grow()
+		{
+			// il nuovo blocco raddoppia la capacita' fino a BLOCK_SIZE, poi resta BLOCK_SIZE
+			index_type block_size = _capacity < FIRST_BLOCK_SIZE ? FIRST_BLOCK_SIZE
+				: _capacity < BLOCK_SIZE ? _capacity : BLOCK_SIZE;
+
+			if (_capacity > NIL - block_size)
+			{
+				throw std::length_error("compact_pool: indici a 32 bit esauriti");
+			}
+
+			blocks.emplace_back(new Slot[block_size]);
+
+			// i nuovi slot vanno in free-list in ordine crescente: liste riempite di
+			// seguito finiscono contigue in memoria
+			for (index_type i = 0; i < block_size - 1; ++i)
+			{
+				blocks.back()[i].next = _capacity + i + 1;
+			}
+			blocks.back()[block_size - 1].next = free_head;
+			free_head = _capacity;
+			_capacity += block_size;
+		}
+
+		// sotto BLOCK_SIZE il blocco b >= 1 copre [2^(b+2), 2^(b+3)), sopra sono tutti da BLOCK_SIZE
+		Slot* locate(index_type index) const
+		{
+			if (index >= BLOCK_SIZE)
+			{
+				return &blocks[SMALL_BLOCKS - 1 + (index >> BLOCK_SHIFT)][index & (BLOCK_SIZE - 1)];
+			}
+			if (index < FIRST_BLOCK_SIZE)
+			{
+				return &blocks[0][index];
+			}
+			unsigned high = highest_bit(index);
+			return &blocks[high - FIRST_BLOCK_SHIFT + 1][index - (index_type(1) << high)];
+		}
+
+		Slot& slot(index_type index)
+		{
+			return *locate(index);
+		}
+
+		const Slot& slot(index_type index) const
+		{
+			return *locate(index);
+		}
+
+	public:
+		compact_pool() : _capacity(0), free_head(NIL), _in_use(0)
+		{}
+
+		compact_pool(const compact_pool&) = delete;
+		compact_pool& operator=(const compact_pool&) = delete;
+
+		T& value(index_type index)
+		{
+			return *std::launder(reinterpret_cast<T*>(slot(index).storage));
+		}
+
+		const T& value(index_type index) const
+		{
+			return *std::launder(reinterpret_cast<const T*>(slot(index).storage));
+		}
+
+		index_type& next(index_type index)
+		{
+			return slot(index).next;
+		}
+
+		index_type& previous(index_type index)
+		{
+			return slot(index).previous;
+		}
+
+		index_type next(index_type index) const
+		{
+			return slot(index).next;
+		}
+
+		index_type previous(index_type index) const
+		{
+			return slot(index).previous;
+		}
+
+		// slot senza valore (sentinel)
+		index_type allocate()
+		{
+			if (free_head == NIL)
+			{
+				grow();
+			}
+
+			index_type index = free_head;
+			free_head = slot(index).next;
+			++_in_use;
+			return index;
+		}
+
+		index_type allocate(const T& val)
+		{
+			index_type index = allocate();
+			try
+			{
+				new (slot(index).storage) T(val);
+			}
+			catch (...)
+			{
+				deallocate(index);
+				throw;
+			}
+			return index;
+		}
+
+		void deallocate(index_type index) noexcept
+		{
+			slot(index).next = free_head;
+			free_head = index;
+			--_in_use;
+		}
+
+		void destroy(index_type index) noexcept
+		{
+			value(index).~T();
+			deallocate(index);
+		}
+
+		size_t capacity() const
+		{
+			return _capacity;
+		}
+
+		size_t in_use() const
+		{
+			return _in_use;
+		}
+
+		// byte occupati dagli slot (escluso il vettore dei blocchi)
+		size_t memory_bytes() const
+		{
+			return static_cast<size_t>(_capacity) * sizeof(Slot);
+		}
+
+		static constexpr size_t slot_size()
+		{
+			return sizeof(Slot);
+		}
+	};
+
+	// Lista doppiamente collegata circolare con sentinel, come list, ma i nodi
+	// vivono in un compact_pool e si collegano con indici a 32 bit.
+	// Piu' liste possono condividere lo stesso pool: splice tra di loro e' O(1).
+	// Una lista spostata resta senza sentinel (NIL) e lo crea al primo uso.
+	template<typename T>
+	class compact_list
+	{
+	public:
+		typedef compact_pool<T> pool_type;
+		typedef typename pool_type::index_type index_type;
+
+		class iterator;
+
+	private:
+		std::shared_ptr<pool_type> pool;
+		index_type sentinel;
+		size_t _size;
+
+		void link_before(index_type pos, index_type node)
+		{
+			pool_type& p = *pool;
+			index_type before = p.previous(pos);
+
+			p.previous(node) = before;
+			p.next(node) = pos;
+
+			p.next(before) = node;
+			p.previous(pos) = node;
+		}
+
+		void unlink(index_type node)
+		{
+			pool_type& p = *pool;
+			p.next(p.previous(node)) = p.next(node);
+			p.previous(p.next(node)) = p.previous(node);
+		}
+
+		index_type make_sentinel()
+		{
+			index_type index = pool->allocate();
+			pool->next(index) = index;
+			pool->previous(index) = index;
+			return index;
+		}
+
+		// sentinel, creato se la lista e' stata spostata
+		index_type head()
+		{
+			if (sentinel == pool_type::NIL)
+			{
+				sentinel = make_sentinel();
+			}
+			return sentinel;
+		}
+
+		// un iteratore NIL e' l'end() const di una lista ancora senza sentinel
+		index_type position(const iterator& pos)
+		{
+			return pos.current == pool_type::NIL ? head() : pos.current;
+		}
+
+		void check_same_pool(const compact_list& other) const
+		{
+			if (pool != other.pool)
+			{
+				throw std::invalid_argument("splice: compact_list di pool diversi");
+			}
+		}
+
+	public:
+		compact_list() : pool(std::make_shared<pool_type>()), _size(0)
+		{
+			sentinel = make_sentinel();
+		}
+
+		// la lista usa il pool indicato (condiviso con altre liste per lo splice)
+		explicit compact_list(std::shared_ptr<pool_type> shared_pool) : pool(std::move(shared_pool)), _size(0)
+		{
+			sentinel = make_sentinel();
+		}
+
+		~compact_list()
+		{
+			clear();
+			if (sentinel != pool_type::NIL)
+			{
+				pool->deallocate(sentinel);
+			}
+		}
+
+		// Copy constructor: la copia sta nello stesso pool dell'originale
+		compact_list(const compact_list& other) : pool(other.pool), _size(0)
+		{
+			sentinel = make_sentinel();
+			for (const T& value : other)
+			{
+				push_back(value);
+			}
+		}
+
+		// Copy assignment: gli elementi vengono copiati nel pool di questa lista
+		compact_list& operator=(const compact_list& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				for (const T& value : other)
+				{
+					push_back(value);
+				}
+			}
+			return *this;
+		}
+
+		// Move constructor: prende pool e sentinel, other resta nel suo pool senza sentinel
+		compact_list(compact_list&& other) noexcept
+			: pool(other.pool), sentinel(other.sentinel), _size(other._size)
+		{
+			other.sentinel = pool_type::NIL;
+			other._size = 0;
+		}
+
+		// Move assignment
+		compact_list& operator=(compact_list&& other) noexcept
+		{
+			if (this != &other)
+			{
+				clear();
+				if (sentinel != pool_type::NIL)
+				{
+					pool->deallocate(sentinel);
+				}
+
+				pool = other.pool;
+				sentinel = other.sentinel;
+				_size = other._size;
+
+				other.sentinel = pool_type::NIL;
+				other._size = 0;
+			}
+			return *this;
+		}
+
+		void push_front(const T& value)
+		{
+			index_type first = pool->next(head());
+			index_type newNode = pool->allocate(value);
+			link_before(first, newNode);
+			++_size;
+		}
+
+		void push_back(const T& value)
+		{
+			index_type last = head();
+			index_type newNode = pool->allocate(value);
+			link_before(last, newNode);
+			++_size;
+		}
+
+		void pop_front()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("pop_front on empty compact_list");
+			}
+
+			index_type toDelete = pool->next(sentinel);
+			unlink(toDelete);
+			pool->destroy(toDelete);
+			--_size;
+		}
+
+		void pop_back()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("pop_back on empty compact_list");
+			}
+
+			index_type toDelete = pool->previous(sentinel);
+			unlink(toDelete);
+			pool->destroy(toDelete);
+			--_size;
+		}
+
+		iterator insert(iterator pos, const T& value)
+		{
+			index_type posNode = position(pos);
+			index_type newNode = pool->allocate(value);
+			link_before(posNode, newNode);
+			++_size;
+
+			return iterator(pool.get(), newNode);
+		}
+
+		iterator erase(iterator pos)
+		{
+			if (pos.current == sentinel)
+			{
+				throw std::out_of_range("Cannot erase sentinel");
+			}
+
+			index_type toDelete = pos.current;
+			index_type nextNode = pool->next(toDelete);
+
+			unlink(toDelete);
+			pool->destroy(toDelete);
+			--_size;
+
+			return iterator(pool.get(), nextNode);
+		}
+
+		// sposta tutti gli elementi di other prima di pos, O(1); other deve usare lo stesso pool
+		void splice(iterator pos, compact_list& other)
+		{
+			if (other.empty() || this == &other)
+			{
+				return;
+			}
+			check_same_pool(other);
+
+			index_type posNode = position(pos);
+			pool_type& p = *pool;
+			index_type otherFirst = p.next(other.sentinel);
+			index_type otherLast = p.previous(other.sentinel);
+
+			p.next(other.sentinel) = other.sentinel;
+			p.previous(other.sentinel) = other.sentinel;
+
+			p.previous(otherFirst) = p.previous(posNode);
+			p.next(otherLast) = posNode;
+
+			p.next(p.previous(posNode)) = otherFirst;
+			p.previous(posNode) = otherLast;
+
+			_size += other._size;
+			other._size = 0;
+		}
+
+		// sposta il solo nodo "it" (di other, anche other == *this) prima di pos, O(1)
+		void splice(iterator pos, compact_list& other, iterator it)
+		{
+			check_same_pool(other);
+
+			index_type posNode = position(pos);
+			index_type moved = it.current;
+
+			if (moved == posNode || pool->next(moved) == posNode)
+			{
+				return;
+			}
+
+			unlink(moved);
+			link_before(posNode, moved);
+
+			if (this != &other)
+			{
+				++_size;
+				--other._size;
+			}
+		}
+
+		T& front()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("front on empty compact_list");
+			}
+			return pool->value(pool->next(sentinel));
+		}
+
+		const T& front() const
+		{
+			if (empty())
+			{
+				throw std::out_of_range("front on empty compact_list");
+			}
+			return pool->value(pool->next(sentinel));
+		}
+
+		T& back()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("back on empty compact_list");
+			}
+			return pool->value(pool->previous(sentinel));
+		}
+
+		const T& back() const
+		{
+			if (empty())
+			{
+				throw std::out_of_range("back on empty compact_list");
+			}
+			return pool->value(pool->previous(sentinel));
+		}
+
+		void clear() noexcept
+		{
+			if (sentinel == pool_type::NIL)
+			{
+				return;
+			}
+
+			index_type current = pool->next(sentinel);
+			while (current != sentinel)
+			{
+				index_type toDelete = current;
+				current = pool->next(current);
+				pool->destroy(toDelete);
+			}
+
+			pool->next(sentinel) = sentinel;
+			pool->previous(sentinel) = sentinel;
+			_size = 0;
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		bool empty() const
+		{
+			return _size == 0;
+		}
+
+		const std::shared_ptr<pool_type>& get_pool() const
+		{
+			return pool;
+		}
+
+		void print_visual() const
+		{
+			std::cout << "\n=== COMPACT LIST ===" << std::endl;
+			std::cout << "Size: " << _size << "  Slot: " << pool_type::slot_size() << " bytes\n" << std::endl;
+
+			if (sentinel == pool_type::NIL)
+			{
+				std::cout << "[Sentinel non ancora creato]" << std::endl;
+				std::cout << "====================\n" << std::endl;
+				return;
+			}
+
+			std::cout << "[Sentinel #" << sentinel << "]";
+			for (index_type current = pool->next(sentinel); current != sentinel; current = pool->next(current))
+			{
+				std::cout << " <-> [" << pool->value(current) << " #" << current << "]";
+			}
+			std::cout << " <-> [Sentinel] (circular)" << std::endl;
+			std::cout << "====================\n" << std::endl;
+		}
+
+		iterator begin()
+		{
+			return iterator(pool.get(), pool->next(head()));
+		}
+
+		iterator end()
+		{
+			return iterator(pool.get(), head());
+		}
+
+		// senza sentinel begin() == end() == NIL, nessuna allocazione
+		const iterator begin() const
+		{
+			if (sentinel == pool_type::NIL)
+			{
+				return end();
+			}
+			return iterator(pool.get(), pool->next(sentinel));
+		}
+
+		const iterator end() const
+		{
+			return iterator(pool.get(), sentinel);
+		}
+
+	public:
+		class iterator // bidirectional iterator
+		{
+			friend class compact_list;
+			pool_type* owner;
+			index_type current;
+
+		public:
+			iterator(pool_type* p, index_type index) : owner(p), current(index)
+			{}
+
+			iterator() : owner{ nullptr }, current{ pool_type::NIL }
+			{}
+
+			iterator& operator++() // ++it
+			{
+				current = owner->next(current);
+				return *this;
+			}
+
+			iterator operator++(int) // it++
+			{
+				iterator temp = *this;
+				current = owner->next(current);
+				return temp;
+			}
+
+			iterator& operator--() // --it
+			{
+				current = owner->previous(current);
+				return *this;
+			}
+
+			iterator operator--(int) // it--
+			{
+				iterator temp = *this;
+				current = owner->previous(current);
+				return temp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return current == other.current && owner == other.owner;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return !(*this == other);
+			}
+
+			T& operator*() const
+			{
+				return owner->value(current);
+			}
+
+			T* operator->() const
+			{
+				return &owner->value(current);
+			}
+		};
+	};
+}
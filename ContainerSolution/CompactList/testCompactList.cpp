@@ -0,0 +1,526 @@
+#include "compact_list.h"
+#include "list.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace STDev;
+
+// ============ TEST PUSH / POP ============
+
+void test_push_and_pop()
+{
+	std::cout << "Test: push/pop front e back... ";
+	compact_list<int> l;
+
+	l.push_back(2);
+	l.push_back(3);
+	l.push_front(1);
+
+	assert(l.size() == 3);
+	assert(l.front() == 1);
+	assert(l.back() == 3);
+
+	l.pop_front();
+	assert(l.front() == 2);
+
+	l.pop_back();
+	assert(l.back() == 2);
+	assert(l.size() == 1);
+
+	l.pop_back();
+	assert(l.empty());
+
+	bool thrown = false;
+	try
+	{
+		l.pop_front();
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST INSERT / ERASE ============
+
+void test_insert_and_erase()
+{
+	std::cout << "Test: insert ed erase... ";
+	compact_list<int> l;
+
+	l.push_back(1);
+	l.push_back(2);
+	l.push_back(4);
+
+	auto it = l.begin();
+	++it;
+	++it;
+	auto inserted = l.insert(it, 3);
+	assert(*inserted == 3);
+	assert(l.size() == 4);
+
+	auto next = l.erase(l.begin());
+	assert(*next == 2);
+	assert(l.size() == 3);
+
+	auto verify = l.begin();
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+	assert(*verify++ == 4);
+	assert(verify == l.end());
+
+	bool thrown = false;
+	try
+	{
+		l.erase(l.end());
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST ITERATORS ============
+
+void test_bidirectional_iterators()
+{
+	std::cout << "Test: iteratori bidirezionali... ";
+	compact_list<int> l;
+
+	for (int i = 1; i <= 5; i++)
+	{
+		l.push_back(i);
+	}
+
+	auto it = l.end();
+	int expected = 5;
+	while (it != l.begin())
+	{
+		--it;
+		assert(*it == expected--);
+	}
+
+	for (int& v : l)
+	{
+		v *= 10;
+	}
+	assert(l.front() == 10);
+	assert(l.back() == 50);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST SPLICE ============
+
+void test_splice_shared_pool()
+{
+	std::cout << "Test: splice tra liste dello stesso pool... ";
+	auto pool = std::make_shared<compact_pool<int>>();
+	compact_list<int> l1(pool);
+	compact_list<int> l2(pool);
+
+	l1.push_back(1);
+	l1.push_back(4);
+
+	l2.push_back(2);
+	l2.push_back(3);
+
+	auto pos = l1.begin();
+	++pos;
+	l1.splice(pos, l2);
+
+	assert(l1.size() == 4);
+	assert(l2.empty());
+
+	auto verify = l1.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+	assert(*verify++ == 4);
+
+	// nessuna copia: gli slot in uso sono i 4 nodi + i 2 sentinel
+	assert(pool->in_use() == 6);
+
+	// singolo nodo: il 4 torna in l2
+	auto last = l1.end();
+	--last;
+	l2.splice(l2.end(), l1, last);
+	assert(l1.size() == 3);
+	assert(l2.size() == 1);
+	assert(l2.front() == 4);
+
+	// singolo nodo nella stessa lista: il 3 in testa
+	auto three = l1.begin();
+	++three;
+	++three;
+	l1.splice(l1.begin(), l1, three);
+	verify = l1.begin();
+	assert(*verify++ == 3);
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+
+	std::cout << "OK\n";
+}
+
+void test_splice_different_pools()
+{
+	std::cout << "Test: splice tra pool diversi... ";
+	compact_list<int> l1;
+	compact_list<int> l2;
+
+	l2.push_back(1);
+
+	bool thrown = false;
+	try
+	{
+		l1.splice(l1.begin(), l2);
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+	assert(l2.size() == 1);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST COPY/MOVE ============
+
+void test_copy_and_move()
+{
+	std::cout << "Test: copy e move... ";
+	compact_list<std::string> l1;
+	l1.push_back("a");
+	l1.push_back("b");
+	l1.push_back("c");
+
+	compact_list<std::string> l2(l1);
+	assert(l2.size() == 3);
+	assert(l2.get_pool() == l1.get_pool());
+
+	l2.pop_front();
+	assert(l1.size() == 3);
+
+	// il move non alloca: other resta senza sentinel finche' non viene usato
+	static_assert(std::is_nothrow_move_constructible<compact_list<std::string>>::value, "move ctor noexcept");
+	static_assert(std::is_nothrow_move_assignable<compact_list<std::string>>::value, "move assignment noexcept");
+	size_t in_use = l1.get_pool()->in_use();
+	compact_list<std::string> l3(std::move(l1));
+	assert(l3.size() == 3);
+	assert(l1.empty());
+	assert(l1.get_pool()->in_use() == in_use);
+
+	const compact_list<std::string>& moved = l1;
+	assert(moved.begin() == moved.end());
+
+	l1.push_back("x");
+	assert(l1.size() == 1);
+	assert(l1.get_pool()->in_use() == in_use + 2);
+
+	compact_list<std::string> l5(std::move(l1));
+	l1.insert(moved.end(), "y");
+	l1.push_front("w");
+	assert(l1.front() == "w" && l1.back() == "y");
+	l5.splice(l5.end(), l1);
+	assert(l5.size() == 3 && l5.front() == "x" && l5.back() == "y");
+
+	compact_list<std::string> l4;
+	l4 = l3;
+	assert(l4.size() == 3);
+	assert(l4.get_pool() != l3.get_pool());
+
+	l4 = std::move(l2);
+	assert(l4.size() == 2);
+	assert(l2.empty());
+
+	compact_list<std::string> l6;
+	l6 = std::move(l2);
+	assert(l6.empty() && l2.empty());
+	l2 = l6;
+	assert(l2.empty());
+
+	auto verify = l4.begin();
+	assert(*verify++ == "b");
+	assert(*verify++ == "c");
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST POOL ============
+
+void test_pool_reuse()
+{
+	std::cout << "Test: riuso degli slot liberati... ";
+	compact_list<int> l;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		l.push_back(i);
+	}
+	size_t capacity = l.get_pool()->capacity();
+
+	for (int round = 0; round < 10; round++)
+	{
+		l.clear();
+		for (int i = 0; i < 1000; i++)
+		{
+			l.push_back(i);
+		}
+	}
+
+	assert(l.get_pool()->capacity() == capacity);
+	assert(l.get_pool()->in_use() == 1001);
+
+	std::cout << "OK\n";
+}
+
+void test_reference_stability()
+{
+	std::cout << "Test: riferimenti stabili quando il pool cresce... ";
+	compact_list<int> l;
+
+	l.push_back(42);
+	int* first = &l.front();
+
+	for (int i = 0; i < 10000; i++)
+	{
+		l.push_back(i);
+	}
+
+	// il pool cresce a blocchi: il primo valore non si e' mosso
+	assert(&l.front() == first);
+	assert(*first == 42);
+
+	std::cout << "OK\n";
+}
+
+void test_many_small_lists()
+{
+	std::cout << "Test: memoria di molte liste piccole con pool privato... ";
+	const int LISTS = 10000;
+	std::vector<compact_list<int>> lists(LISTS);
+
+	for (int i = 0; i < LISTS; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			lists[i].push_back(j);
+		}
+	}
+
+	size_t slot_bytes = 0;
+	for (const compact_list<int>& l : lists)
+	{
+		slot_bytes += l.get_pool()->memory_bytes();
+	}
+
+	// sentinel + 3 valori stanno nel primo blocco da 8 slot
+	assert(lists[0].get_pool()->capacity() == 8);
+	assert(slot_bytes == static_cast<size_t>(LISTS) * 8 * compact_pool<int>::slot_size());
+
+	// la crescita raddoppia fino a 1024 slot, poi un blocco da 1024 alla volta
+	compact_list<int> big;
+	size_t expected = 8;
+	for (int i = 1; i < 3000; i++)
+	{
+		big.push_back(i);
+		if (big.get_pool()->in_use() > expected)
+		{
+			expected = expected < 1024 ? expected * 2 : expected + 1024;
+		}
+		assert(big.get_pool()->capacity() == expected);
+	}
+
+	std::cout << "OK (" << LISTS << " liste da 3 int: " << slot_bytes / 1024 << " KB di slot)\n";
+}
+
+struct NoDefault
+{
+	int value;
+
+	explicit NoDefault(int v) : value(v)
+	{}
+};
+
+void test_no_default_constructor()
+{
+	std::cout << "Test: T senza costruttore di default... ";
+	compact_list<NoDefault> l;
+
+	l.push_back(NoDefault(1));
+	l.push_back(NoDefault(2));
+
+	assert(l.front().value == 1);
+	assert(l.back().value == 2);
+
+	std::cout << "OK\n";
+}
+
+// ============ BENCHMARK ============
+
+void benchmark_vs_list()
+{
+	std::cout << "\n=== BENCHMARK: compact_list vs list ===" << std::endl;
+
+	const int N = 1000000;
+	std::cout << "sizeof(list Node<int>):    " << sizeof(Node<int>) << " bytes" << std::endl;
+	std::cout << "compact_list slot<int>:    " << compact_pool<int>::slot_size() << " bytes" << std::endl;
+
+	compact_list<int> compact;
+	size_t compact_bytes = 0;
+	size_t list_bytes = static_cast<size_t>(N + 1) * sizeof(Node<int>);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	{
+		list<int> l;
+		for (int i = 0; i < N; i++)
+		{
+			l.push_back(i);
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto list_push_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < N; i++)
+	{
+		compact.push_back(i);
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto compact_push_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+	compact_bytes = compact.get_pool()->memory_bytes();
+
+	// scorrimento dopo un rimescolamento: nodi sparsi in memoria per entrambe
+	list<int> shuffled_list;
+	compact_list<int> shuffled_compact;
+	std::vector<int> order(N);
+	for (int i = 0; i < N; i++)
+	{
+		order[i] = i;
+	}
+	std::shuffle(order.begin(), order.end(), std::mt19937(42));
+	for (int i = 0; i < N; i++)
+	{
+		shuffled_list.push_back(i);
+		shuffled_compact.push_back(i);
+	}
+	{
+		// sposta ogni nodo in una posizione casuale con splice: i link non seguono piu' la memoria
+		std::vector<list<int>::iterator> list_nodes;
+		std::vector<compact_list<int>::iterator> compact_nodes;
+		for (auto it = shuffled_list.begin(); it != shuffled_list.end(); ++it)
+		{
+			list_nodes.push_back(it);
+		}
+		for (auto it = shuffled_compact.begin(); it != shuffled_compact.end(); ++it)
+		{
+			compact_nodes.push_back(it);
+		}
+		for (int i = 0; i < N; i++)
+		{
+			shuffled_list.splice(shuffled_list.end(), shuffled_list, list_nodes[order[i]]);
+			shuffled_compact.splice(shuffled_compact.end(), shuffled_compact, compact_nodes[order[i]]);
+		}
+	}
+
+	long long sum = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int v : shuffled_list)
+	{
+		sum += v;
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto list_scan_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int v : shuffled_compact)
+	{
+		sum += v;
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto compact_scan_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " elementi int:" << std::endl;
+	std::cout << "  memoria nodi   list: " << list_bytes / (1024 * 1024) << " MB   compact_list: "
+		<< compact_bytes / (1024 * 1024) << " MB" << std::endl;
+	std::cout << "  push_back      list: " << list_push_ms << " ms   compact_list: " << compact_push_ms << " ms" << std::endl;
+	std::cout << "  scan (sparsa)  list: " << list_scan_ms << " ms   compact_list: " << compact_scan_ms << " ms" << std::endl;
+	std::cout << "  (checksum " << sum << ")" << std::endl;
+}
+
+// ============ TEST VISUAL DEMONSTRATION ============
+
+void test_visual_demonstration()
+{
+	std::cout << "\n=== DIMOSTRAZIONE VISIVA ===" << std::endl;
+
+	auto pool = std::make_shared<compact_pool<int>>();
+	compact_list<int> l1(pool);
+	compact_list<int> l2(pool);
+
+	l1.push_back(1);
+	l1.push_back(3);
+	l2.push_back(2);
+	l1.print_visual();
+	l2.print_visual();
+
+	std::cout << "Splice di l2 prima del 3..." << std::endl;
+	auto pos = l1.begin();
+	++pos;
+	l1.splice(pos, l2);
+	l1.print_visual();
+}
+
+// ============ MAIN ============
+
+int main()
+{
+	std::cout << "\n========================================\n";
+	std::cout << "TEST SUITE COMPACT_LIST\n";
+	std::cout << "========================================\n\n";
+
+	std::cout << "--- TEST PUSH/POP ---\n";
+	test_push_and_pop();
+
+	std::cout << "\n--- TEST INSERT/ERASE ---\n";
+	test_insert_and_erase();
+
+	std::cout << "\n--- TEST ITERATORS ---\n";
+	test_bidirectional_iterators();
+
+	std::cout << "\n--- TEST SPLICE ---\n";
+	test_splice_shared_pool();
+	test_splice_different_pools();
+
+	std::cout << "\n--- TEST COPY/MOVE ---\n";
+	test_copy_and_move();
+
+	std::cout << "\n--- TEST POOL ---\n";
+	test_pool_reuse();
+	test_reference_stability();
+	test_many_small_lists();
+	test_no_default_constructor();
+
+	std::cout << "\n========================================\n";
+	std::cout << "TUTTI I TEST SONO PASSATI!\n";
+	std::cout << "========================================\n";
+
+	benchmark_vs_list();
+	test_visual_demonstration();
+
+	return 0;
+}
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace STDev
+{
+	// Map ordinata su array contigui, per dati costruiti una volta e letti molte volte.
+	// Chiavi e valori stanno in due vector separati: la ricerca (binary search senza salti)
+	// tocca solo l'array delle chiavi, e ogni elemento costa sizeof(K) + sizeof(T) senza nodi.
+	//
+	// - find, lower_bound, operator[] su chiave esistente: O(log n)
+	// - insert / erase singoli: O(n) (spostano la coda degli array)
+	// - insert(first, last): accoda, ordina solo i nuovi e li fonde con gli esistenti in un
+	//   passaggio, O(n + m log m). E' il modo giusto di costruirla
+	// - gli iteratori sono invalidati da ogni modifica, come quelli di un vector
+	//
+	// Stessa interfaccia di map; come in btree_map *it restituisce std::pair<const K&, T&>
+	template<typename K, typename T, typename Compare = std::less<K>>
+	class flat_map
+	{
+	private:
+
+		std::vector<K> keys_;
+		std::vector<T> values_;
+		Compare comp;
+
+		// primo indice con keys_[i] >= key. La discesa ha lunghezza fissa e sceglie la meta'
+		// con un'addizione condizionale (cmov), senza salti da predire: la stessa di btree_map
+		template<typename KeyLike>
+		size_t lower_index(const KeyLike& key) const
+		{
+			if (keys_.empty())
+				return 0;
+
+			const K* base = keys_.data();
+			size_t length = keys_.size();
+			while (length > 1)
+			{
+				size_t half = length / 2;
+				base += comp(base[half - 1], key) ? half : 0;
+				length -= half;
+			}
+			return static_cast<size_t>(base - keys_.data()) + (comp(*base, key) ? 1 : 0);
+		}
+
+		// primo indice con keys_[i] > key
+		template<typename KeyLike>
+		size_t upper_index(const KeyLike& key) const
+		{
+			if (keys_.empty())
+				return 0;
+
+			const K* base = keys_.data();
+			size_t length = keys_.size();
+			while (length > 1)
+			{
+				size_t half = length / 2;
+				base += comp(key, base[half - 1]) ? 0 : half;
+				length -= half;
+			}
+			return static_cast<size_t>(base - keys_.data()) + (comp(key, *base) ? 0 : 1);
+		}
+
+		// indice della chiave, size() se manca
+		template<typename KeyLike>
+		size_t find_index(const KeyLike& key) const
+		{
+			size_t index = lower_index(key);
+			if (index < keys_.size() && !comp(key, keys_[index]))
+				return index;
+			return keys_.size();
+		}
+
+	public:
+
+		class iterator;
+		class const_iterator;
+
+		flat_map() : comp()
+		{}
+
+		explicit flat_map(const Compare& compare) : comp(compare)
+		{}
+
+		// una chiave esistente viene sovrascritta, come map::insert
+		void insert(const K& key, const T& value)
+		{
+			insert_or_assign(key, value);
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			size_t index = lower_index(key);
+			if (index < keys_.size() && !comp(key, keys_[index]))
+				return { iterator(this, index), false };
+
+			keys_.insert(keys_.begin() + index, key);
+			values_.emplace(values_.begin() + index, std::forward<Args>(args)...);
+			return { iterator(this, index), true };
+		}
+
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+		{
+			size_t index = lower_index(key);
+			if (index < keys_.size() && !comp(key, keys_[index]))
+			{
+				values_[index] = std::forward<M>(value);
+				return { iterator(this, index), false };
+			}
+
+			keys_.insert(keys_.begin() + index, key);
+			values_.insert(values_.begin() + index, std::forward<M>(value));
+			return { iterator(this, index), true };
+		}
+
+		// Inserimento in blocco con la semantica di insert(key, value): a parita' di chiave vince
+		// l'ultima coppia. Le coppie nuove vengono accodate, ordinate con un solo stable_sort
+		// su una permutazione di indici e fuse con la parte gia' ordinata: O(n + m log m)
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			size_t old_size = keys_.size();
+			for (; first != last; ++first)
+			{
+				keys_.push_back(first->first);
+				values_.push_back(first->second);
+			}
+
+			size_t added = keys_.size() - old_size;
+			if (added == 0)
+				return;
+
+			std::vector<size_t> order(added);
+			std::iota(order.begin(), order.end(), old_size);
+			std::stable_sort(order.begin(), order.end(),
+				[this](size_t a, size_t b) { return comp(keys_[a], keys_[b]); });
+
+			std::vector<K> merged_keys;
+			std::vector<T> merged_values;
+			merged_keys.reserve(keys_.size());
+			merged_values.reserve(values_.size());
+
+			size_t i = 0;
+			size_t j = 0;
+			while (i < old_size || j < added)
+			{
+				if (j == added || (i < old_size && comp(keys_[i], keys_[order[j]])))
+				{
+					merged_keys.push_back(std::move(keys_[i]));
+					merged_values.push_back(std::move(values_[i]));
+					i++;
+					continue;
+				}
+
+				// tra le coppie nuove con la stessa chiave resta l'ultima, che sostituisce la vecchia
+				size_t index = order[j++];
+				while (j < added && !comp(keys_[index], keys_[order[j]]))
+					index = order[j++];
+				if (i < old_size && !comp(keys_[index], keys_[i]))
+					i++;
+
+				merged_keys.push_back(std::move(keys_[index]));
+				merged_values.push_back(std::move(values_[index]));
+			}
+
+			keys_.swap(merged_keys);
+			values_.swap(merged_values);
+		}
+
+		T& operator[](const K& key)
+		{
+			return try_emplace(key).first.value();
+		}
+
+		T& at(const K& key)
+		{
+			size_t index = find_index(key);
+			if (index == keys_.size())
+				throw std::out_of_range("flat_map::at: key not found");
+			return values_[index];
+		}
+
+		const T& at(const K& key) const
+		{
+			size_t index = find_index(key);
+			if (index == keys_.size())
+				throw std::out_of_range("flat_map::at: key not found");
+			return values_[index];
+		}
+
+		iterator find(const K& key)
+		{
+			return iterator(this, find_index(key));
+		}
+
+		const_iterator find(const K& key) const
+		{
+			return const_iterator(this, find_index(key));
+		}
+
+		bool contains(const K& key) const
+		{
+			return find_index(key) != keys_.size();
+		}
+
+		// ricerca eterogenea, solo con Compare::is_transparent
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		iterator find(const KeyLike& key)
+		{
+			return iterator(this, find_index(key));
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const_iterator find(const KeyLike& key) const
+		{
+			return const_iterator(this, find_index(key));
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool contains(const KeyLike& key) const
+		{
+			return find_index(key) != keys_.size();
+		}
+
+		iterator lower_bound(const K& key)
+		{
+			return iterator(this, lower_index(key));
+		}
+
+		const_iterator lower_bound(const K& key) const
+		{
+			return const_iterator(this, lower_index(key));
+		}
+
+		iterator upper_bound(const K& key)
+		{
+			return iterator(this, upper_index(key));
+		}
+
+		const_iterator upper_bound(const K& key) const
+		{
+			return const_iterator(this, upper_index(key));
+		}
+
+		std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		// visita in ordine le coppie con lo <= chiave < hi: due ricerche e una scansione contigua.
+		// func riceve std::pair<const K&, const T&>, come in btree_map
+		template<typename Func>
+		void for_each_in_range(const K& lo, const K& hi, Func func) const
+		{
+			size_t end_index = lower_index(hi);
+			for (size_t i = lower_index(lo); i < end_index; i++)
+				func(std::pair<const K&, const T&>(keys_[i], values_[i]));
+		}
+
+		bool erase(const K& key)
+		{
+			size_t index = find_index(key);
+			if (index == keys_.size())
+				return false;
+
+			keys_.erase(keys_.begin() + index);
+			values_.erase(values_.begin() + index);
+			return true;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			keys_.erase(keys_.begin() + pos.index);
+			values_.erase(values_.begin() + pos.index);
+			return iterator(this, pos.index);
+		}
+
+		void clear()
+		{
+			keys_.clear();
+			values_.clear();
+		}
+
+		void reserve(size_t capacity)
+		{
+			keys_.reserve(capacity);
+			values_.reserve(capacity);
+		}
+
+		void shrink_to_fit()
+		{
+			keys_.shrink_to_fit();
+			values_.shrink_to_fit();
+		}
+
+		// array ordinato delle chiavi e valori corrispondenti (stesso indice)
+		const std::vector<K>& keys() const
+		{
+			return keys_;
+		}
+
+		const std::vector<T>& values() const
+		{
+			return values_;
+		}
+
+		size_t size() const
+		{
+			return keys_.size();
+		}
+
+		bool empty() const
+		{
+			return keys_.empty();
+		}
+
+		Compare key_comp() const
+		{
+			return comp;
+		}
+
+		// iteratori ad accesso casuale: la map di appartenenza e un indice nei due array
+		class iterator
+		{
+		private:
+			flat_map* owner;
+			size_t index;
+
+			struct arrow_proxy
+			{
+				std::pair<const K&, T&> pair;
+				std::pair<const K&, T&>* operator->() { return &pair; }
+			};
+
+		public:
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef std::pair<const K, T> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef arrow_proxy pointer;
+			typedef std::pair<const K&, T&> reference;
+
+			iterator(const flat_map* map = nullptr, size_t i = 0) : owner(const_cast<flat_map*>(map)), index(i)
+			{}
+
+			const K& key() const { return owner->keys_[index]; }
+			T& value() const { return owner->values_[index]; }
+
+			std::pair<const K&, T&> operator*() const
+			{
+				return { owner->keys_[index], owner->values_[index] };
+			}
+
+			arrow_proxy operator->() const
+			{
+				return arrow_proxy{ { owner->keys_[index], owner->values_[index] } };
+			}
+
+			iterator& operator++() { ++index; return *this; }
+			iterator operator++(int) { iterator temp = *this; ++index; return temp; }
+			iterator& operator--() { --index; return *this; }
+			iterator operator--(int) { iterator temp = *this; --index; return temp; }
+
+			iterator& operator+=(difference_type n) { index += n; return *this; }
+			iterator& operator-=(difference_type n) { index -= n; return *this; }
+			iterator operator+(difference_type n) const { return iterator(owner, index + n); }
+			iterator operator-(difference_type n) const { return iterator(owner, index - n); }
+			difference_type operator-(const iterator& other) const { return static_cast<difference_type>(index) - static_cast<difference_type>(other.index); }
+
+			bool operator==(const iterator& other) const { return index == other.index; }
+			bool operator!=(const iterator& other) const { return index != other.index; }
+			bool operator<(const iterator& other) const { return index < other.index; }
+
+			friend class flat_map;
+			friend class const_iterator;
+		};//end iterator class
+
+		class const_iterator
+		{
+		private:
+			const flat_map* owner;
+			size_t index;
+
+			struct arrow_proxy
+			{
+				std::pair<const K&, const T&> pair;
+				const std::pair<const K&, const T&>* operator->() const { return &pair; }
+			};
+
+		public:
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef std::pair<const K, T> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef arrow_proxy pointer;
+			typedef std::pair<const K&, const T&> reference;
+
+			const_iterator(const flat_map* map = nullptr, size_t i = 0) : owner(map), index(i)
+			{}
+
+			const_iterator(const iterator& it) : owner(it.owner), index(it.index)
+			{}
+
+			const K& key() const { return owner->keys_[index]; }
+			const T& value() const { return owner->values_[index]; }
+
+			std::pair<const K&, const T&> operator*() const
+			{
+				return { owner->keys_[index], owner->values_[index] };
+			}
+
+			arrow_proxy operator->() const
+			{
+				return arrow_proxy{ { owner->keys_[index], owner->values_[index] } };
+			}
+
+			const_iterator& operator++() { ++index; return *this; }
+			const_iterator operator++(int) { const_iterator temp = *this; ++index; return temp; }
+			const_iterator& operator--() { --index; return *this; }
+			const_iterator operator--(int) { const_iterator temp = *this; --index; return temp; }
+
+			const_iterator& operator+=(difference_type n) { index += n; return *this; }
+			const_iterator& operator-=(difference_type n) { index -= n; return *this; }
+			const_iterator operator+(difference_type n) const { return const_iterator(owner, index + n); }
+			const_iterator operator-(difference_type n) const { return const_iterator(owner, index - n); }
+			difference_type operator-(const const_iterator& other) const { return static_cast<difference_type>(index) - static_cast<difference_type>(other.index); }
+
+			bool operator==(const const_iterator& other) const { return index == other.index; }
+			bool operator!=(const const_iterator& other) const { return index != other.index; }
+			bool operator<(const const_iterator& other) const { return index < other.index; }
+
+			friend class flat_map;
+		};//end const_iterator class
+
+		iterator begin() { return iterator(this, 0); }
+		iterator end() { return iterator(this, keys_.size()); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, keys_.size()); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+	};
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace STDev
+{
+	// Set ordinato su un array contiguo: la controparte di flat_map per set.
+	// Stessa interfaccia di set (insert/erase/find ritornano bool); gli iteratori sono quelli
+	// del vector sottostante (accesso casuale, invalidati da ogni modifica).
+	// Come flat_map va costruito con insert(first, last): un sort dei nuovi elementi,
+	// dedup e un merge con quelli gia' presenti, O(n + m log m)
+	template<typename K, typename Compare = std::less<K>>
+	class flat_set
+	{
+	private:
+
+		std::vector<K> keys_;
+		Compare comp;
+
+		// primo indice con keys_[i] >= key, binary search senza salti come in flat_map
+		template<typename KeyLike>
+		size_t lower_index(const KeyLike& key) const
+		{
+			if (keys_.empty())
+				return 0;
+
+			const K* base = keys_.data();
+			size_t length = keys_.size();
+			while (length > 1)
+			{
+				size_t half = length / 2;
+				base += comp(base[half - 1], key) ? half : 0;
+				length -= half;
+			}
+			return static_cast<size_t>(base - keys_.data()) + (comp(*base, key) ? 1 : 0);
+		}
+
+		template<typename KeyLike>
+		bool contains_key(const KeyLike& key) const
+		{
+			size_t index = lower_index(key);
+			return index < keys_.size() && !comp(key, keys_[index]);
+		}
+
+		bool equivalent(const K& a, const K& b) const
+		{
+			return !comp(a, b) && !comp(b, a);
+		}
+
+	public:
+
+		typedef typename std::vector<K>::const_iterator iterator;
+		typedef iterator const_iterator;
+
+		flat_set() : comp()
+		{}
+
+		explicit flat_set(const Compare& compare) : comp(compare)
+		{}
+
+		// O(n): sposta la coda dell'array
+		bool insert(const K& key)
+		{
+			size_t index = lower_index(key);
+			if (index < keys_.size() && !comp(key, keys_[index]))
+				return false;
+
+			keys_.insert(keys_.begin() + index, key);
+			return true;
+		}
+
+		// accoda, ordina solo i nuovi, toglie i duplicati e fonde con la parte gia' ordinata
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			size_t old_size = keys_.size();
+			keys_.insert(keys_.end(), first, last);
+			if (keys_.size() == old_size)
+				return;
+
+			auto middle = keys_.begin() + old_size;
+			std::sort(middle, keys_.end(), comp);
+			auto unique_end = std::unique(middle, keys_.end(), [this](const K& a, const K& b) { return equivalent(a, b); });
+			keys_.erase(unique_end, keys_.end());
+
+			std::inplace_merge(keys_.begin(), keys_.begin() + old_size, keys_.end(), comp);
+			keys_.erase(std::unique(keys_.begin(), keys_.end(), [this](const K& a, const K& b) { return equivalent(a, b); }), keys_.end());
+		}
+
+		bool erase(const K& key)
+		{
+			size_t index = lower_index(key);
+			if (index == keys_.size() || comp(key, keys_[index]))
+				return false;
+
+			keys_.erase(keys_.begin() + index);
+			return true;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return keys_.erase(pos);
+		}
+
+		bool find(const K& key) const
+		{
+			return contains_key(key);
+		}
+
+		bool contains(const K& key) const
+		{
+			return contains_key(key);
+		}
+
+		// ricerca eterogenea, solo con Compare::is_transparent
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool contains(const KeyLike& key) const
+		{
+			return contains_key(key);
+		}
+
+		iterator lower_bound(const K& key) const
+		{
+			return keys_.begin() + lower_index(key);
+		}
+
+		iterator upper_bound(const K& key) const
+		{
+			size_t index = lower_index(key);
+			if (index < keys_.size() && !comp(key, keys_[index]))
+				index++;
+			return keys_.begin() + index;
+		}
+
+		void clear()
+		{
+			keys_.clear();
+		}
+
+		void reserve(size_t capacity)
+		{
+			keys_.reserve(capacity);
+		}
+
+		void shrink_to_fit()
+		{
+			keys_.shrink_to_fit();
+		}
+
+		// array ordinato delle chiavi
+		const std::vector<K>& keys() const
+		{
+			return keys_;
+		}
+
+		size_t size() const { return keys_.size(); }
+		bool empty() const { return keys_.empty(); }
+
+		Compare key_comp() const
+		{
+			return comp;
+		}
+
+		iterator begin() const { return keys_.begin(); }
+		iterator end() const { return keys_.end(); }
+	};
+}
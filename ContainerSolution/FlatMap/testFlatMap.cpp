@@ -0,0 +1,352 @@
+#include "flat_map.h"
+#include "flat_set.h"
+#include "map.h"
+#include "unordered_map.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <map>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+template<typename Map>
+std::vector<std::pair<int, int>> contents(const Map& m)
+{
+	std::vector<std::pair<int, int>> result;
+	for (const auto& pair : m)
+		result.push_back({ pair.first, pair.second });
+	return result;
+}
+
+// ==================== TESTS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: FLAT_MAP BASIC OPERATIONS");
+
+	flat_map<int, std::string> m;
+	test_assert(m.empty() && m.begin() == m.end(), "New flat_map is empty");
+
+	m.insert(5, "five");
+	m.insert(1, "one");
+	m.insert(3, "three");
+	test_assert(m.size() == 3 && m.at(3) == "three" && m.contains(1) && !m.contains(2), "insert, at, contains");
+	test_assert(m.keys() == std::vector<int>({ 1, 3, 5 }), "Keys stored sorted and contiguous");
+
+	m.insert(3, "THREE");
+	test_assert(m.size() == 3 && m.at(3) == "THREE", "insert overwrites");
+
+	auto result = m.try_emplace(3, "ignored");
+	test_assert(!result.second && result.first->second == "THREE", "try_emplace keeps existing value");
+
+	m[7] = "seven";
+	test_assert(m.size() == 4 && m.find(7)->second == "seven" && m.find(6) == m.end(), "operator[] and find");
+
+	auto it = m.find(5);
+	it->second = "FIVE";
+	test_assert(m.at(5) == "FIVE" && it.key() == 5, "Values writable through iterator");
+
+	test_assert(m.lower_bound(4).key() == 5 && m.upper_bound(5).key() == 7 && m.upper_bound(7) == m.end(), "lower_bound / upper_bound");
+
+	bool thrown = false;
+	try
+	{
+		m.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "at() throws on missing key");
+
+	test_assert(m.erase(1) && !m.erase(1) && m.size() == 3 && m.begin().key() == 3, "erase(key)");
+	auto next = m.erase(m.find(5));
+	test_assert(next.key() == 7 && m.size() == 2, "erase(iterator) returns the next element");
+
+	std::vector<int> keys;
+	for (const auto& [key, value] : m)
+		keys.push_back(key);
+	test_assert(keys == std::vector<int>({ 3, 7 }), "Structured bindings in range-for");
+
+	flat_map<std::string, int, std::less<>> words;
+	words.insert("alpha", 1);
+	test_assert(words.contains(std::string_view("alpha")) && words.find("alpha")->second == 1, "Transparent lookup");
+}
+
+void test_batch_insert()
+{
+	section_header("TEST 2: FLAT_MAP BATCH INSERT");
+
+	flat_map<int, int> m;
+	std::vector<std::pair<int, int>> batch = { { 5, 50 }, { 1, 10 }, { 3, 30 }, { 1, 11 }, { 9, 90 } };
+	m.insert(batch.begin(), batch.end());
+	test_assert(contents(m) == std::vector<std::pair<int, int>>({ { 1, 11 }, { 3, 30 }, { 5, 50 }, { 9, 90 } }), "Sort and dedup, last duplicate wins");
+
+	std::vector<std::pair<int, int>> second = { { 4, 40 }, { 9, 99 }, { 0, 0 } };
+	m.insert(second.begin(), second.end());
+	test_assert(contents(m) == std::vector<std::pair<int, int>>({ { 0, 0 }, { 1, 11 }, { 3, 30 }, { 4, 40 }, { 5, 50 }, { 9, 99 } }), "Merge with existing keys");
+
+	// confronto con std::map su lotti casuali
+	flat_map<int, int> flat;
+	std::map<int, int> reference;
+	std::mt19937 rng(47);
+	std::uniform_int_distribution<int> dist(0, 20000);
+	for (int round = 0; round < 20; round++)
+	{
+		std::vector<std::pair<int, int>> pairs;
+		for (int i = 0; i < 1000; i++)
+			pairs.push_back({ dist(rng), round * 1000 + i });
+
+		flat.insert(pairs.begin(), pairs.end());
+		for (const auto& pair : pairs)
+			reference[pair.first] = pair.second;
+
+		if (round % 5 == 0)
+		{
+			int key = dist(rng);
+			flat.erase(key);
+			reference.erase(key);
+		}
+	}
+	std::vector<std::pair<int, int>> expected(reference.begin(), reference.end());
+	test_assert(contents(flat) == expected, "20 random batches match std::map");
+	test_assert(std::is_sorted(flat.keys().begin(), flat.keys().end()) && flat.keys().size() == flat.values().size(), "Arrays stay sorted and aligned");
+
+	bool all_found = true;
+	for (const auto& pair : reference)
+	{
+		if (!flat.contains(pair.first) || flat.at(pair.first) != pair.second)
+			all_found = false;
+	}
+	for (int key = -5; key < 20010; key += 7)
+	{
+		if (flat.contains(key) != (reference.count(key) == 1))
+			all_found = false;
+	}
+	test_assert(all_found, "Branchless search finds every key and rejects missing ones");
+
+	int visited = 0;
+	flat.for_each_in_range(100, 200, [&visited, &reference](const auto& pair) { visited += (pair.first >= 100 && pair.first < 200 && pair.second == reference.at(pair.first)); });
+	test_assert(visited == static_cast<int>(std::distance(reference.lower_bound(100), reference.lower_bound(200))), "for_each_in_range");
+}
+
+void test_flat_set()
+{
+	section_header("TEST 3: FLAT_SET");
+
+	flat_set<int> s;
+	test_assert(s.insert(5) && s.insert(1) && !s.insert(5) && s.size() == 2, "insert returns bool");
+
+	std::vector<int> batch = { 9, 3, 1, 7, 3, 3 };
+	s.insert(batch.begin(), batch.end());
+	test_assert(std::vector<int>(s.begin(), s.end()) == std::vector<int>({ 1, 3, 5, 7, 9 }), "Batch insert sorts and dedups");
+
+	test_assert(s.find(7) && s.contains(3) && !s.contains(4), "find / contains");
+	test_assert(*s.lower_bound(4) == 5 && *s.upper_bound(5) == 7 && s.upper_bound(9) == s.end(), "lower_bound / upper_bound");
+	test_assert(s.erase(3) && !s.erase(3) && s.size() == 4, "erase");
+
+	flat_set<int, std::greater<int>> descending;
+	std::vector<int> values = { 2, 8, 4 };
+	descending.insert(values.begin(), values.end());
+	test_assert(*descending.begin() == 8 && descending.contains(4), "Custom comparator");
+}
+
+// ==================== BENCHMARKS ====================
+
+void benchmark_lookup()
+{
+	section_header("BENCHMARK 1: LOOKUP - flat_map VS map VS unordered_map");
+
+	const int LOOKUPS = 1000000;
+	const int sizes[] = { 1000, 100000, 1000000 };
+
+	for (int n : sizes)
+	{
+		std::mt19937 rng(n);
+		std::uniform_int_distribution<int> dist(0, n * 4);
+
+		std::vector<std::pair<int, int>> pairs;
+		for (int i = 0; i < n; i++)
+			pairs.push_back({ dist(rng), i });
+
+		flat_map<int, int> flat;
+		flat.insert(pairs.begin(), pairs.end());
+
+		STDev::map<int, int> tree;
+		STDev::unordered_map<int, int> hash;
+		for (const auto& pair : pairs)
+		{
+			tree.insert(pair.first, pair.second);
+			hash[pair.first] = pair.second;
+		}
+
+		std::vector<int> queries(LOOKUPS);
+		for (int& query : queries)
+			query = dist(rng); // ~1/4 presenti
+
+		long long checksum[3] = { 0, 0, 0 };
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+		{
+			auto it = flat.find(query);
+			if (it != flat.end())
+				checksum[0] += it.value();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		auto flat_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+		{
+			auto it = tree.find(query);
+			if (it != tree.end())
+				checksum[1] += it->second;
+		}
+		end = std::chrono::high_resolution_clock::now();
+		auto tree_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+		{
+			auto it = hash.find(query);
+			if (it != hash.end())
+				checksum[2] += it->second;
+		}
+		end = std::chrono::high_resolution_clock::now();
+		auto hash_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		std::cout << "\n" << flat.size() << " chiavi, " << LOOKUPS << " ricerche:" << std::endl;
+		std::cout << "  flat_map:      " << flat_ns << " ns/lookup" << std::endl;
+		std::cout << "  map (RB-Tree): " << tree_ns << " ns/lookup" << std::endl;
+		std::cout << "  unordered_map: " << hash_ns << " ns/lookup" << std::endl;
+		std::cout << "  memoria dati:  flat_map " << flat.size() * (sizeof(int) + sizeof(int)) / 1024
+			<< " KB, map ~" << tree.size() * 32 / 1024 << " KB (nodi da 32 byte)" << std::endl;
+		if (checksum[0] != checksum[1] || checksum[1] != checksum[2])
+			std::cout << "  CHECKSUM DIVERSI!" << std::endl;
+	}
+}
+
+void benchmark_build()
+{
+	section_header("BENCHMARK 2: COSTRUZIONE DI 10^6 COPPIE");
+
+	const int N = 1000000;
+	std::mt19937 rng(5);
+	std::vector<std::pair<int, int>> pairs(N);
+	for (int i = 0; i < N; i++)
+		pairs[i] = { static_cast<int>(rng()), i };
+
+	auto start = std::chrono::high_resolution_clock::now();
+	flat_map<int, int> flat;
+	flat.insert(pairs.begin(), pairs.end());
+	auto end = std::chrono::high_resolution_clock::now();
+	auto flat_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> tree;
+	tree.insert(pairs.begin(), pairs.end());
+	end = std::chrono::high_resolution_clock::now();
+	auto tree_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n  flat_map insert(first, last): " << flat_ms << " ms" << std::endl;
+	std::cout << "  map insert(first, last):      " << tree_ms << " ms (" << flat.size() << " / " << tree.size() << ")" << std::endl;
+}
+
+// ==================== VISUAL DEMO ====================
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	flat_map<std::string, int> prices;
+	std::vector<std::pair<std::string, int>> catalog = { { "pera", 3 }, { "mela", 2 }, { "kiwi", 5 }, { "mela", 4 } };
+	prices.insert(catalog.begin(), catalog.end());
+
+	std::cout << "Chiavi:  ";
+	for (const auto& key : prices.keys())
+		std::cout << key << " ";
+	std::cout << "\nValori:  ";
+	for (int value : prices.values())
+		std::cout << value << " ";
+	std::cout << std::endl;
+}
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   FLAT_MAP / FLAT_SET TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_batch_insert();
+	test_flat_set();
+
+	g_stats.print_summary();
+
+	benchmark_lookup();
+	benchmark_build();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}
@@ -0,0 +1,401 @@
+#pragma once
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include "node_pool.h"
+
+namespace STDev
+{
+	template<typename T>
+	class forward_list
+	{
+	private:
+		struct NodeBase
+		{
+			NodeBase* nextNode; // successor node, nullptr if last
+		};
+
+		// un solo puntatore per nodo: meta' dell'overhead di Node<T> di list
+		struct Node : NodeBase
+		{
+			T value;
+
+			Node(const T& val) : NodeBase{ nullptr }, value(val)
+			{}
+		};
+
+		NodeBase head; // before_begin, non contiene valori (T non deve essere default-constructible)
+		size_t _size;
+
+		static Node* as_node(NodeBase* base)
+		{
+			return static_cast<Node*>(base);
+		}
+
+		// merge di due catene ordinate, stabile: a parita' vince il nodo di "left"
+		static NodeBase* merge(NodeBase* left, NodeBase* right)
+		{
+			NodeBase mergedHead{ nullptr };
+			NodeBase* tail = &mergedHead;
+
+			while (left != nullptr && right != nullptr)
+			{
+				if (as_node(right)->value < as_node(left)->value)
+				{
+					tail->nextNode = right;
+					right = right->nextNode;
+				}
+				else
+				{
+					tail->nextNode = left;
+					left = left->nextNode;
+				}
+				tail = tail->nextNode;
+			}
+			tail->nextNode = (left != nullptr) ? left : right;
+
+			return mergedHead.nextNode;
+		}
+
+		void copy_from(const forward_list& other)
+		{
+			NodeBase* tail = &head;
+			for (NodeBase* current = other.head.nextNode; current != nullptr; current = current->nextNode)
+			{
+				tail->nextNode = pool_new<Node>(as_node(current)->value);
+				tail = tail->nextNode;
+				++_size;
+			}
+		}
+
+	public:
+		class iterator;
+
+		forward_list() : head{ nullptr }, _size(0)
+		{}
+
+		~forward_list()
+		{
+			clear();
+		}
+
+		// Copy constructor
+		forward_list(const forward_list& other) : head{ nullptr }, _size(0)
+		{
+			copy_from(other);
+		}
+
+		// Copy assignment
+		forward_list& operator=(const forward_list& other)
+		{
+			if (this != &other)
+			{
+				clear();
+				copy_from(other);
+			}
+			return *this;
+		}
+
+		// Move constructor
+		forward_list(forward_list&& other) noexcept
+			: head{ other.head.nextNode }, _size(other._size)
+		{
+			other.head.nextNode = nullptr;
+			other._size = 0;
+		}
+
+		// Move assignment
+		forward_list& operator=(forward_list&& other) noexcept
+		{
+			if (this != &other)
+			{
+				clear();
+
+				head.nextNode = other.head.nextNode;
+				_size = other._size;
+
+				other.head.nextNode = nullptr;
+				other._size = 0;
+			}
+			return *this;
+		}
+
+		void push_front(const T& value)
+		{
+			Node* newNode = pool_new<Node>(value);
+
+			newNode->nextNode = head.nextNode;
+			head.nextNode = newNode;
+
+			++_size;
+		}
+
+		void pop_front()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("pop_front on empty forward_list");
+			}
+
+			Node* toDelete = as_node(head.nextNode);
+			head.nextNode = toDelete->nextNode;
+
+			pool_delete(toDelete);
+			--_size;
+		}
+
+		iterator insert_after(iterator pos, const T& value)
+		{
+			NodeBase* posNode = pos.current;
+			Node* newNode = pool_new<Node>(value);
+
+			newNode->nextNode = posNode->nextNode;
+			posNode->nextNode = newNode;
+
+			++_size;
+
+			return iterator(newNode);
+		}
+
+		iterator erase_after(iterator pos)
+		{
+			NodeBase* posNode = pos.current;
+			if (posNode == nullptr || posNode->nextNode == nullptr)
+			{
+				throw std::out_of_range("erase_after: no element after position");
+			}
+
+			Node* toDelete = as_node(posNode->nextNode);
+			posNode->nextNode = toDelete->nextNode;
+
+			pool_delete(toDelete);
+			--_size;
+
+			return iterator(posNode->nextNode);
+		}
+
+		// sposta tutti gli elementi di other dopo pos, O(lunghezza di other) per trovarne la coda
+		void splice_after(iterator pos, forward_list& other)
+		{
+			if (other.empty() || this == &other)
+			{
+				return;
+			}
+
+			NodeBase* posNode = pos.current;
+			NodeBase* otherFirst = other.head.nextNode;
+			NodeBase* otherLast = otherFirst;
+			while (otherLast->nextNode != nullptr)
+			{
+				otherLast = otherLast->nextNode;
+			}
+
+			otherLast->nextNode = posNode->nextNode;
+			posNode->nextNode = otherFirst;
+
+			_size += other._size;
+			other.head.nextNode = nullptr;
+			other._size = 0;
+		}
+
+		// sposta il solo elemento che segue "before" (in other) dopo pos, O(1)
+		void splice_after(iterator pos, forward_list& other, iterator before)
+		{
+			NodeBase* posNode = pos.current;
+			NodeBase* beforeNode = before.current;
+			NodeBase* moved = beforeNode->nextNode;
+
+			if (moved == nullptr || posNode == beforeNode || posNode == moved)
+			{
+				return;
+			}
+
+			beforeNode->nextNode = moved->nextNode;
+			moved->nextNode = posNode->nextNode;
+			posNode->nextNode = moved;
+
+			if (this != &other)
+			{
+				++_size;
+				--other._size;
+			}
+		}
+
+		// merge sort bottom-up sui link: O(n log n), stabile, nessuna allocazione
+		void sort()
+		{
+			if (_size < 2)
+			{
+				return;
+			}
+
+			// bins[i] contiene una catena ordinata di 2^i nodi (o e' vuoto)
+			NodeBase* bins[64] = {};
+			int maxBin = 0;
+
+			NodeBase* current = head.nextNode;
+			while (current != nullptr)
+			{
+				NodeBase* carry = current;
+				current = current->nextNode;
+				carry->nextNode = nullptr;
+
+				int i = 0;
+				while (i < maxBin && bins[i] != nullptr)
+				{
+					carry = merge(bins[i], carry);
+					bins[i] = nullptr;
+					++i;
+				}
+				bins[i] = carry;
+				if (i == maxBin)
+				{
+					++maxBin;
+				}
+			}
+
+			NodeBase* result = nullptr;
+			for (int i = 0; i < maxBin; ++i)
+			{
+				if (bins[i] != nullptr)
+				{
+					result = merge(bins[i], result);
+				}
+			}
+			head.nextNode = result;
+		}
+
+		T& front()
+		{
+			if (empty())
+			{
+				throw std::out_of_range("front on empty forward_list");
+			}
+			return as_node(head.nextNode)->value;
+		}
+
+		const T& front() const
+		{
+			if (empty())
+			{
+				throw std::out_of_range("front on empty forward_list");
+			}
+			return as_node(head.nextNode)->value;
+		}
+
+		void clear()
+		{
+			NodeBase* current = head.nextNode;
+			while (current != nullptr)
+			{
+				Node* toDelete = as_node(current);
+				current = current->nextNode;
+				pool_delete(toDelete);
+			}
+
+			head.nextNode = nullptr;
+			_size = 0;
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		bool empty() const
+		{
+			return _size == 0;
+		}
+
+		void print_visual() const
+		{
+			std::cout << "\n=== FORWARD LIST ===" << std::endl;
+			std::cout << "Size: " << _size << "\n" << std::endl;
+
+			std::cout << "[Head @" << &head << "]";
+			for (NodeBase* current = head.nextNode; current != nullptr; current = current->nextNode)
+			{
+				std::cout << " -> [" << as_node(current)->value << " @" << current << "]";
+			}
+			std::cout << " -> NULL" << std::endl;
+			std::cout << "====================\n" << std::endl;
+		}
+
+		iterator before_begin()
+		{
+			return iterator(&head);
+		}
+
+		iterator begin()
+		{
+			return iterator(head.nextNode);
+		}
+
+		iterator end()
+		{
+			return iterator(nullptr);
+		}
+
+		const iterator before_begin() const
+		{
+			return iterator(const_cast<NodeBase*>(&head));
+		}
+
+		const iterator begin() const
+		{
+			return iterator(head.nextNode);
+		}
+
+		const iterator end() const
+		{
+			return iterator(nullptr);
+		}
+
+	public:
+		class iterator // forward iterator
+		{
+			friend class forward_list;
+			NodeBase* current;
+
+		public:
+			iterator(NodeBase* ptr) : current(ptr)
+			{}
+
+			iterator() : current{ nullptr }
+			{}
+
+			iterator& operator++() // ++it
+			{
+				current = current->nextNode;
+				return *this;
+			}
+
+			iterator operator++(int) // it++
+			{
+				iterator temp = *this;
+				current = current->nextNode;
+				return temp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return current != other.current;
+			}
+
+			T& operator*() const
+			{
+				return as_node(current)->value;
+			}
+
+			T* operator->() const
+			{
+				return &(as_node(current)->value);
+			}
+		};
+	};
+}
@@ -0,0 +1,519 @@
+#include "forward_list.h"
+#include "list.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace STDev;
+
+// ============ TEST PUSH / POP ============
+
+void test_push_front()
+{
+	std::cout << "Test: push_front... ";
+	forward_list<int> l;
+
+	l.push_front(3);
+	l.push_front(2);
+	l.push_front(1);
+
+	assert(l.size() == 3);
+	assert(l.front() == 1);
+
+	auto verify = l.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+	assert(verify == l.end());
+
+	std::cout << "OK\n";
+}
+
+void test_pop_front()
+{
+	std::cout << "Test: pop_front... ";
+	forward_list<int> l;
+
+	l.push_front(2);
+	l.push_front(1);
+
+	l.pop_front();
+	assert(l.size() == 1);
+	assert(l.front() == 2);
+
+	l.pop_front();
+	assert(l.empty());
+
+	bool thrown = false;
+	try
+	{
+		l.pop_front();
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST INSERT_AFTER / ERASE_AFTER ============
+
+void test_insert_after()
+{
+	std::cout << "Test: insert_after... ";
+	forward_list<int> l;
+
+	auto it = l.insert_after(l.before_begin(), 1);
+	it = l.insert_after(it, 2);
+	l.insert_after(it, 4);
+	l.insert_after(it, 3);
+
+	assert(l.size() == 4);
+
+	auto verify = l.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+	assert(*verify++ == 4);
+
+	std::cout << "OK\n";
+}
+
+void test_erase_after()
+{
+	std::cout << "Test: erase_after... ";
+	forward_list<int> l;
+
+	for (int i = 5; i >= 1; i--)
+	{
+		l.push_front(i);
+	}
+
+	// rimuove il primo
+	auto next = l.erase_after(l.before_begin());
+	assert(*next == 2);
+
+	// rimuove il 3 (dopo il 2)
+	next = l.erase_after(l.begin());
+	assert(*next == 4);
+
+	assert(l.size() == 3);
+
+	auto verify = l.begin();
+	assert(*verify++ == 2);
+	assert(*verify++ == 4);
+	assert(*verify++ == 5);
+
+	bool thrown = false;
+	try
+	{
+		auto last = l.begin();
+		++last; ++last;
+		l.erase_after(last);
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST SPLICE_AFTER ============
+
+void test_splice_after_whole()
+{
+	std::cout << "Test: splice_after lista intera... ";
+	forward_list<int> l1;
+	forward_list<int> l2;
+
+	l1.push_front(4);
+	l1.push_front(1);
+
+	l2.push_front(3);
+	l2.push_front(2);
+
+	l1.splice_after(l1.begin(), l2);
+
+	assert(l1.size() == 4);
+	assert(l2.empty());
+
+	auto verify = l1.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+	assert(*verify++ == 4);
+
+	std::cout << "OK\n";
+}
+
+void test_splice_after_single()
+{
+	std::cout << "Test: splice_after singolo elemento... ";
+	forward_list<int> l1;
+	forward_list<int> l2;
+
+	l1.push_front(3);
+	l1.push_front(1);
+
+	l2.push_front(9);
+	l2.push_front(2);
+	l2.push_front(8);
+
+	// sposta il 2 (dopo l'8 in l2) dopo l'1 in l1
+	l1.splice_after(l1.begin(), l2, l2.begin());
+
+	assert(l1.size() == 3);
+	assert(l2.size() == 2);
+
+	auto verify = l1.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+
+	verify = l2.begin();
+	assert(*verify++ == 8);
+	assert(*verify++ == 9);
+
+	// splice nella stessa lista: porta il 3 in testa
+	auto before_three = l1.begin();
+	++before_three;
+	l1.splice_after(l1.before_begin(), l1, before_three);
+
+	assert(l1.size() == 3);
+	verify = l1.begin();
+	assert(*verify++ == 3);
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST SORT ============
+
+void test_sort()
+{
+	std::cout << "Test: sort... ";
+	forward_list<int> l;
+
+	int values[] = { 5, 3, 9, 1, 7, 2, 8, 6, 4, 0 };
+	for (int v : values)
+	{
+		l.push_front(v);
+	}
+
+	l.sort();
+
+	assert(l.size() == 10);
+	int expected = 0;
+	for (int v : l)
+	{
+		assert(v == expected++);
+	}
+
+	// sort su lista vuota e con un elemento
+	forward_list<int> empty_list;
+	empty_list.sort();
+	assert(empty_list.empty());
+
+	forward_list<int> single;
+	single.push_front(42);
+	single.sort();
+	assert(single.front() == 42);
+
+	std::cout << "OK\n";
+}
+
+struct Record
+{
+	int key;
+	int order;
+
+	bool operator<(const Record& other) const
+	{
+		return key < other.key;
+	}
+};
+
+void test_sort_stable()
+{
+	std::cout << "Test: sort stabile... ";
+	forward_list<Record> l;
+
+	// inserite in testa: l'ordine finale di inserimento e' order 0..5
+	Record records[] = { {2, 5}, {1, 4}, {2, 3}, {1, 2}, {2, 1}, {1, 0} };
+	for (const Record& r : records)
+	{
+		l.push_front(r);
+	}
+
+	l.sort();
+
+	auto it = l.begin();
+	assert(it->key == 1 && it->order == 0); ++it;
+	assert(it->key == 1 && it->order == 2); ++it;
+	assert(it->key == 1 && it->order == 4); ++it;
+	assert(it->key == 2 && it->order == 1); ++it;
+	assert(it->key == 2 && it->order == 3); ++it;
+	assert(it->key == 2 && it->order == 5); ++it;
+	assert(it == l.end());
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST COPY/MOVE ============
+
+void test_copy_and_move()
+{
+	std::cout << "Test: copy e move... ";
+	forward_list<std::string> l1;
+	l1.push_front("c");
+	l1.push_front("b");
+	l1.push_front("a");
+
+	forward_list<std::string> l2(l1);
+	assert(l2.size() == 3);
+	assert(l2.front() == "a");
+
+	l2.pop_front();
+	assert(l1.size() == 3);
+
+	forward_list<std::string> l3(std::move(l1));
+	assert(l3.size() == 3);
+	assert(l1.empty());
+
+	l1 = l3;
+	assert(l1.size() == 3);
+
+	l2 = std::move(l3);
+	assert(l2.size() == 3);
+	assert(l3.empty());
+
+	auto verify = l2.begin();
+	assert(*verify++ == "a");
+	assert(*verify++ == "b");
+	assert(*verify++ == "c");
+
+	std::cout << "OK\n";
+}
+
+// ============ TEST NODE POOL ============
+
+void test_pool_reuse()
+{
+	std::cout << "Test: riuso dei nodi del pool... ";
+	const int N = 1000;
+	forward_list<int> l;
+
+	std::vector<const int*> first_batch;
+	for (int i = 0; i < N; i++)
+	{
+		l.push_front(i);
+		first_batch.push_back(&l.front());
+	}
+	l.clear();
+
+	// i nodi liberati tornano nella free-list: il secondo giro li riusa
+	// (a parte il resto dell'ultimo slab ancora in cache)
+	for (int i = 0; i < N; i++)
+	{
+		l.push_front(i);
+	}
+
+	int reused = 0;
+	for (const int& v : l)
+	{
+		for (const int* p : first_batch)
+		{
+			if (p == &v)
+			{
+				reused++;
+				break;
+			}
+		}
+	}
+	assert(reused * 4 >= N * 3);
+
+	std::cout << "OK\n";
+}
+
+void test_pool_cross_thread_free()
+{
+	std::cout << "Test: free da un altro thread... ";
+	forward_list<int> l;
+
+	for (int i = 0; i < 10000; i++)
+	{
+		l.push_front(i);
+	}
+
+	// i nodi vengono restituiti al pool da un thread diverso (push lock-free)
+	std::thread t([&l]() { l.clear(); });
+	t.join();
+
+	for (int i = 0; i < 10000; i++)
+	{
+		l.push_front(i);
+	}
+	assert(l.size() == 10000);
+
+	std::cout << "OK\n";
+}
+
+void test_pool_short_lived_threads()
+{
+	std::cout << "Test: thread di breve durata non disperdono nodi... ";
+	auto& pool = node_pool<sizeof(Node<int>), alignof(Node<int>)>::instance();
+
+	// il main thread libera 10000 nodi nella free-list condivisa; ogni worker la prende tutta
+	// nella sua cache per un solo push_back e termina: i nodi non usati devono tornare al pool
+	auto run_rounds = [](int rounds)
+	{
+		for (int round = 0; round < rounds; round++)
+		{
+			{
+				list<int> l;
+				for (int i = 0; i < 10000; i++)
+				{
+					l.push_back(i);
+				}
+			}
+
+			std::thread worker([]()
+			{
+				list<int> l;
+				l.push_back(1);
+			});
+			worker.join();
+		}
+	};
+
+	run_rounds(10);
+	size_t slabs = pool.slab_count();
+	run_rounds(200);
+	assert(pool.slab_count() == slabs);
+
+	std::cout << "OK (" << slabs << " slab)\n";
+}
+
+// ============ BENCHMARK ============
+
+void benchmark_vs_list()
+{
+	std::cout << "\n=== BENCHMARK: forward_list vs list ===" << std::endl;
+	std::cout << "sizeof(list Node<int>):         " << sizeof(Node<int>) << " bytes" << std::endl;
+	std::cout << "sizeof(forward_list node<int>): " << sizeof(void*) + sizeof(int) << " bytes (padded to "
+		<< ((sizeof(void*) + sizeof(int) + alignof(void*) - 1) / alignof(void*) * alignof(void*)) << ")" << std::endl;
+
+	const int N = 1000000;
+	std::mt19937 g(42);
+	std::vector<int> values(N);
+	for (int& v : values)
+	{
+		v = static_cast<int>(g());
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	{
+		list<int> l;
+		for (int v : values)
+		{
+			l.push_front(v);
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto list_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	{
+		forward_list<int> l;
+		for (int v : values)
+		{
+			l.push_front(v);
+		}
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto fwd_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	forward_list<int> to_sort;
+	for (int v : values)
+	{
+		to_sort.push_front(v);
+	}
+	start = std::chrono::high_resolution_clock::now();
+	to_sort.sort();
+	end = std::chrono::high_resolution_clock::now();
+	auto sort_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\npush_front + destroy di " << N << " elementi:" << std::endl;
+	std::cout << "  list:          " << list_ms << " ms" << std::endl;
+	std::cout << "  forward_list:  " << fwd_ms << " ms" << std::endl;
+	std::cout << "forward_list::sort di " << N << " elementi: " << sort_ms << " ms" << std::endl;
+}
+
+// ============ TEST VISUAL DEMONSTRATION ============
+
+void test_visual_demonstration()
+{
+	std::cout << "\n=== DIMOSTRAZIONE VISIVA ===" << std::endl;
+
+	forward_list<int> l;
+	l.push_front(3);
+	l.push_front(1);
+	l.push_front(2);
+	l.print_visual();
+
+	std::cout << "Sort..." << std::endl;
+	l.sort();
+	l.print_visual();
+}
+
+// ============ MAIN ============
+
+int main()
+{
+	std::cout << "\n========================================\n";
+	std::cout << "TEST SUITE FORWARD_LIST\n";
+	std::cout << "========================================\n\n";
+
+	std::cout << "--- TEST PUSH/POP ---\n";
+	test_push_front();
+	test_pop_front();
+
+	std::cout << "\n--- TEST INSERT/ERASE AFTER ---\n";
+	test_insert_after();
+	test_erase_after();
+
+	std::cout << "\n--- TEST SPLICE AFTER ---\n";
+	test_splice_after_whole();
+	test_splice_after_single();
+
+	std::cout << "\n--- TEST SORT ---\n";
+	test_sort();
+	test_sort_stable();
+
+	std::cout << "\n--- TEST COPY/MOVE ---\n";
+	test_copy_and_move();
+
+	std::cout << "\n--- TEST NODE POOL ---\n";
+	test_pool_reuse();
+	test_pool_cross_thread_free();
+	test_pool_short_lived_threads();
+
+	std::cout << "\n========================================\n";
+	std::cout << "TUTTI I TEST SONO PASSATI!\n";
+	std::cout << "========================================\n";
+
+	benchmark_vs_list();
+	test_visual_demonstration();
+
+	return 0;
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include <string>
 #include <iostream>
+#include "node_pool.h"
 
 namespace STDev
 {
@@ -9,15 +10,26 @@ namespace STDev
 	{
 		Node* nextNode; // successor node, or first element if head
 		Node* previousNode; // predecessor node, or last element if head
-		K value;
+		union
+		{
+			K value; // mai costruito nel sentinel: K non deve essere default-constructible
+		};
 
-		Node() : nextNode(this), previousNode(this), value()
+		// sentinel
+		Node() : nextNode(this), previousNode(this)
 		{}
 
 		Node(const K& val) : nextNode(nullptr), previousNode(nullptr), value(val)
 		{}
+
+		// value e' distrutto da list::delete_node, solo per i nodi che lo contengono
+		~Node()
+		{}
 	};
 
+	// I nodi (sentinel compreso) vengono dal node_pool globale della loro dimensione:
+	// la memoria di una lista distrutta torna al pool e viene riusata da qualsiasi
+	// lista o forward_list, ma gli slab non vengono mai restituiti al sistema.
 	template<typename T>
 	class list
 	{
@@ -25,24 +37,30 @@ namespace STDev
 		Node<T>* nodeSentinel;
 		size_t _size;
 
+		static void delete_node(Node<T>* node) noexcept
+		{
+			node->value.~T();
+			pool_delete(node);
+		}
+
 	public:
 		class iterator;
 
 		list() : _size(0)
 		{
-			nodeSentinel = new Node<T>();
+			nodeSentinel = pool_new<Node<T>>();
 		}
 
 		~list()
 		{
 			clear();
-			delete nodeSentinel;
+			pool_delete(nodeSentinel);
 		}
 
 		// Copy constructor
 		list(const list& other) : _size(0)
 		{
-			nodeSentinel = new Node<T>();
+			nodeSentinel = pool_new<Node<T>>();
 
 			Node<T>* current = other.nodeSentinel->nextNode;
 			while (current != other.nodeSentinel)
@@ -73,7 +91,7 @@ namespace STDev
 		list(list&& other) noexcept
 			: nodeSentinel(other.nodeSentinel), _size(other._size)
 		{
-			other.nodeSentinel = new Node<T>();
+			other.nodeSentinel = pool_new<Node<T>>();
 			other._size = 0;
 		}
 
@@ -83,12 +101,12 @@ namespace STDev
 			if (this != &other)
 			{
 				clear();
-				delete nodeSentinel;
+				pool_delete(nodeSentinel);
 
 				nodeSentinel = other.nodeSentinel;
 				_size = other._size;
 
-				other.nodeSentinel = new Node<T>();
+				other.nodeSentinel = pool_new<Node<T>>();
 				other._size = 0;
 			}
 			return *this;
@@ -96,7 +114,7 @@ namespace STDev
 
 		void push_front(const T& value)
 		{
-			Node<T>* newNode = new Node<T>(value);
+			Node<T>* newNode = pool_new<Node<T>>(value);
 
 			newNode->nextNode = nodeSentinel->nextNode;
 			newNode->previousNode = nodeSentinel;
@@ -109,7 +127,7 @@ namespace STDev
 
 		void push_back(const T& value)
 		{
-			Node<T>* newNode = new Node<T>(value);
+			Node<T>* newNode = pool_new<Node<T>>(value);
 
 			newNode->previousNode = nodeSentinel->previousNode;
 			newNode->nextNode = nodeSentinel;
@@ -132,7 +150,7 @@ namespace STDev
 			nodeSentinel->nextNode = toDelete->nextNode;
 			toDelete->nextNode->previousNode = nodeSentinel;
 
-			delete toDelete;
+			delete_node(toDelete);
 			--_size;
 		}
 
@@ -148,14 +166,14 @@ namespace STDev
 			nodeSentinel->previousNode = toDelete->previousNode;
 			toDelete->previousNode->nextNode = nodeSentinel;
 
-			delete toDelete;
+			delete_node(toDelete);
 			--_size;
 		}
 
 		iterator insert(iterator pos, const T& value)
 		{
 			Node<T>* posNode = pos.current;
-			Node<T>* newNode = new Node<T>(value);
+			Node<T>* newNode = pool_new<Node<T>>(value);
 
 			newNode->previousNode = posNode->previousNode;
 			newNode->nextNode = posNode;
@@ -181,7 +199,7 @@ namespace STDev
 			toDelete->previousNode->nextNode = toDelete->nextNode;
 			toDelete->nextNode->previousNode = toDelete->previousNode;
 
-			delete toDelete;
+			delete_node(toDelete);
 			--_size;
 
 			return iterator(nextNode);
@@ -211,6 +229,33 @@ namespace STDev
 			other._size = 0;
 		}
 
+		// sposta il solo nodo "it" (di other, anche other == *this) prima di pos, O(1)
+		void splice(iterator pos, list& other, iterator it)
+		{
+			Node<T>* posNode = pos.current;
+			Node<T>* moved = it.current;
+
+			if (moved == posNode || moved->nextNode == posNode)
+			{
+				return;
+			}
+
+			moved->previousNode->nextNode = moved->nextNode;
+			moved->nextNode->previousNode = moved->previousNode;
+
+			moved->previousNode = posNode->previousNode;
+			moved->nextNode = posNode;
+
+			posNode->previousNode->nextNode = moved;
+			posNode->previousNode = moved;
+
+			if (this != &other)
+			{
+				++_size;
+				--other._size;
+			}
+		}
+
 		T& front()
 		{
 			if (empty())
@@ -254,7 +299,7 @@ namespace STDev
 			{
 				Node<T>* toDelete = current;
 				current = current->nextNode;
-				delete toDelete;
+				delete_node(toDelete);
 			}
 
 			nodeSentinel->nextNode = nodeSentinel;
@@ -325,7 +370,8 @@ namespace STDev
 		void print_node(const Node<T>* node, const std::string& label) const
 		{
 			std::cout << "[" << label << " @" << node << "]" << std::endl;
-			std::cout << "  value: " << node->value << std::endl;
+			if (node != nodeSentinel)
+				std::cout << "  value: " << node->value << std::endl;
 			std::cout << "  prev: " << node->previousNode << std::endl;
 			std::cout << "  next: " << node->nextNode << std::endl;
 		}
@@ -0,0 +1,162 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace STDev
+{
+	// Pool di nodi a dimensione fissa condiviso da list e forward_list.
+	// I nodi vengono ritagliati da slab e, una volta liberati, tornano in una
+	// free-list: la push e' lock-free (CAS), quindi un nodo puo' essere
+	// restituito da qualsiasi thread. L'allocazione pesca da una cache
+	// thread_local e, quando e' vuota, ruba l'intera free-list condivisa con
+	// una sola exchange (nessun problema di ABA, a differenza della pop CAS).
+	// Alla fine del thread la cache restituisce i nodi rimasti alla free-list condivisa.
+	// Il pool non viene mai distrutto (e gli slab non tornano al sistema): i container
+	// globali possono liberare i nodi anche durante la distruzione degli oggetti statici.
+	template<size_t Size, size_t Align>
+	class node_pool
+	{
+	private:
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+
+		static constexpr size_t STRIDE =
+			((Size < sizeof(FreeNode) ? sizeof(FreeNode) : Size) + Align - 1) / Align * Align;
+		static constexpr size_t SLAB_NODES = 256;
+
+		static_assert(Align <= alignof(std::max_align_t), "node_pool: over-aligned nodes not supported");
+
+		std::atomic<FreeNode*> shared_free;
+		std::mutex slab_mutex; // solo per la lista degli slab, non per allocate/deallocate
+		std::vector<void*> slabs;
+
+		// cache del thread: il distruttore (fine del thread) rende i nodi non usati
+		struct LocalCache
+		{
+			FreeNode* head = nullptr;
+
+			~LocalCache()
+			{
+				if (head != nullptr)
+				{
+					instance().push_chain(head);
+				}
+			}
+		};
+
+		static FreeNode*& local_free()
+		{
+			thread_local LocalCache cache;
+			return cache.head;
+		}
+
+		node_pool() : shared_free(nullptr)
+		{}
+
+		// rimette una catena di nodi liberi nella free-list condivisa con una sola CAS
+		void push_chain(FreeNode* first) noexcept
+		{
+			FreeNode* last = first;
+			while (last->next != nullptr)
+			{
+				last = last->next;
+			}
+
+			last->next = shared_free.load(std::memory_order_relaxed);
+			while (!shared_free.compare_exchange_weak(last->next, first,
+				std::memory_order_release, std::memory_order_relaxed))
+			{}
+		}
+
+		FreeNode* allocate_slab()
+		{
+			char* slab = static_cast<char*>(::operator new(STRIDE * SLAB_NODES));
+			{
+				std::lock_guard<std::mutex> lock(slab_mutex);
+				slabs.push_back(slab);
+			}
+
+			// collega i nodi dello slab tra loro, il primo viene restituito
+			for (size_t i = 1; i < SLAB_NODES - 1; ++i)
+			{
+				reinterpret_cast<FreeNode*>(slab + i * STRIDE)->next =
+					reinterpret_cast<FreeNode*>(slab + (i + 1) * STRIDE);
+			}
+			reinterpret_cast<FreeNode*>(slab + (SLAB_NODES - 1) * STRIDE)->next = nullptr;
+			local_free() = reinterpret_cast<FreeNode*>(slab + STRIDE);
+
+			return reinterpret_cast<FreeNode*>(slab);
+		}
+
+	public:
+		node_pool(const node_pool&) = delete;
+		node_pool& operator=(const node_pool&) = delete;
+
+		// creato al primo uso e mai distrutto: l'ordine di distruzione degli statici non conta
+		static node_pool& instance()
+		{
+			static node_pool* pool = new node_pool();
+			return *pool;
+		}
+
+		void* allocate()
+		{
+			FreeNode*& head = local_free();
+			if (head == nullptr)
+			{
+				head = shared_free.exchange(nullptr, std::memory_order_acquire);
+				if (head == nullptr)
+				{
+					return allocate_slab();
+				}
+			}
+
+			FreeNode* node = head;
+			head = node->next;
+			return node;
+		}
+
+		void deallocate(void* ptr) noexcept
+		{
+			FreeNode* node = static_cast<FreeNode*>(ptr);
+			node->next = nullptr;
+			push_chain(node);
+		}
+
+		size_t slab_count()
+		{
+			std::lock_guard<std::mutex> lock(slab_mutex);
+			return slabs.size();
+		}
+	};
+
+	// Helper per costruire/distruggere un nodo dentro il pool della sua dimensione
+	template<typename NodeT, typename... Args>
+	NodeT* pool_new(Args&&... args)
+	{
+		auto& pool = node_pool<sizeof(NodeT), alignof(NodeT)>::instance();
+		void* memory = pool.allocate();
+		try
+		{
+			return new (memory) NodeT(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			pool.deallocate(memory);
+			throw;
+		}
+	}
+
+	template<typename NodeT>
+	void pool_delete(NodeT* node) noexcept
+	{
+		node->~NodeT();
+		node_pool<sizeof(NodeT), alignof(NodeT)>::instance().deallocate(node);
+	}
+}
@@ -489,6 +489,50 @@ void test_splice_multiple_operations()
 	std::cout << "OK\n";
 }
 
+void test_splice_single_node()
+{
+	std::cout << "Test: splice di un singolo nodo... ";
+	list<int> l1;
+	list<int> l2;
+
+	l1.push_back(1);
+	l1.push_back(3);
+
+	l2.push_back(2);
+	l2.push_back(9);
+
+	// sposta il 2 da l2 prima del 3 in l1
+	auto pos = l1.begin();
+	++pos;
+	l1.splice(pos, l2, l2.begin());
+
+	assert(l1.size() == 3);
+	assert(l2.size() == 1);
+	assert(l2.front() == 9);
+
+	auto verify = l1.begin();
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+	assert(*verify++ == 3);
+
+	// nella stessa lista: porta l'ultimo in testa (move-to-front)
+	auto last = l1.end();
+	--last;
+	l1.splice(l1.begin(), l1, last);
+
+	assert(l1.size() == 3);
+	verify = l1.begin();
+	assert(*verify++ == 3);
+	assert(*verify++ == 1);
+	assert(*verify++ == 2);
+
+	// no-op: il nodo e' gia' in posizione
+	l1.splice(l1.begin(), l1, l1.begin());
+	assert(l1.front() == 3);
+
+	std::cout << "OK\n";
+}
+
 // ============ TEST COMBINED OPERATIONS ============
 
 void test_insert_erase_combined()
@@ -612,6 +656,44 @@ void test_move_after_splice()
 	std::cout << "OK\n";
 }
 
+// valore senza costruttore di default: il sentinel non ne costruisce uno
+struct Counted
+{
+	static int live;
+	int value;
+
+	explicit Counted(int v) : value(v) { live++; }
+	Counted(const Counted& other) : value(other.value) { live++; }
+	~Counted() { live--; }
+};
+
+int Counted::live = 0;
+
+void test_no_default_constructor()
+{
+	std::cout << "Test: valori senza costruttore di default... ";
+	{
+		list<Counted> l1;
+		assert(Counted::live == 0);
+
+		for (int i = 0; i < 10; i++)
+		{
+			l1.push_back(Counted(i));
+		}
+		l1.pop_front();
+		l1.erase(l1.begin());
+		assert(Counted::live == 8);
+
+		list<Counted> l2(std::move(l1));
+		assert(Counted::live == 8 && l2.front().value == 2);
+		l2.pop_back();
+		assert(Counted::live == 7);
+	}
+	assert(Counted::live == 0);
+
+	std::cout << "OK\n";
+}
+
 // ============ TEST STRESS ============
 
 void test_stress_insert_erase()
@@ -764,6 +846,7 @@ int main()
 	test_splice_to_empty();
 	test_splice_single_element();
 	test_splice_multiple_operations();
+	test_splice_single_node();
 
 	std::cout << "\n--- TEST COMBINED ---\n";
 	test_insert_erase_combined();
@@ -772,6 +855,7 @@ int main()
 	std::cout << "\n--- TEST COPY/MOVE ---\n";
 	test_copy_after_insert();
 	test_move_after_splice();
+	test_no_default_constructor();
 
 	std::cout << "\n--- TEST STRESS ---\n";
 	test_stress_insert_erase();
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include "list.h"
+#include "unordered_map.h"
+
+#if !USE_OPTIMIZED_REHASH
+#error "lru_cache richiede USE_OPTIMIZED_REHASH: la chiave vive nel nodo della mappa e deve restare stabile al rehash"
+#endif
+
+STDEV_BEGIN
+
+// Cache LRU: list per l'ordine di recency (front = piu' recente, splice O(1))
+// + unordered_map chiave -> iteratore della lista per il lookup O(1).
+// La chiave e' memorizzata una sola volta, nel nodo della mappa: la voce nella
+// lista tiene solo un puntatore ad essa (stabile perche' il rehash riusa i nodi).
+template<typename K, typename V>
+class lru_cache
+{
+private:
+
+	struct Entry
+	{
+		const K* key; // punta alla chiave nel nodo di index
+		V value;
+		mutable std::atomic<bool> referenced; // bit CLOCK, settato da touch()
+
+		Entry(const V& v) : key(nullptr), value(v), referenced(false)
+		{}
+
+		Entry(const Entry& other)
+			: key(other.key), value(other.value), referenced(other.referenced.load(std::memory_order_relaxed))
+		{}
+	};
+
+	typedef typename list<Entry>::iterator entry_iterator;
+
+	list<Entry> entries;
+	unordered_map<K, entry_iterator> index;
+
+	size_t _capacity;    // max numero di voci (0 = illimitato)
+	size_t _byte_budget; // max byte secondo il weigher (0 = illimitato)
+	size_t _bytes;
+
+	std::function<size_t(const K&, const V&)> weigher;
+	std::function<void(const K&, V&)> on_evict;
+
+	size_t _hits;
+	size_t _misses;
+	size_t _evictions;
+
+	bool over_budget() const
+	{
+		return (_capacity != 0 && entries.size() > _capacity) ||
+			(_byte_budget != 0 && _bytes > _byte_budget);
+	}
+
+	void evict_lru()
+	{
+		entry_iterator victim = entries.end();
+		--victim;
+
+		// second chance: una voce marcata da touch() torna in testa invece di uscire
+		while (victim->referenced.load(std::memory_order_relaxed))
+		{
+			victim->referenced.store(false, std::memory_order_relaxed);
+			promote(victim);
+			victim = entries.end();
+			--victim;
+		}
+
+		const K& key = *victim->key;
+		_bytes -= weigher(key, victim->value);
+		++_evictions;
+
+		if (on_evict)
+		{
+			on_evict(key, victim->value);
+		}
+
+		entries.erase(victim);
+		index.erase(key); // la chiave muore qui, dopo l'ultimo uso
+	}
+
+	void evict_while_over_budget()
+	{
+		while (!entries.empty() && over_budget())
+		{
+			evict_lru();
+		}
+	}
+
+	void promote(entry_iterator it)
+	{
+		entries.splice(entries.begin(), entries, it);
+	}
+
+public:
+
+	explicit lru_cache(size_t capacity, size_t byte_budget = 0,
+		std::function<size_t(const K&, const V&)> weigher_fn = nullptr)
+		: _capacity(capacity), _byte_budget(byte_budget), _bytes(0),
+		weigher(weigher_fn ? std::move(weigher_fn) : [](const K&, const V&) { return sizeof(K) + sizeof(V); }),
+		_hits(0), _misses(0), _evictions(0)
+	{
+		if (capacity == 0 && byte_budget == 0)
+			throw std::invalid_argument("lru_cache: serve una capacity o un byte budget");
+	}
+
+	// le voci puntano alle chiavi dentro la propria mappa: la copia non ha senso
+	lru_cache(const lru_cache&) = delete;
+	lru_cache& operator=(const lru_cache&) = delete;
+
+	// il move sposta sentinel e bucket, i nodi (e quindi i puntatori alle chiavi) restano validi
+	lru_cache(lru_cache&&) = default;
+	lru_cache& operator=(lru_cache&&) = default;
+
+	~lru_cache() = default;
+
+	// restituisce il valore e lo rende il piu' recente, nullptr se assente
+	V* get(const K& key)
+	{
+		auto found = index.find(key);
+		if (found == index.end())
+		{
+			++_misses;
+			return nullptr;
+		}
+
+		++_hits;
+		promote(found->second);
+		return &found->second->value;
+	}
+
+	// come get ma senza toccare recency e contatori
+	const V* peek(const K& key) const
+	{
+		auto found = index.find(key);
+		if (found == index.end())
+			return nullptr;
+
+		return &found->second->value;
+	}
+
+	// approssimazione CLOCK di get: nessuna modifica strutturale, la voce viene solo
+	// marcata e avra' una seconda possibilita' all'eviction. Non aggiorna i contatori,
+	// quindi e' sicura in concorrenza con altre touch/peek (es. sotto un lock condiviso).
+	const V* touch(const K& key) const
+	{
+		auto found = index.find(key);
+		if (found == index.end())
+			return nullptr;
+
+		std::atomic<bool>& referenced = found->second->referenced;
+		if (!referenced.load(std::memory_order_relaxed)) // evita scritture sulle voci gia' calde
+			referenced.store(true, std::memory_order_relaxed);
+		return &found->second->value;
+	}
+
+	// inserisce o aggiorna; ritorna true se la chiave era nuova
+	bool put(const K& key, const V& value)
+	{
+		auto found = index.find(key);
+		if (found != index.end())
+		{
+			Entry& entry = *found->second;
+			size_t old_weight = weigher(key, entry.value);
+			entry.value = value; // se lancia la voce resta quella vecchia, _bytes compreso
+			_bytes = _bytes - old_weight + weigher(key, entry.value);
+
+			promote(found->second);
+			evict_while_over_budget();
+			return false;
+		}
+
+		// prima la chiave nell'indice: se la voce non si puo' costruire si toglie la chiave,
+		// e nessuna voce resta in lista senza chiave
+		size_t weight = weigher(key, value);
+		auto inserted = index.insert(key, entries.end()).first;
+		try
+		{
+			entries.push_front(Entry(value));
+		}
+		catch (...)
+		{
+			index.erase(key);
+			throw;
+		}
+		inserted->second = entries.begin();
+		entries.front().key = &inserted->first;
+		_bytes += weight;
+
+		evict_while_over_budget(); // una voce piu' grande dell'intero budget viene subito evinta
+		return true;
+	}
+
+	bool erase(const K& key)
+	{
+		auto found = index.find(key);
+		if (found == index.end())
+			return false;
+
+		_bytes -= weigher(key, found->second->value);
+		entries.erase(found->second);
+		index.erase(key);
+		return true;
+	}
+
+	bool contains(const K& key) const
+	{
+		return index.contains(key);
+	}
+
+	void clear()
+	{
+		entries.clear();
+		index.clear();
+		_bytes = 0;
+	}
+
+	void set_eviction_callback(std::function<void(const K&, V&)> callback)
+	{
+		on_evict = std::move(callback);
+	}
+
+	size_t size() const { return entries.size(); }
+	bool empty() const { return entries.empty(); }
+	size_t capacity() const { return _capacity; }
+	size_t byte_budget() const { return _byte_budget; }
+	size_t bytes() const { return _bytes; }
+
+	size_t hits() const { return _hits; }
+	size_t misses() const { return _misses; }
+	size_t evictions() const { return _evictions; }
+
+	double hit_ratio() const
+	{
+		size_t lookups = _hits + _misses;
+		return lookups == 0 ? 0.0 : static_cast<double>(_hits) / lookups;
+	}
+
+	void reset_stats()
+	{
+		_hits = 0;
+		_misses = 0;
+		_evictions = 0;
+	}
+
+	// chiave piu' recente / meno recente (per debug e test)
+	const K& most_recent() const
+	{
+		if (empty())
+			throw std::out_of_range("lru_cache::most_recent: cache vuota");
+		return *entries.front().key;
+	}
+
+	const K& least_recent() const
+	{
+		if (empty())
+			throw std::out_of_range("lru_cache::least_recent: cache vuota");
+		return *entries.back().key;
+	}
+
+	void print_structure() const
+	{
+		std::cout << "\n=== LRU_CACHE STRUCTURE ===" << std::endl;
+		std::cout << "Size: " << entries.size() << " / " << _capacity << std::endl;
+		std::cout << "Bytes: " << _bytes << " / " << _byte_budget << std::endl;
+		std::cout << "Hits: " << _hits << "  Misses: " << _misses << "  Evictions: " << _evictions << std::endl;
+
+		std::cout << "MRU";
+		for (auto it = entries.begin(); it != entries.end(); ++it)
+		{
+			std::cout << " -> [" << *it->key << ":" << it->value << "]";
+		}
+		std::cout << " -> LRU" << std::endl;
+		std::cout << "===========================\n" << std::endl;
+	}
+};
+
+STDEV_END
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+#include "lru_cache.h"
+
+STDEV_BEGIN
+
+enum class ShardPromotion
+{
+	// get() sposta la voce in testa: LRU esatto per shard, ma ogni lookup
+	// prende il lock dello shard in esclusiva
+	Lru,
+
+	// get() marca solo il bit di riferimento sotto lock condiviso (CLOCK /
+	// second chance): i lookup dello stesso shard procedono in parallelo,
+	// put ed eviction restano esclusivi
+	Clock
+};
+
+// Cache LRU thread-safe partizionata in N shard indipendenti, ognuno con il
+// proprio lock e il proprio lru_cache. Lo shard si sceglie con hash_function
+// (la stessa di unordered_map) usando i bit ALTI: quelli bassi scelgono gia' il
+// bucket dentro lo shard e riusarli lascerebbe vuota gran parte dei bucket.
+template<typename K, typename V>
+class sharded_lru_cache
+{
+private:
+
+	struct alignas(64) Shard // una cache line per shard: niente false sharing tra lock
+	{
+		lru_cache<K, V> cache;
+		mutable std::shared_mutex mutex;
+		std::atomic<size_t> hits;
+		std::atomic<size_t> misses;
+
+		explicit Shard(size_t capacity) : cache(capacity), hits(0), misses(0)
+		{}
+	};
+
+	std::vector<std::unique_ptr<Shard>> shards;
+	unsigned shard_bits;
+	ShardPromotion promotion;
+
+	Shard& shard_for(const K& key) const
+	{
+		return *shards[shard_of(key)];
+	}
+
+public:
+
+	explicit sharded_lru_cache(size_t capacity, size_t shard_count = 16,
+		ShardPromotion promotion_mode = ShardPromotion::Lru)
+		: shard_bits(0), promotion(promotion_mode)
+	{
+		if (capacity == 0 || shard_count == 0)
+			throw std::invalid_argument("sharded_lru_cache: capacity e shard_count devono essere > 0");
+
+		// numero di shard arrotondato alla potenza di 2 successiva
+		while ((size_t(1) << shard_bits) < shard_count)
+			++shard_bits;
+
+		size_t count = size_t(1) << shard_bits;
+		size_t per_shard = (capacity + count - 1) / count;
+
+		shards.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			shards.push_back(std::make_unique<Shard>(per_shard));
+	}
+
+	sharded_lru_cache(const sharded_lru_cache&) = delete;
+	sharded_lru_cache& operator=(const sharded_lru_cache&) = delete;
+
+	size_t shard_of(const K& key) const
+	{
+		if (shard_bits == 0)
+			return 0;
+
+		size_t h = hash_function<K>(key);
+		return h >> (sizeof(size_t) * 8 - shard_bits);
+	}
+
+	// copia il valore in out: un puntatore non sarebbe valido fuori dal lock
+	bool get(const K& key, V& out)
+	{
+		Shard& shard = shard_for(key);
+
+		if (promotion == ShardPromotion::Clock)
+		{
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			const V* value = shard.cache.touch(key);
+			if (value == nullptr)
+			{
+				shard.misses.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			shard.hits.fetch_add(1, std::memory_order_relaxed);
+			out = *value;
+			return true;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		V* value = shard.cache.get(key);
+		if (value == nullptr)
+		{
+			shard.misses.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		shard.hits.fetch_add(1, std::memory_order_relaxed);
+		out = *value;
+		return true;
+	}
+
+	bool put(const K& key, const V& value)
+	{
+		Shard& shard = shard_for(key);
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		return shard.cache.put(key, value);
+	}
+
+	bool erase(const K& key)
+	{
+		Shard& shard = shard_for(key);
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		return shard.cache.erase(key);
+	}
+
+	bool contains(const K& key) const
+	{
+		Shard& shard = shard_for(key);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		return shard.cache.contains(key);
+	}
+
+	void clear()
+	{
+		for (auto& shard : shards)
+		{
+			std::unique_lock<std::shared_mutex> lock(shard->mutex);
+			shard->cache.clear();
+		}
+	}
+
+	// la callback viene invocata con il lock dello shard acquisito
+	void set_eviction_callback(std::function<void(const K&, V&)> callback)
+	{
+		for (auto& shard : shards)
+		{
+			std::unique_lock<std::shared_mutex> lock(shard->mutex);
+			shard->cache.set_eviction_callback(callback);
+		}
+	}
+
+	// somme su tutti gli shard: non sono uno snapshot atomico dell'intera cache
+	size_t size() const
+	{
+		size_t total = 0;
+		for (const auto& shard : shards)
+		{
+			std::shared_lock<std::shared_mutex> lock(shard->mutex);
+			total += shard->cache.size();
+		}
+		return total;
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	size_t hits() const
+	{
+		size_t total = 0;
+		for (const auto& shard : shards)
+			total += shard->hits.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	size_t misses() const
+	{
+		size_t total = 0;
+		for (const auto& shard : shards)
+			total += shard->misses.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	size_t evictions() const
+	{
+		size_t total = 0;
+		for (const auto& shard : shards)
+		{
+			std::shared_lock<std::shared_mutex> lock(shard->mutex);
+			total += shard->cache.evictions();
+		}
+		return total;
+	}
+
+	double hit_ratio() const
+	{
+		size_t h = hits();
+		size_t lookups = h + misses();
+		return lookups == 0 ? 0.0 : static_cast<double>(h) / lookups;
+	}
+
+	size_t shard_count() const { return shards.size(); }
+	size_t shard_size(size_t index) const
+	{
+		std::shared_lock<std::shared_mutex> lock(shards.at(index)->mutex);
+		return shards[index]->cache.size();
+	}
+	ShardPromotion promotion_mode() const { return promotion; }
+};
+
+STDEV_END
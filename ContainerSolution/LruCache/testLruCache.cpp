@@ -0,0 +1,671 @@
+#include "lru_cache.h"
+#include "sharded_lru_cache.h"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+// Generatore di chiavi Zipf(s) su [0, n): CDF precalcolata + ricerca binaria
+class zipf_generator
+{
+private:
+	std::vector<double> cdf;
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> uniform;
+
+public:
+	zipf_generator(size_t n, double s, unsigned seed)
+		: cdf(n), rng(seed), uniform(0.0, 1.0)
+	{
+		double sum = 0.0;
+		for (size_t i = 0; i < n; i++)
+		{
+			sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+			cdf[i] = sum;
+		}
+		for (double& c : cdf)
+			c /= sum;
+	}
+
+	int next()
+	{
+		double u = uniform(rng);
+		auto it = std::lower_bound(cdf.begin(), cdf.end(), u);
+		if (it == cdf.end())
+			--it;
+		return static_cast<int>(it - cdf.begin());
+	}
+};
+
+// ==================== TEST FUNCTIONS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: BASIC OPERATIONS");
+
+	lru_cache<int, std::string> cache(3);
+
+	test_assert(cache.empty(), "New cache is empty");
+
+	test_assert(cache.put(1, "one"), "put() of new key returns true");
+	cache.put(2, "two");
+	cache.put(3, "three");
+	test_assert(cache.size() == 3, "Size is 3 after three puts");
+
+	std::string* value = cache.get(2);
+	test_assert(value != nullptr && *value == "two", "get() returns stored value");
+	test_assert(cache.get(99) == nullptr, "get() returns nullptr on miss");
+
+	test_assert(!cache.put(2, "TWO"), "put() of existing key returns false");
+	test_assert(*cache.get(2) == "TWO", "put() updates existing value");
+	test_assert(cache.size() == 3, "Update does not change size");
+
+	test_assert(cache.erase(1), "erase() returns true on existing key");
+	test_assert(!cache.erase(1), "erase() returns false on missing key");
+	test_assert(!cache.contains(1), "Erased key not contained");
+	test_assert(cache.size() == 2, "Size decreased after erase");
+
+	cache.clear();
+	test_assert(cache.empty(), "Cache empty after clear");
+	test_assert(cache.get(2) == nullptr, "No entries after clear");
+}
+
+void test_lru_order()
+{
+	section_header("TEST 2: LRU ORDER AND EVICTION");
+
+	lru_cache<int, int> cache(3);
+	cache.put(1, 10);
+	cache.put(2, 20);
+	cache.put(3, 30);
+
+	test_assert(cache.most_recent() == 3, "Last put is most recent");
+	test_assert(cache.least_recent() == 1, "First put is least recent");
+
+	cache.get(1); // 1 diventa il piu' recente, 2 il meno recente
+	test_assert(cache.most_recent() == 1, "get() promotes to most recent");
+	test_assert(cache.least_recent() == 2, "Least recent updated after get()");
+
+	cache.put(4, 40); // evince 2
+	test_assert(cache.size() == 3, "Size bounded by capacity");
+	test_assert(!cache.contains(2), "Least recent key evicted");
+	test_assert(cache.contains(1) && cache.contains(3) && cache.contains(4), "Other keys kept");
+	test_assert(cache.evictions() == 1, "Eviction counted");
+
+	const int* peeked = cache.peek(3);
+	test_assert(peeked != nullptr && *peeked == 30, "peek() returns value");
+	test_assert(cache.least_recent() == 3, "peek() does not promote");
+
+	cache.put(3, 33); // l'aggiornamento promuove
+	test_assert(cache.most_recent() == 3, "put() on existing key promotes");
+}
+
+void test_counters()
+{
+	section_header("TEST 3: HIT / MISS / EVICTION COUNTERS");
+
+	lru_cache<int, int> cache(2);
+	cache.put(1, 1);
+	cache.put(2, 2);
+
+	cache.get(1);
+	cache.get(2);
+	cache.get(3);
+	cache.peek(1); // non conta
+
+	test_assert(cache.hits() == 2, "Hits counted");
+	test_assert(cache.misses() == 1, "Misses counted");
+	test_assert(cache.hit_ratio() > 0.66 && cache.hit_ratio() < 0.67, "Hit ratio computed");
+
+	cache.put(3, 3);
+	cache.put(4, 4);
+	test_assert(cache.evictions() == 2, "Evictions counted");
+
+	cache.reset_stats();
+	test_assert(cache.hits() == 0 && cache.misses() == 0 && cache.evictions() == 0, "reset_stats() clears counters");
+}
+
+void test_eviction_callback()
+{
+	section_header("TEST 4: EVICTION CALLBACK");
+
+	lru_cache<int, std::string> cache(2);
+	std::vector<int> evicted_keys;
+	std::vector<std::string> evicted_values;
+
+	cache.set_eviction_callback([&](const int& key, std::string& value)
+		{
+			evicted_keys.push_back(key);
+			evicted_values.push_back(value);
+		});
+
+	cache.put(1, "a");
+	cache.put(2, "b");
+	cache.put(3, "c");
+	cache.put(4, "d");
+
+	test_assert(evicted_keys.size() == 2, "Callback called for each eviction");
+	test_assert(evicted_keys[0] == 1 && evicted_keys[1] == 2, "Callback receives keys in LRU order");
+	test_assert(evicted_values[0] == "a" && evicted_values[1] == "b", "Callback receives evicted values");
+
+	cache.erase(3);
+	test_assert(evicted_keys.size() == 2, "Explicit erase does not call the callback");
+}
+
+void test_byte_budget()
+{
+	section_header("TEST 5: BYTE BUDGET");
+
+	// nessun limite sul numero di voci, 10 byte di budget misurati sulla stringa
+	lru_cache<int, std::string> cache(0, 10,
+		[](const int&, const std::string& value) { return value.size(); });
+
+	cache.put(1, "aaaa");
+	cache.put(2, "bbbb");
+	test_assert(cache.bytes() == 8, "Bytes tracked by weigher");
+	test_assert(cache.size() == 2, "Both entries fit");
+
+	cache.put(3, "cccc"); // 12 > 10: evince 1
+	test_assert(!cache.contains(1), "Byte budget evicts least recent");
+	test_assert(cache.bytes() == 8, "Bytes updated after eviction");
+
+	cache.put(2, "bb"); // aggiornamento: 2 + 4
+	test_assert(cache.bytes() == 6, "Bytes updated on value replacement");
+
+	cache.put(4, "dddddddddddd"); // piu' grande dell'intero budget
+	test_assert(!cache.contains(4), "Entry larger than the budget is evicted");
+	test_assert(cache.empty() && cache.bytes() == 0, "Budget overflow empties the cache");
+
+	bool thrown = false;
+	try
+	{
+		lru_cache<int, int> invalid(0, 0);
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "Cache without any limit is rejected");
+}
+
+void test_string_keys_and_rehash()
+{
+	section_header("TEST 6: STRING KEYS AND REHASH STABILITY");
+
+	const int N = 1000;
+	lru_cache<std::string, int> cache(N);
+
+	// molti inserimenti forzano diversi rehash della mappa interna
+	for (int i = 0; i < N; i++)
+	{
+		cache.put("key_" + std::to_string(i), i);
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < N; i++)
+	{
+		int* value = cache.get("key_" + std::to_string(i));
+		if (value == nullptr || *value != i)
+		{
+			all_found = false;
+			break;
+		}
+	}
+	test_assert(all_found, "All string keys found after rehash");
+	test_assert(cache.least_recent() == "key_0", "Key pointers still valid after rehash");
+
+	cache.put("overflow", -1);
+	test_assert(!cache.contains("key_0"), "Eviction uses the stored key correctly");
+}
+
+void test_move()
+{
+	section_header("TEST 7: MOVE SEMANTICS");
+
+	lru_cache<int, int> cache(2);
+	cache.put(1, 1);
+	cache.put(2, 2);
+
+	lru_cache<int, int> moved(std::move(cache));
+	test_assert(moved.size() == 2, "Move constructor keeps entries");
+	test_assert(moved.least_recent() == 1, "Move constructor keeps order");
+
+	moved.put(3, 3);
+	test_assert(!moved.contains(1), "Moved cache evicts correctly");
+}
+
+// valore senza costruttore di default la cui copia lancia a comando
+struct FragileValue
+{
+	static bool fail;
+	int value;
+
+	explicit FragileValue(int v) : value(v)
+	{}
+
+	FragileValue(const FragileValue& other) : value(other.value)
+	{
+		if (fail)
+			throw std::runtime_error("copy failed");
+	}
+
+	FragileValue& operator=(const FragileValue& other)
+	{
+		if (fail)
+			throw std::runtime_error("copy failed");
+		value = other.value;
+		return *this;
+	}
+};
+
+bool FragileValue::fail = false;
+
+void test_throwing_values()
+{
+	section_header("TEST 8: THROWING VALUES");
+
+	lru_cache<int, FragileValue> cache(3);
+	cache.put(1, FragileValue(1));
+	cache.put(2, FragileValue(2));
+	size_t bytes = cache.bytes();
+
+	FragileValue::fail = true;
+	bool thrown = false;
+	try
+	{
+		cache.put(3, FragileValue(3));
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown && !cache.contains(3) && cache.size() == 2 && cache.bytes() == bytes,
+		"Failed put of a new key leaves no entry behind");
+
+	thrown = false;
+	try
+	{
+		cache.put(1, FragileValue(10));
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	FragileValue::fail = false;
+	test_assert(thrown && cache.peek(1)->value == 1 && cache.bytes() == bytes, "Failed update keeps the old value");
+
+	cache.put(3, FragileValue(3));
+	cache.put(4, FragileValue(4));
+	test_assert(cache.size() == 3 && !cache.contains(1) && cache.least_recent() == 2 && cache.most_recent() == 4,
+		"Cache keeps working after a failed put");
+}
+
+void test_clock_second_chance()
+{
+	section_header("TEST 9: CLOCK SECOND CHANCE");
+
+	lru_cache<int, int> cache(3);
+	cache.put(1, 1);
+	cache.put(2, 2);
+	cache.put(3, 3);
+
+	const int* touched = cache.touch(1);
+	test_assert(touched != nullptr && *touched == 1, "touch() returns value");
+	test_assert(cache.least_recent() == 1, "touch() does not move the entry");
+	test_assert(cache.touch(99) == nullptr, "touch() returns nullptr on miss");
+
+	cache.put(4, 4); // 1 e' marcato: torna in testa e viene evinto 2
+	test_assert(cache.contains(1), "Referenced entry gets a second chance");
+	test_assert(!cache.contains(2), "Next unreferenced entry is evicted");
+	test_assert(cache.most_recent() == 1, "Second chance moves entry to the front");
+
+	cache.put(5, 5); // il bit di 1 e' stato consumato: ora esce 3
+	test_assert(!cache.contains(3), "Second chance is consumed once");
+}
+
+void test_sharded_basic()
+{
+	section_header("TEST 10: SHARDED CACHE BASICS");
+
+	sharded_lru_cache<int, std::string> cache(64, 4);
+	test_assert(cache.shard_count() == 4, "Shard count as requested");
+
+	sharded_lru_cache<int, int> rounded(64, 5);
+	test_assert(rounded.shard_count() == 8, "Shard count rounded to a power of two");
+
+	cache.put(1, "one");
+	cache.put(2, "two");
+
+	std::string value;
+	test_assert(cache.get(1, value) && value == "one", "get() copies stored value");
+	test_assert(!cache.get(3, value), "get() returns false on miss");
+	test_assert(cache.contains(2), "contains() finds key");
+	test_assert(cache.size() == 2, "Size summed over shards");
+
+	test_assert(cache.erase(2), "erase() removes key");
+	test_assert(!cache.contains(2), "Erased key not contained");
+
+	test_assert(cache.hits() == 1 && cache.misses() == 1, "Hits and misses aggregated");
+
+	cache.clear();
+	test_assert(cache.empty(), "clear() empties all shards");
+}
+
+void test_sharded_distribution()
+{
+	section_header("TEST 11: SHARD DISTRIBUTION AND CAPACITY");
+
+	const int N = 16000;
+	sharded_lru_cache<int, int> cache(N, 16);
+
+	for (int i = 0; i < N; i++)
+		cache.put(i, i);
+
+	size_t min_size = N, max_size = 0;
+	for (size_t s = 0; s < cache.shard_count(); s++)
+	{
+		min_size = std::min(min_size, cache.shard_size(s));
+		max_size = std::max(max_size, cache.shard_size(s));
+	}
+	std::cout << "Shard sizes: min " << min_size << ", max " << max_size << std::endl;
+	test_assert(min_size > 0, "Every shard receives keys");
+	test_assert(cache.size() <= N, "Total size bounded by capacity");
+
+	sharded_lru_cache<int, int> small(8, 2);
+	for (int i = 0; i < 100; i++)
+		small.put(i, i);
+	test_assert(small.size() <= 8, "Per-shard capacity enforced");
+	test_assert(small.evictions() == 100 - small.size(), "Evictions aggregated");
+}
+
+template<typename Cache>
+void run_concurrent_mix(Cache& cache, int threads, int ops_per_thread)
+{
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++)
+	{
+		workers.emplace_back([&cache, t, ops_per_thread]()
+			{
+				std::mt19937 rng(t);
+				int value;
+				for (int i = 0; i < ops_per_thread; i++)
+				{
+					int key = static_cast<int>(rng() % 2000);
+					if (!cache.get(key, value))
+						cache.put(key, key);
+					else if (value != key)
+						std::cout << "[FAIL] wrong value for key " << key << std::endl;
+					if (i % 64 == 0)
+						cache.erase(key);
+				}
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+}
+
+void test_sharded_concurrent()
+{
+	section_header("TEST 12: SHARDED CACHE CONCURRENCY");
+
+	sharded_lru_cache<int, int> lru(1000, 8, ShardPromotion::Lru);
+	run_concurrent_mix(lru, 4, 20000);
+	test_assert(lru.size() <= 1000, "LRU shards: size bounded after concurrent mix");
+	test_assert(lru.hits() + lru.misses() == 4 * 20000, "LRU shards: every lookup counted");
+
+	sharded_lru_cache<int, int> clock(1000, 8, ShardPromotion::Clock);
+	run_concurrent_mix(clock, 4, 20000);
+	test_assert(clock.size() <= 1000, "CLOCK shards: size bounded after concurrent mix");
+	test_assert(clock.hits() + clock.misses() == 4 * 20000, "CLOCK shards: every lookup counted");
+}
+
+// ==================== BENCHMARKS ====================
+
+void benchmark_zipf()
+{
+	section_header("BENCHMARK 1: ZIPFIAN TRACE");
+
+	const size_t KEYS = 100000;
+	const size_t OPS = 1000000;
+
+	std::vector<int> trace;
+	trace.reserve(OPS);
+	zipf_generator zipf(KEYS, 0.99, 42);
+	for (size_t i = 0; i < OPS; i++)
+		trace.push_back(zipf.next());
+
+	std::cout << "\nTrace: " << OPS << " accessi, " << KEYS << " chiavi, Zipf s=0.99" << std::endl;
+	std::cout << "Capacity\tHit ratio\tTime(ms)\tMops/s" << std::endl;
+	std::cout << "--------------------------------------------------------" << std::endl;
+
+	size_t capacities[] = { 100, 1000, 10000, 50000 };
+	for (size_t capacity : capacities)
+	{
+		lru_cache<int, int> cache(capacity);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int key : trace)
+		{
+			if (cache.get(key) == nullptr)
+				cache.put(key, key);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		double mops = ms > 0 ? static_cast<double>(OPS) / ms / 1000.0 : 0.0;
+		std::cout << capacity << "\t\t" << std::fixed << std::setprecision(3) << cache.hit_ratio()
+			<< "\t\t" << ms << "\t\t" << std::setprecision(1) << mops << std::endl;
+	}
+
+	std::cout << "\nNote: con traffico Zipf una cache piccola cattura gia' la maggior parte degli accessi." << std::endl;
+}
+
+// baseline: un solo lru_cache protetto da un unico mutex
+class single_lock_cache
+{
+private:
+	lru_cache<int, int> cache;
+	std::mutex mutex;
+
+public:
+	explicit single_lock_cache(size_t capacity) : cache(capacity)
+	{}
+
+	bool get(const int& key, int& out)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		int* value = cache.get(key);
+		if (value == nullptr)
+			return false;
+		out = *value;
+		return true;
+	}
+
+	void put(const int& key, const int& value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		cache.put(key, value);
+	}
+};
+
+template<typename Cache>
+long long run_zipf_threads(Cache& cache, const std::vector<int>& trace, int threads)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	std::vector<std::thread> workers;
+	size_t chunk = trace.size() / threads;
+	for (int t = 0; t < threads; t++)
+	{
+		workers.emplace_back([&cache, &trace, chunk, t]()
+			{
+				int value;
+				for (size_t i = t * chunk; i < (t + 1) * chunk; i++)
+				{
+					int key = trace[i];
+					if (!cache.get(key, value))
+						cache.put(key, key);
+				}
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+void benchmark_multithreaded()
+{
+	section_header("BENCHMARK 2: MULTI-THREADED THROUGHPUT");
+
+	const size_t KEYS = 100000;
+	const size_t OPS = 2000000;
+	const size_t CAPACITY = 10000;
+
+	std::vector<int> trace;
+	trace.reserve(OPS);
+	zipf_generator zipf(KEYS, 0.99, 7);
+	for (size_t i = 0; i < OPS; i++)
+		trace.push_back(zipf.next());
+
+	std::cout << "\nTrace Zipf: " << OPS << " accessi totali, capacity " << CAPACITY
+		<< ", hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << "Threads\tSingle lock(ms)\tShard LRU(ms)\tShard CLOCK(ms)" << std::endl;
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	int thread_counts[] = { 1, 2, 4, 8 };
+	for (int threads : thread_counts)
+	{
+		single_lock_cache single(CAPACITY);
+		sharded_lru_cache<int, int> sharded_lru(CAPACITY, 16, ShardPromotion::Lru);
+		sharded_lru_cache<int, int> sharded_clock(CAPACITY, 16, ShardPromotion::Clock);
+
+		long long single_ms = run_zipf_threads(single, trace, threads);
+		long long lru_ms = run_zipf_threads(sharded_lru, trace, threads);
+		long long clock_ms = run_zipf_threads(sharded_clock, trace, threads);
+
+		std::cout << threads << "\t" << single_ms << "\t\t" << lru_ms << "\t\t" << clock_ms << std::endl;
+	}
+
+	std::cout << "\nNote: il lock singolo serializza tutti i thread; gli shard dividono la contesa" << std::endl;
+	std::cout << "      e CLOCK permette lookup paralleli anche sullo stesso shard (chiavi calde)." << std::endl;
+}
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	lru_cache<int, std::string> cache(3);
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.put(3, "three");
+	cache.print_structure();
+
+	std::cout << "get(1)..." << std::endl;
+	cache.get(1);
+	cache.print_structure();
+
+	std::cout << "put(4) -> evince il meno recente..." << std::endl;
+	cache.put(4, "four");
+	cache.print_structure();
+}
+
+// ==================== MAIN ====================
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   LRU_CACHE TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_lru_order();
+	test_counters();
+	test_eviction_callback();
+	test_byte_budget();
+	test_string_keys_and_rehash();
+	test_move();
+	test_throwing_values();
+	test_clock_second_chance();
+	test_sharded_basic();
+	test_sharded_distribution();
+	test_sharded_concurrent();
+
+	g_stats.print_summary();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "         PERFORMANCE BENCHMARKS" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	benchmark_zipf();
+	benchmark_multithreaded();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}
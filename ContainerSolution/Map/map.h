@@ -1,7 +1,21 @@
 #pragma once
 
 #include <utility>
+#include <tuple>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <memory>
+#include <cstdint>
+#include "node_arena.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
 
 namespace STDev
 {
@@ -30,126 +44,454 @@ namespace STDev
 		AdelsonVelskyLandisTree
 	};
 
-	template<typename K, typename T, TreeType Type = TreeType::RedBlackTree>
+	// Policy di aumento: dati extra in ogni nodo, ricalcolati dai figli con update(node)
+	// lungo il percorso di insert ed erase e nei due nodi di ogni rotazione.
+	// node_data e' una base del nodo: con NoAugment e' vuota e non occupa spazio.
+	// Una policy propria serve solo di node_data<K, T>, update(node) e check(node)
+	struct NoAugment
+	{
+		template<typename K, typename T>
+		struct node_data {};
+
+		template<typename Node>
+		static void update(Node*) {}
+
+		template<typename Node>
+		static bool check(const Node*) { return true; }
+	};
+
+	// dimensione di ogni sottoalbero: nth, rank e count_in_range in O(log n)
+	struct OrderStatistic
+	{
+		template<typename K, typename T>
+		struct node_data
+		{
+			size_t subtree_size = 1;
+		};
+
+		template<typename Node>
+		static size_t size(const Node* node)
+		{
+			return node != nullptr ? node->subtree_size : 0;
+		}
+
+		template<typename Node>
+		static void update(Node* node)
+		{
+			node->subtree_size = 1 + size(node->left) + size(node->right);
+		}
+
+		template<typename Node>
+		static bool check(const Node* node)
+		{
+			return node->subtree_size == 1 + size(node->left) + size(node->right);
+		}
+	};
+
+	// interval tree: la chiave e' l'inizio e il valore la fine di [key, value).
+	// Ogni nodo tiene la fine massima del sottoalbero, confrontata con operator<
+	struct IntervalTree
+	{
+		template<typename K, typename T>
+		struct node_data
+		{
+			T max_end{};
+		};
+
+		template<typename Node>
+		static auto max_end(const Node* node)
+		{
+			auto result = node->data.second;
+			if (node->left != nullptr && result < node->left->max_end)
+				result = node->left->max_end;
+			if (node->right != nullptr && result < node->right->max_end)
+				result = node->right->max_end;
+			return result;
+		}
+
+		template<typename Node>
+		static void update(Node* node)
+		{
+			node->max_end = max_end(node);
+		}
+
+		template<typename Node>
+		static bool check(const Node* node)
+		{
+			return !(node->max_end < max_end(node)) && !(max_end(node) < node->max_end);
+		}
+	};
+
+	// somma dei valori di ogni sottoalbero: prefix_sum e range_sum in O(log n)
+	struct PrefixSum
+	{
+		template<typename K, typename T>
+		struct node_data
+		{
+			T subtree_sum{};
+		};
+
+		template<typename Node>
+		static auto sum(const Node* node)
+		{
+			auto result = node->data.second;
+			if (node->left != nullptr)
+				result += node->left->subtree_sum;
+			if (node->right != nullptr)
+				result += node->right->subtree_sum;
+			return result;
+		}
+
+		template<typename Node>
+		static void update(Node* node)
+		{
+			node->subtree_sum = sum(node);
+		}
+
+		template<typename Node>
+		static bool check(const Node* node)
+		{
+			return node->subtree_sum == sum(node);
+		}
+	};
+
+	// Compare: ordinamento stretto delle chiavi (default std::less<K>). Con un comparatore
+	// trasparente (std::less<>) find, contains, at e i bound accettano qualsiasi tipo
+	// confrontabile con K, ad esempio std::string_view o const char* per map<std::string, T>
+	// Augment: NoAugment oppure una policy con dati per sottoalbero (OrderStatistic, IntervalTree, PrefixSum)
+	// Allocator: std::allocator di default; arena_allocator alloca i nodi a slab e libera l'albero in blocco
+	template<typename K, typename T, TreeType Type = TreeType::RedBlackTree, typename Compare = std::less<K>,
+		typename Augment = NoAugment, typename Allocator = std::allocator<std::pair<const K, T>>>
 	class map
 	{
 	private:
 
-		enum NodeColor { NONE, RED, BLACK };
+		static constexpr bool is_augmented = !std::is_same<Augment, NoAugment>::value;
+
+		// il colore sta nel bit basso del parent: RED = 0, cosi' un nodo nuovo nasce rosso
+		enum NodeColor { RED = 0, BLACK = 1 };
 
 		typedef std::pair<const K, T> value_type;
 
-		struct Node
+		template<typename Base>
+		struct WithHeight : Base
+		{
+			int height = 1; // altezza del sottoalbero (foglia = 1)
+		};
+
+		// height esiste solo nell'AdelsonVelskyLandisTree: map<int, int> RB-Tree = 32 byte per nodo
+		typedef typename Augment::template node_data<K, T> AugmentData;
+		typedef typename std::conditional<Type == TreeType::AdelsonVelskyLandisTree, WithHeight<AugmentData>, AugmentData>::type NodeBase;
+
+		struct Node : NodeBase
 		{
 			value_type data;
 			Node* left;
 			Node* right;
-			Node* parent;
-			NodeColor color;
+			std::uintptr_t parent_and_color; // parent con il colore nel bit basso (nodi allineati ad almeno 2 byte)
 
-			Node(const K& key, const T& value)
-				: data{ key, value }, left{ nullptr }, right{ nullptr }, parent{ nullptr }, color{ NodeColor::NONE }
+			// il valore viene costruito direttamente nel nodo a partire da args
+			template<typename... Args>
+			Node(const K& key, Args&&... args)
+				: data(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)),
+				left{ nullptr }, right{ nullptr }, parent_and_color{ 0 }
 			{}
+
+			Node* parent() const
+			{
+				return reinterpret_cast<Node*>(parent_and_color & ~std::uintptr_t(1));
+			}
+
+			void set_parent(Node* node)
+			{
+				parent_and_color = reinterpret_cast<std::uintptr_t>(node) | (parent_and_color & 1);
+			}
+
+			NodeColor color() const
+			{
+				return static_cast<NodeColor>(parent_and_color & 1);
+			}
+
+			void set_color(NodeColor color)
+			{
+				parent_and_color = (parent_and_color & ~std::uintptr_t(1)) | color;
+			}
 		};
 
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+		typedef std::allocator_traits<NodeAllocator> NodeAllocTraits;
+
 		Node* root;
+		Node* leftmost;  // minimo: begin() in O(1)
+		Node* rightmost; // massimo: --end() e append in coda in O(1)
 		size_t _size; //numero di nodi
+		Compare comp;
+		NodeAllocator node_alloc;
 
-		Node* insert_node(const K& key, const T& value)
+		template<typename... Args>
+		Node* create_node(const K& key, Args&&... args)
 		{
-			Node* parentNode = nullptr;
+			Node* node = NodeAllocTraits::allocate(node_alloc, 1);
+			try
+			{
+				NodeAllocTraits::construct(node_alloc, node, key, std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				NodeAllocTraits::deallocate(node_alloc, node, 1);
+				throw;
+			}
+			return node;
+		}
+
+		void destroy_node(Node* node)
+		{
+			NodeAllocTraits::destroy(node_alloc, node);
+			NodeAllocTraits::deallocate(node_alloc, node, 1);
+		}
+
+		// Discesa unica per tutte le operazioni di inserimento: ritorna il nodo con la chiave
+		// se esiste, altrimenti nullptr e in parentNode/goLeft il punto dove agganciarla.
+		// Un solo confronto per livello: candidate e' l'ultimo nodo con chiave <= key,
+		// l'uguaglianza si controlla una volta sola in fondo alla discesa
+		Node* find_insert_position(const K& key, Node*& parentNode, bool& goLeft) const
+		{
+			parentNode = nullptr;
+			goLeft = false;
+
+			// chiave oltre il massimo (chiavi crescenti, timestamp): si aggancia in coda senza discesa
+			if (rightmost != nullptr && comp(rightmost->data.first, key))
+			{
+				parentNode = rightmost;
+				return nullptr;
+			}
+
+			Node* candidate = nullptr;
 			Node* currentNode = root;
 
 			//serve a trovare il parent corretto, se nullptr  devo costruire la root e non ciclo
 			while (currentNode != nullptr)
 			{
 				parentNode = currentNode;
-				if (key < currentNode->data.first)
+				goLeft = comp(key, currentNode->data.first);
+				if (goLeft)
 				{
 					currentNode = currentNode->left;
 				}
-				else if (key > currentNode->data.first)
+				else
 				{
+					candidate = currentNode;
 					currentNode = currentNode->right;
 				}
-				else //per sovrascrivere l'attuale nodo con un nuovo valore, non creo un nuovo nodo
+			}
+
+			if (candidate != nullptr && !comp(candidate->data.first, key))
+				return candidate;
+
+			return nullptr;
+		}
+
+		// come find_insert_position, ma prima prova la posizione accanto a hint: se key cade
+		// tra il predecessore e hint (o tra hint e il successore) il punto di aggancio e' uno
+		// dei due, senza discesa dalla radice. Altrimenti ricade sulla ricerca normale
+		Node* find_hint_position(const Node* hint, const K& key, Node*& parentNode, bool& goLeft) const
+		{
+			Node* position = const_cast<Node*>(hint);
+
+			if (position == nullptr) // end(): inserimento in coda
+			{
+				return find_insert_position(key, parentNode, goLeft);
+			}
+
+			if (comp(key, position->data.first))
+			{
+				Node* before = position == leftmost ? nullptr : previous_node(position);
+				if (before == nullptr || comp(before->data.first, key))
+				{
+					// se position ha un figlio sinistro, before e' il suo massimo e non ha figlio destro
+					parentNode = position->left == nullptr ? position : before;
+					goLeft = position->left == nullptr;
+					return nullptr;
+				}
+			}
+			else if (comp(position->data.first, key))
+			{
+				Node* after = position == rightmost ? nullptr : next_node(position);
+				if (after == nullptr || comp(key, after->data.first))
 				{
-					currentNode->data.second = value;
-					return currentNode;
+					parentNode = position->right == nullptr ? position : after;
+					goLeft = position->right != nullptr;
+					return nullptr;
 				}
 			}
+			else
+			{
+				return position;
+			}
 
-			Node* newNode = new Node(key, value);
+			return find_insert_position(key, parentNode, goLeft);
+		}
+
+		// ricalcola i dati della policy da node fino alla radice (niente senza policy)
+		static void refresh_path(Node* node)
+		{
+			if constexpr (is_augmented)
+			{
+				for (; node != nullptr; node = node->parent())
+					Augment::update(node);
+			}
+		}
 
-			newNode->parent = parentNode;
+		// aggancia un nodo nuovo nel punto trovato da find_insert_position e ribilancia
+		void link_new_node(Node* newNode, Node* parentNode, bool goLeft)
+		{
+			newNode->set_parent(parentNode);
 			if (parentNode == nullptr)
 			{
 				root = newNode;
+				leftmost = rightmost = newNode;
 			}
-			else if (newNode->data.first < parentNode->data.first)
+			else if (goLeft)
 			{
 				parentNode->left = newNode;
+				if (parentNode == leftmost)
+					leftmost = newNode;
 			}
 			else
 			{
 				parentNode->right = newNode;
+				if (parentNode == rightmost)
+					rightmost = newNode;
 			}
 			++_size;
 
-			return newNode;
+			// prima delle rotazioni: ruotando si ricalcolano solo i due nodi coinvolti
+			refresh_path(newNode);
+
+			if constexpr (Type == TreeType::RedBlackTree) // fixup only for RBT
+			{
+				insert_fixup(newNode);
+			}
+			else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+			{
+				avl_rebalance(parentNode);
+			}
 		}
 
-		void insert_fixup(Node* newInsertedNode)
+		// ritorna true se il rosso e' risalito fino alla radice: la black-height cresce di uno
+		bool insert_fixup(Node* newInsertedNode)
 		{
-			newInsertedNode->color = NodeColor::RED;
-			while (newInsertedNode->parent != nullptr && newInsertedNode->parent->color == NodeColor::RED) //continuo il ciclo solo se il parent  rosso
+			newInsertedNode->set_color(NodeColor::RED);
+			while (newInsertedNode->parent() != nullptr && newInsertedNode->parent()->color() == NodeColor::RED) //continuo il ciclo solo se il parent  rosso
 			{
-				if (newInsertedNode->parent == newInsertedNode->parent->parent->left) //accesso sicuro perch parent  rosso
+				if (newInsertedNode->parent() == newInsertedNode->parent()->parent()->left) //accesso sicuro perch parent  rosso
 				{
-					Node* uncleNode = newInsertedNode->parent->parent->right;
-					if (uncleNode != nullptr && uncleNode->color == NodeColor::RED)
+					Node* uncleNode = newInsertedNode->parent()->parent()->right;
+					if (uncleNode != nullptr && uncleNode->color() == NodeColor::RED)
 					{
-						newInsertedNode->parent->color = NodeColor::BLACK;
-						uncleNode->color = NodeColor::BLACK;
-						newInsertedNode->parent->parent->color = NodeColor::RED;
-						newInsertedNode = newInsertedNode->parent->parent;
+						newInsertedNode->parent()->set_color(NodeColor::BLACK);
+						uncleNode->set_color(NodeColor::BLACK);
+						newInsertedNode->parent()->parent()->set_color(NodeColor::RED);
+						newInsertedNode = newInsertedNode->parent()->parent();
 					}
 					else
 					{
-						if (newInsertedNode == newInsertedNode->parent->right)
+						if (newInsertedNode == newInsertedNode->parent()->right)
 						{
-							newInsertedNode = newInsertedNode->parent;
+							newInsertedNode = newInsertedNode->parent();
 							rotate_left(newInsertedNode);
 						}
-						newInsertedNode->parent->color = NodeColor::BLACK;
-						newInsertedNode->parent->parent->color = NodeColor::RED;
-						rotate_right(newInsertedNode->parent->parent);
+						newInsertedNode->parent()->set_color(NodeColor::BLACK);
+						newInsertedNode->parent()->parent()->set_color(NodeColor::RED);
+						rotate_right(newInsertedNode->parent()->parent());
 					}
 				}
 				else
 				{
-					Node* y = newInsertedNode->parent->parent->left;
-					if (y != nullptr && y->color == NodeColor::RED)
+					Node* y = newInsertedNode->parent()->parent()->left;
+					if (y != nullptr && y->color() == NodeColor::RED)
 					{
-						newInsertedNode->parent->color = NodeColor::BLACK;
-						y->color = NodeColor::BLACK;
-						newInsertedNode->parent->parent->color = NodeColor::RED;
-						newInsertedNode = newInsertedNode->parent->parent;
+						newInsertedNode->parent()->set_color(NodeColor::BLACK);
+						y->set_color(NodeColor::BLACK);
+						newInsertedNode->parent()->parent()->set_color(NodeColor::RED);
+						newInsertedNode = newInsertedNode->parent()->parent();
 					}
 					else
 					{
-						if (newInsertedNode == newInsertedNode->parent->left)
+						if (newInsertedNode == newInsertedNode->parent()->left)
 						{
-							newInsertedNode = newInsertedNode->parent;
+							newInsertedNode = newInsertedNode->parent();
 							rotate_right(newInsertedNode);
 						}
-						newInsertedNode->parent->color = NodeColor::BLACK;
-						newInsertedNode->parent->parent->color = NodeColor::RED;
-						rotate_left(newInsertedNode->parent->parent);
+						newInsertedNode->parent()->set_color(NodeColor::BLACK);
+						newInsertedNode->parent()->parent()->set_color(NodeColor::RED);
+						rotate_left(newInsertedNode->parent()->parent());
+					}
+				}
+			}
+			bool grew = root->color() == NodeColor::RED;
+			root->set_color(NodeColor::BLACK);
+			return grew;
+		}
+
+		static int node_height(const Node* node)
+		{
+			return node != nullptr ? node->height : 0;
+		}
+
+		static int balance_factor(const Node* node)
+		{
+			return node_height(node->left) - node_height(node->right);
+		}
+
+		static void update_height(Node* node)
+		{
+			node->height = 1 + std::max(node_height(node->left), node_height(node->right));
+		}
+
+		// risale da node alla radice aggiornando le altezze e ruotando dove |bf| > 1.
+		// Si ferma appena un sottoalbero non cambia altezza: gli antenati sono gia' corretti.
+		void avl_rebalance(Node* node)
+		{
+			while (node != nullptr)
+			{
+				int old_height = node->height;
+				update_height(node);
+				int balance = balance_factor(node);
+
+				if (balance > 1)
+				{
+					if (balance_factor(node->left) < 0) // caso sinistra-destra
+					{
+						rotate_left(node->left);
+						update_height(node->left->left);
+						update_height(node->left);
+					}
+					rotate_right(node);
+					update_height(node);
+					node = node->parent(); // nuova radice del sottoalbero
+					update_height(node);
+				}
+				else if (balance < -1)
+				{
+					if (balance_factor(node->right) > 0) // caso destra-sinistra
+					{
+						rotate_right(node->right);
+						update_height(node->right->right);
+						update_height(node->right);
 					}
+					rotate_left(node);
+					update_height(node);
+					node = node->parent();
+					update_height(node);
+				}
+				else if (node->height == old_height)
+				{
+					break;
 				}
+
+				node = node->parent();
 			}
-			root->color = NodeColor::BLACK;
 		}
 
 		void rotate_left(Node* node)
@@ -159,26 +501,32 @@ namespace STDev
 
 			if (childDx->left != nullptr)
 			{
-				childDx->left->parent = node;
+				childDx->left->set_parent(node);
 			}
 
-			childDx->parent = node->parent;
+			childDx->set_parent(node->parent());
 
-			if (node->parent == nullptr)
+			if (node->parent() == nullptr)
 			{
 				root = childDx;
 			}
-			else if (node == node->parent->left)
+			else if (node == node->parent()->left)
 			{
-				node->parent->left = childDx;
+				node->parent()->left = childDx;
 			}
 			else
 			{
-				node->parent->right = childDx;
+				node->parent()->right = childDx;
 			}
 
 			childDx->left = node;
-			node->parent = childDx;
+			node->set_parent(childDx);
+
+			if constexpr (is_augmented)
+			{
+				Augment::update(node);
+				Augment::update(childDx);
+			}
 		}
 
 		void rotate_right(Node* node)
@@ -187,249 +535,493 @@ namespace STDev
 			node->left = childSx->right;
 			if (childSx->right != nullptr)
 			{
-				childSx->right->parent = node;
+				childSx->right->set_parent(node);
 			}
 
-			childSx->parent = node->parent;
+			childSx->set_parent(node->parent());
 
-			if (node->parent == nullptr)
+			if (node->parent() == nullptr)
 			{
 				root = childSx;
 			}
-			else if (node == node->parent->left)
+			else if (node == node->parent()->left)
 			{
-				node->parent->left = childSx;
+				node->parent()->left = childSx;
 			}
 			else
 			{
-				node->parent->right = childSx;
+				node->parent()->right = childSx;
 			}
 
 			childSx->right = node;
-			node->parent = childSx;
+			node->set_parent(childSx);
+
+			if constexpr (is_augmented)
+			{
+				Augment::update(node);
+				Augment::update(childSx);
+			}
 		}
 
 
-		Node* find_helper(Node* node, const K& key) const
+		// stessa discesa di find_insert_position; KeyLike e' K o un tipo confrontabile
+		// tramite un comparatore trasparente
+		template<typename KeyLike>
+		Node* find_helper(Node* node, const KeyLike& key) const
 		{
+			Node* candidate = nullptr;
 			while (node != nullptr)
 			{
-				if (key < node->data.first)
+				if (comp(key, node->data.first))
 				{
 					node = node->left;
 				}
-				else if (key > node->data.first)
-				{
-					node = node->right;
-				}
 				else
 				{
-					return node;
+					candidate = node;
+					node = node->right;
 				}
 			}
+
+			if (candidate != nullptr && !comp(candidate->data.first, key))
+				return candidate;
+
 			return nullptr;
 		}
 
-		Node* copy_helper(Node* node)
-		{
-			if (!node)
-				return nullptr;
+		// discese intrecciate da find_batch
+		static constexpr size_t BATCH_LANES = 16;
 
-			Node* new_node = new Node(node->data.first, node->data.second);
+		static void prefetch(const void* address)
+		{
+#if defined(_MSC_VER)
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+			__builtin_prefetch(address);
+#endif
+		}
 
-			if constexpr (Type == TreeType::RedBlackTree)
+		// find_helper su BATCH_LANES chiavi alla volta: le discese avanzano di un livello per giro
+		// e ognuna chiede in anticipo (prefetch) il nodo che leggera' al giro successivo. Mentre
+		// quel nodo arriva dalla memoria lavorano le altre discese, cosi' i cache miss di chiavi
+		// diverse si sovrappongono invece di essere pagati uno dopo l'altro.
+		// sink(i, node) riceve il nodo con la chiave keys[i], nullptr se non c'e'
+		template<typename KeyLike, typename Sink>
+		void find_batch_helper(const KeyLike* keys, size_t count, Sink sink) const
+		{
+			Node* nodes[BATCH_LANES];
+			Node* candidates[BATCH_LANES];
+			for (size_t first = 0; first < count; first += BATCH_LANES)
 			{
-				new_node->color = node->color;
-			}
+				size_t group = std::min(BATCH_LANES, count - first);
+				for (size_t lane = 0; lane < group; lane++)
+				{
+					nodes[lane] = root;
+					candidates[lane] = nullptr;
+				}
+
+				bool active = root != nullptr;
+				while (active)
+				{
+					active = false;
+					for (size_t lane = 0; lane < group; lane++)
+					{
+						Node* node = nodes[lane];
+						if (node == nullptr)
+							continue;
 
-			new_node->left = copy_helper(node->left);
-			new_node->right = copy_helper(node->right);
+						if (comp(keys[first + lane], node->data.first))
+						{
+							node = node->left;
+						}
+						else
+						{
+							candidates[lane] = node;
+							node = node->right;
+						}
 
-			if (new_node->left)
-			{
-				new_node->left->parent = new_node;
+						if (node != nullptr)
+						{
+							prefetch(node);
+							active = true;
+						}
+						nodes[lane] = node;
+					}
+				}
+
+				for (size_t lane = 0; lane < group; lane++)
+				{
+					Node* candidate = candidates[lane];
+					bool found = candidate != nullptr && !comp(candidate->data.first, keys[first + lane]);
+					sink(first + lane, found ? candidate : nullptr);
+				}
 			}
+		}
 
-			if (new_node->right)
+		// primo nodo con chiave >= key (> key se strict), nullptr se non esiste.
+		// Una sola discesa: ogni nodo troppo piccolo scarta il suo sottoalbero sinistro
+		template<typename KeyLike>
+		Node* bound_node(const KeyLike& key, bool strict) const
+		{
+			Node* result = nullptr;
+			Node* node = root;
+			while (node != nullptr)
 			{
-				new_node->right->parent = new_node;
+				bool goes_left = strict ? comp(key, node->data.first) : !comp(node->data.first, key);
+				if (goes_left)
+				{
+					result = node;
+					node = node->left;
+				}
+				else
+				{
+					node = node->right;
+				}
 			}
-
-			return new_node;
+			return result;
 		}
 
-		Node* erase_helper(Node* node, const K& key, bool& erased)
+		// discesa per posizione: il sottoalbero sinistro dice quante chiavi precedono il nodo
+		Node* nth_node(size_t k) const
 		{
-			if (!node)
-				return nullptr;
+			static_assert(std::is_same<Augment, OrderStatistic>::value, "map::nth requires the OrderStatistic policy");
 
-			if (key < node->data.first)
-			{
-				node->left = erase_helper(node->left, key, erased);
-			}
-			else if (key > node->data.first)
-			{
-				node->right = erase_helper(node->right, key, erased);
-			}
-			else
+			Node* node = root;
+			while (node != nullptr)
 			{
-				erased = true;
-				_size--;
-
-				// Caso 1: Nodo foglia (senza figli)
-				if (!node->left && !node->right)
-				{
-					delete node;
-					return nullptr;
-				}
-				// Caso 2: Nodo con un solo figlio (destro)
-				else if (!node->left)
+				size_t left_size = OrderStatistic::size(node->left);
+				if (k < left_size)
 				{
-					Node* temp = node->right;
-					delete node;
-					return temp;
+					node = node->left;
 				}
-				// Caso 3: Nodo con un solo figlio (sinistro)
-				else if (!node->right)
+				else if (k == left_size)
 				{
-					Node* temp = node->left;
-					delete node;
-					return temp;
+					return node;
 				}
-				// Caso 4: Nodo con due figli
 				else
 				{
-					// Trova il successore in-order (minimo del sottoalbero destro)
-					Node* successor = find_min(node->right);
-
-					// Copia i dati del successore nel nodo corrente
-					// Nota: dobbiamo fare un cast per modificare la chiave const
-					const_cast<K&>(node->data.first) = successor->data.first;
-					node->data.second = successor->data.second;
-
-					// Elimina il successore
-					node->right = erase_helper(node->right, successor->data.first, erased);
-					_size++; // Compensiamo perch verr decrementato di nuovo
+					k -= left_size + 1;
+					node = node->right;
 				}
 			}
-			return node;
+			return nullptr;
 		}
 
-		void transplant(Node* u, Node* v)
+		template<typename NodePtr, typename Func>
+		void overlapping_helper(NodePtr node, const K& lo, const K& hi, Func& func) const
 		{
-			if (u->parent == nullptr)
-				root = v;
-			else if (u == u->parent->left)
-				u->parent->left = v;
-			else
-				u->parent->right = v;
+			static_assert(std::is_same<Augment, IntervalTree>::value, "map::overlapping requires the IntervalTree policy");
 
-			if (v != nullptr)
-				v->parent = u->parent;
-		}
-
-		Node* delete_node_rb(const K& key, bool& erased)
-		{
-			Node* z = find_helper(root, key);
-			if (!z)
+			// un sottoalbero con max_end <= lo non contiene sovrapposizioni
+			while (node != nullptr && lo < node->max_end)
 			{
-				erased = false;
-				return root;
+				overlapping_helper(node->left, lo, hi, func);
+
+				if (!comp(node->data.first, hi))
+					return;
+
+				if (lo < node->data.second)
+					func(node->data);
+
+				node = node->right; // ricorsione solo a sinistra: la destra e' un ciclo
 			}
+		}
 
-			erased = true;
-			_size--;
+		// costruisce in ordine i prossimi n nodi da it: sottoalberi di n/2 e n - n/2 - 1 nodi,
+		// quindi le foglie stanno tutte sugli ultimi due livelli. Nel RB-Tree i nodi del livello
+		// piu' profondo (max_depth) sono rossi e tutti gli altri neri: stessa black-height ovunque
+		template<typename ForwardIt>
+		Node* build_sorted(ForwardIt& it, size_t n, int depth, int max_depth)
+		{
+			if (n == 0)
+				return nullptr;
 
-			Node* y = z;
-			Node* x;
-			Node* x_parent;
-			NodeColor y_original_color = y->color;
+			size_t left_count = n / 2;
+			Node* left = build_sorted(it, left_count, depth + 1, max_depth);
 
-			if (z->left == nullptr)
+			Node* node = nullptr;
+			try
 			{
-				x = z->right;
-				x_parent = z->parent;
-				transplant(z, z->right);
+				node = create_node(it->first, it->second);
+				node->left = left;
+				if (left)
+					left->set_parent(node);
+				++it;
+				node->right = build_sorted(it, n - left_count - 1, depth + 1, max_depth);
 			}
-			else if (z->right == nullptr)
+			catch (...)
 			{
-				x = z->left;
-				x_parent = z->parent;
-				transplant(z, z->left);
+				// i nodi gia' costruiti non sono ancora raggiungibili da root
+				destroy_helper(node != nullptr ? node : left);
+				throw;
 			}
-			else
-			{
-				y = find_min(z->right);
-				y_original_color = y->color;
-				x = y->right;
 
-				if (y->parent == z)
-				{
-					x_parent = y;
-				}
-				else
-				{
-					x_parent = y->parent;
-					transplant(y, y->right);
-					y->right = z->right;
-					y->right->parent = y;
-				}
+			if (node->right)
+				node->right->set_parent(node);
 
-				transplant(z, y);
-				y->left = z->left;
-				y->left->parent = y;
-				y->color = z->color;
+			if constexpr (Type == TreeType::RedBlackTree)
+			{
+				node->set_color((depth == max_depth && depth > 0) ? RED : BLACK);
+			}
+			else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+			{
+				update_height(node);
 			}
 
-			delete z;
+			if constexpr (is_augmented)
+			{
+				Augment::update(node);
+			}
+
+			return node;
+		}
+
+		// copia iterativa in pre-ordine: src e dst scendono insieme e risalgono con i parent,
+		// nessuna ricorsione anche su un BST degenere. Colore, altezza e dati della policy
+		// vengono copiati dal nodo sorgente invece di essere ricalcolati. Con arena_allocator
+		// gli n nodi vengono riservati in un unico slab prima della visita; con std::allocator
+		// (o un altro allocator) restano n allocazioni separate, perche' il tipo dell'allocator
+		// e' scelto dall'utente. Per map copiate spesso (snapshot) conviene arena_allocator
+		Node* copy_tree(const Node* source, size_t count)
+		{
+			if (source == nullptr)
+				return nullptr;
+
+			if constexpr (is_arena_allocator<NodeAllocator>::value)
+			{
+				node_alloc.reserve(count);
+			}
+
+			Node* copy = clone_node(source);
+			const Node* src = source;
+			Node* dst = copy;
+
+			try
+			{
+				while (true)
+				{
+					if (src->left != nullptr && dst->left == nullptr)
+					{
+						dst->left = clone_node(src->left);
+						dst->left->set_parent(dst);
+						src = src->left;
+						dst = dst->left;
+					}
+					else if (src->right != nullptr && dst->right == nullptr)
+					{
+						dst->right = clone_node(src->right);
+						dst->right->set_parent(dst);
+						src = src->right;
+						dst = dst->right;
+					}
+					else if (src == source)
+					{
+						break;
+					}
+					else
+					{
+						src = src->parent();
+						dst = dst->parent();
+					}
+				}
+			}
+			catch (...)
+			{
+				destroy_helper(copy); // la copia parziale e' comunque un albero ben formato
+				throw;
+			}
+
+			return copy;
+		}
+
+		Node* clone_node(const Node* node)
+		{
+			Node* new_node = create_node(node->data.first, node->data.second);
+			static_cast<NodeBase&>(*new_node) = static_cast<const NodeBase&>(*node);
+			new_node->set_color(node->color());
+			return new_node;
+		}
+
+		void transplant(Node* u, Node* v)
+		{
+			if (u->parent() == nullptr)
+				root = v;
+			else if (u == u->parent()->left)
+				u->parent()->left = v;
+			else
+				u->parent()->right = v;
+
+			if (v != nullptr)
+				v->set_parent(u->parent());
+		}
+
+		void delete_node_rb(Node* z)
+		{
+			Node* y = z;
+			Node* x;
+			Node* x_parent;
+			NodeColor y_original_color = y->color();
+
+			if (z->left == nullptr)
+			{
+				x = z->right;
+				x_parent = z->parent();
+				transplant(z, z->right);
+			}
+			else if (z->right == nullptr)
+			{
+				x = z->left;
+				x_parent = z->parent();
+				transplant(z, z->left);
+			}
+			else
+			{
+				y = find_min(z->right);
+				y_original_color = y->color();
+				x = y->right;
+
+				if (y->parent() == z)
+				{
+					x_parent = y;
+				}
+				else
+				{
+					x_parent = y->parent();
+					transplant(y, y->right);
+					y->right = z->right;
+					y->right->set_parent(y);
+				}
+
+				transplant(z, y);
+				y->left = z->left;
+				y->left->set_parent(y);
+				y->set_color(z->color());
+			}
+
+			refresh_path(x_parent);
 
 			if (y_original_color == BLACK)
 				delete_fixup(x, x_parent);
+		}
+
+		// come delete_node_rb ma senza colori (BinarySearchTree e AdelsonVelskyLandisTree).
+		// Ritorna il nodo da cui ribilanciare: il padre del nodo fisicamente rimosso,
+		// o il successore se ha preso il posto di z
+		Node* detach_node(Node* z)
+		{
+			Node* rebalance_from;
+
+			if (z->left == nullptr)
+			{
+				rebalance_from = z->parent();
+				transplant(z, z->right);
+			}
+			else if (z->right == nullptr)
+			{
+				rebalance_from = z->parent();
+				transplant(z, z->left);
+			}
+			else
+			{
+				Node* y = find_min(z->right);
+
+				if (y->parent() == z)
+				{
+					rebalance_from = y;
+				}
+				else
+				{
+					rebalance_from = y->parent();
+					transplant(y, y->right);
+					y->right = z->right;
+					y->right->set_parent(y);
+				}
+
+				transplant(z, y);
+				y->left = z->left;
+				y->left->set_parent(y);
+				if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+				{
+					y->height = z->height;
+				}
+			}
 
-			return root;
+			return rebalance_from;
+		}
+
+		// stacca z dall'albero e ribilancia, senza distruggerlo (erase_node, join).
+		// I nodi vengono ricollegati, mai copiati: gli iteratori agli altri elementi restano validi
+		void unlink_node(Node* z)
+		{
+			if (z == leftmost)
+				leftmost = next_node(z);
+			if (z == rightmost)
+				rightmost = previous_node(z);
+			_size--;
+
+			if constexpr (Type == TreeType::RedBlackTree)
+			{
+				delete_node_rb(z);
+			}
+			else
+			{
+				Node* rebalance_from = detach_node(z);
+				refresh_path(rebalance_from);
+
+				if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+				{
+					avl_rebalance(rebalance_from);
+				}
+			}
+		}
+
+		void erase_node(Node* z)
+		{
+			unlink_node(z);
+			destroy_node(z);
 		}
 
 		void delete_fixup(Node* x, Node* x_parent)
 		{
-			while (x != root && (x == nullptr || x->color == BLACK))
+			while (x != root && (x == nullptr || x->color() == BLACK))
 			{
 				if (x == x_parent->left)
 				{
 					Node* w = x_parent->right; // fratello
 
-					if (w->color == RED)
+					if (w->color() == RED)
 					{
 						// Caso 1: fratello rosso
-						w->color = BLACK;
-						x_parent->color = RED;
+						w->set_color(BLACK);
+						x_parent->set_color(RED);
 						rotate_left(x_parent);
 						w = x_parent->right;
 					}
 
-					if ((w->left == nullptr || w->left->color == BLACK) &&
-						(w->right == nullptr || w->right->color == BLACK))
+					if ((w->left == nullptr || w->left->color() == BLACK) &&
+						(w->right == nullptr || w->right->color() == BLACK))
 					{
 						// Caso 2: fratello nero con figli neri
-						w->color = RED;
+						w->set_color(RED);
 						x = x_parent;
-						x_parent = x->parent;
+						x_parent = x->parent();
 					}
 					else
 					{
-						if (w->right == nullptr || w->right->color == BLACK)
+						if (w->right == nullptr || w->right->color() == BLACK)
 						{
 							// Caso 3: fratello nero, figlio sinistro rosso, destro nero
 							if (w->left != nullptr)
-								w->left->color = BLACK;
-							w->color = RED;
+								w->left->set_color(BLACK);
+							w->set_color(RED);
 							rotate_right(w);
 							w = x_parent->right;
 						}
 						// Caso 4: fratello nero, figlio destro rosso
-						w->color = x_parent->color;
-						x_parent->color = BLACK;
+						w->set_color(x_parent->color());
+						x_parent->set_color(BLACK);
 						if (w->right != nullptr)
-							w->right->color = BLACK;
+							w->right->set_color(BLACK);
 						rotate_left(x_parent);
 						x = root;
 					}
@@ -438,35 +1030,35 @@ namespace STDev
 				{
 					Node* w = x_parent->left;
 
-					if (w->color == RED)
+					if (w->color() == RED)
 					{
-						w->color = BLACK;
-						x_parent->color = RED;
+						w->set_color(BLACK);
+						x_parent->set_color(RED);
 						rotate_right(x_parent);
 						w = x_parent->left;
 					}
 
-					if ((w->right == nullptr || w->right->color == BLACK) &&
-						(w->left == nullptr || w->left->color == BLACK))
+					if ((w->right == nullptr || w->right->color() == BLACK) &&
+						(w->left == nullptr || w->left->color() == BLACK))
 					{
-						w->color = RED;
+						w->set_color(RED);
 						x = x_parent;
-						x_parent = x->parent;
+						x_parent = x->parent();
 					}
 					else
 					{
-						if (w->left == nullptr || w->left->color == BLACK)
+						if (w->left == nullptr || w->left->color() == BLACK)
 						{
 							if (w->right != nullptr)
-								w->right->color = BLACK;
-							w->color = RED;
+								w->right->set_color(BLACK);
+							w->set_color(RED);
 							rotate_left(w);
 							w = x_parent->left;
 						}
-						w->color = x_parent->color;
-						x_parent->color = BLACK;
+						w->set_color(x_parent->color());
+						x_parent->set_color(BLACK);
 						if (w->left != nullptr)
-							w->left->color = BLACK;
+							w->left->set_color(BLACK);
 						rotate_right(x_parent);
 						x = root;
 					}
@@ -474,16 +1066,199 @@ namespace STDev
 			}
 
 			if (x != nullptr)
-				x->color = BLACK;
+				x->set_color(BLACK);
+		}
+
+		static void attach_children(Node* node, Node* left, Node* right)
+		{
+			node->left = left;
+			node->right = right;
+			if (left != nullptr)
+				left->set_parent(node);
+			if (right != nullptr)
+				right->set_parent(node);
 		}
 
-		Node* find_min(Node* node) const
+		// nodi neri da node a una foglia (node compreso); 0 fuori dal RB-Tree
+		static int black_height(const Node* node)
+		{
+			int rank = 0;
+			if constexpr (Type == TreeType::RedBlackTree)
+			{
+				for (; node != nullptr; node = node->left)
+					rank += node->color() == BLACK ? 1 : 0;
+			}
+			return rank;
+		}
+
+		// stacca un sottoalbero dal parent per usarlo come albero a se': nel RB-Tree una radice
+		// rossa diventa nera e rank (la sua black-height) cresce di uno
+		static Node* detach_subtree(Node* subtree, int& rank)
+		{
+			if (subtree != nullptr)
+			{
+				subtree->set_parent(nullptr);
+				if constexpr (Type == TreeType::RedBlackTree)
+				{
+					if (subtree->color() == RED)
+					{
+						subtree->set_color(BLACK);
+						rank++;
+					}
+				}
+			}
+			return subtree;
+		}
+
+		// unisce left_tree < pivot < right_tree (radici senza parent) in un solo albero, che diventa root.
+		// Si scende lungo il fianco interno dell'albero piu' alto fino a un sottoalbero alto quanto
+		// l'altro, pivot li unisce al suo posto e si ribilancia come dopo un insert:
+		// O(differenza di altezza + 1). Nel RB-Tree left_rank e right_rank sono le black-height
+		// (radici nere) e si ritorna quella del risultato; negli altri alberi sono ignorati
+		int join_trees(Node* left_tree, int left_rank, Node* pivot, Node* right_tree, int right_rank)
+		{
+			pivot->left = pivot->right = nullptr;
+			pivot->set_parent(nullptr);
+
+			if constexpr (Type == TreeType::RedBlackTree)
+			{
+				if (left_rank == right_rank)
+				{
+					attach_children(pivot, left_tree, right_tree);
+					pivot->set_color(BLACK);
+					root = pivot;
+					refresh_path(pivot);
+					return left_rank + 1;
+				}
+
+				bool descend_right = left_rank > right_rank;
+				Node* node = descend_right ? left_tree : right_tree;
+				int rank = descend_right ? left_rank : right_rank;
+				int target = descend_right ? right_rank : left_rank;
+				Node* parent = nullptr;
+
+				// primo nodo nero (o foglia) con la black-height dell'albero piu' basso
+				while (rank != target || (node != nullptr && node->color() == RED))
+				{
+					rank -= node->color() == BLACK ? 1 : 0;
+					parent = node;
+					node = descend_right ? node->right : node->left;
+				}
+
+				if (descend_right)
+				{
+					attach_children(pivot, node, right_tree);
+					parent->right = pivot;
+				}
+				else
+				{
+					attach_children(pivot, left_tree, node);
+					parent->left = pivot;
+				}
+				pivot->set_parent(parent);
+				root = descend_right ? left_tree : right_tree;
+
+				refresh_path(pivot);
+				return std::max(left_rank, right_rank) + (insert_fixup(pivot) ? 1 : 0);
+			}
+			else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+			{
+				int left_height = node_height(left_tree);
+				int right_height = node_height(right_tree);
+				if (std::abs(left_height - right_height) <= 1)
+				{
+					attach_children(pivot, left_tree, right_tree);
+					update_height(pivot);
+					root = pivot;
+					refresh_path(pivot);
+					return 0;
+				}
+
+				bool descend_right = left_height > right_height;
+				Node* node = descend_right ? left_tree : right_tree;
+				int target = (descend_right ? right_height : left_height) + 1;
+				Node* parent = nullptr;
+
+				while (node_height(node) > target)
+				{
+					parent = node;
+					node = descend_right ? node->right : node->left;
+				}
+
+				if (descend_right)
+				{
+					attach_children(pivot, node, right_tree);
+					parent->right = pivot;
+				}
+				else
+				{
+					attach_children(pivot, left_tree, node);
+					parent->left = pivot;
+				}
+				pivot->set_parent(parent);
+				update_height(pivot);
+				root = descend_right ? left_tree : right_tree;
+
+				refresh_path(pivot);
+				avl_rebalance(parent);
+				return 0;
+			}
+			else
+			{
+				attach_children(pivot, left_tree, right_tree);
+				root = pivot;
+				refresh_path(pivot);
+				return 0;
+			}
+		}
+
+		template<typename NodePtr>
+		static NodePtr find_min(NodePtr node)
 		{
 			while (node && node->left)
 				node = node->left;
 			return node;
 		}
 
+		template<typename NodePtr>
+		static NodePtr find_max(NodePtr node)
+		{
+			while (node && node->right)
+				node = node->right;
+			return node;
+		}
+
+		// successore in-order risalendo i parent: O(1) ammortizzato su una visita completa
+		template<typename NodePtr>
+		static NodePtr next_node(NodePtr node)
+		{
+			if (node->right)
+				return find_min(node->right);
+
+			NodePtr parent = node->parent();
+			while (parent && node == parent->right)
+			{
+				node = parent;
+				parent = parent->parent();
+			}
+			return parent;
+		}
+
+		template<typename NodePtr>
+		static NodePtr previous_node(NodePtr node)
+		{
+			if (node->left)
+				return find_max(node->left);
+
+			NodePtr parent = node->parent();
+			while (parent && node == parent->left)
+			{
+				node = parent;
+				parent = parent->parent();
+			}
+			return parent;
+		}
+
 		void print_helper(Node* node, const std::string& prefix, bool isLeft) const
 		{
 			if (node != nullptr)
@@ -494,11 +1269,15 @@ namespace STDev
 
 				if constexpr (Type == TreeType::RedBlackTree)
 				{
-					if (node->color == NodeColor::RED)
+					if (node->color() == NodeColor::RED)
 						std::cout << "(R)";
-					else if (node->color == NodeColor::BLACK)
+					else if (node->color() == NodeColor::BLACK)
 						std::cout << "(B)";
 				}
+				else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+				{
+					std::cout << "(bf=" << balance_factor(node) << ")";
+				}
 
 				std::cout << " @" << node << std::endl;
 
@@ -545,26 +1324,71 @@ namespace STDev
 			if (node == nullptr)
 				return;
 
-			Node* stack[10000];
-			int stack_size = 0;
-
-			stack[stack_size++] = node;
-
-			while (stack_size > 0)
+			// unica proprietaria dell'arena: gli slab si restituiscono in blocco e i nodi vengono
+			// solo distrutti, senza deallocate; la visita serve solo se i valori hanno un distruttore
+			bool bulk = false;
+			if constexpr (is_arena_allocator<NodeAllocator>::value)
 			{
-				Node* current = stack[--stack_size];
+				bulk = node_alloc.sole_owner();
+				if (bulk && std::is_trivially_destructible<value_type>::value)
+				{
+					node_alloc.release();
+					return;
+				}
+			}
 
-				if (current->left != nullptr)
-					stack[stack_size++] = current->left;
+			// visita in post-ordine senza stack: si scende finche' c'e' un figlio, si distrugge
+			// la foglia staccandola dal parent e si riparte dal parent. O(n), memoria O(1).
+			// Di un nodo distrutto non si legge piu' nulla, neanche nel caso bulk
+			while (node != nullptr)
+			{
+				if (node->left != nullptr)
+				{
+					node = node->left;
+				}
+				else if (node->right != nullptr)
+				{
+					node = node->right;
+				}
+				else
+				{
+					Node* parent = node->parent();
+					if (parent != nullptr)
+					{
+						if (parent->left == node)
+							parent->left = nullptr;
+						else
+							parent->right = nullptr;
+					}
+					if (bulk)
+						NodeAllocTraits::destroy(node_alloc, node);
+					else
+						destroy_node(node);
+					node = parent;
+				}
+			}
 
-				if (current->right != nullptr)
-					stack[stack_size++] = current->right;
+			if constexpr (is_arena_allocator<NodeAllocator>::value)
+			{
+				if (bulk)
+					node_alloc.release();
+			}
+		}
 
-				delete current;
+		// figli in ordine rispetto al nodo: chiavi strettamente crescenti nella map, non decrescenti
+		// con equal_keys (multimap e multiset, che usano lo stesso albero)
+		bool children_in_order(const Node* node, bool equal_keys) const
+		{
+			if (equal_keys)
+			{
+				return !(node->left && comp(node->data.first, node->left->data.first)) &&
+					!(node->right && comp(node->right->data.first, node->data.first));
 			}
+			return !(node->left && !comp(node->left->data.first, node->data.first)) &&
+				!(node->right && !comp(node->data.first, node->right->data.first));
 		}
 
-		bool check_rb_properties(Node* node, int current_black_count, int& expected_black_height) const
+		bool check_rb_properties(Node* node, int current_black_count, int& expected_black_height, bool equal_keys) const
 		{
 			// Caso base: foglia (nullptr)
 			if (node == nullptr)
@@ -589,11 +1413,17 @@ namespace STDev
 				return true;
 			}
 
+			if (!children_in_order(node, equal_keys))
+			{
+				std::cout << "ERRORE: Ordine violato al nodo [" << node->data.first << "]" << std::endl;
+				return false;
+			}
+
 			// Regola 4: nodo rosso non pu avere figli rossi
-			if (node->color == RED)
+			if (node->color() == RED)
 			{
-				if ((node->left && node->left->color == RED) ||
-					(node->right && node->right->color == RED))
+				if ((node->left && node->left->color() == RED) ||
+					(node->right && node->right->color() == RED))
 				{
 					std::cout << "ERRORE: Nodo rosso [" << node->data.first
 						<< "] ha un figlio rosso!" << std::endl;
@@ -603,35 +1433,122 @@ namespace STDev
 
 			// Conta i nodi neri
 			int black_count = current_black_count;
-			if (node->color == BLACK)
+			if (node->color() == BLACK)
 			{
 				black_count++;
 			}
 
 			// Controlla ricorsivamente i sottoalberi
-			if (!check_rb_properties(node->left, black_count, expected_black_height))
+			if (!check_rb_properties(node->left, black_count, expected_black_height, equal_keys))
 				return false;
 
-			if (!check_rb_properties(node->right, black_count, expected_black_height))
+			if (!check_rb_properties(node->right, black_count, expected_black_height, equal_keys))
 				return false;
 
 			return true;
 		}
 
-		int compute_height(Node* node) const
+		// ritorna l'altezza del sottoalbero, -1 se viola ordine, altezze, bilanciamento o parent
+		int check_avl_properties(const Node* node, const Node* parent, bool equal_keys) const
+		{
+			if (node == nullptr)
+				return 0;
+
+			if (node->parent() != parent)
+			{
+				std::cout << "ERRORE: Parent errato per il nodo [" << node->data.first << "]" << std::endl;
+				return -1;
+			}
+
+			if (!children_in_order(node, equal_keys))
+			{
+				std::cout << "ERRORE: Ordine violato al nodo [" << node->data.first << "]" << std::endl;
+				return -1;
+			}
+
+			int left_height = check_avl_properties(node->left, node, equal_keys);
+			if (left_height < 0)
+				return -1;
+
+			int right_height = check_avl_properties(node->right, node, equal_keys);
+			if (right_height < 0)
+				return -1;
+
+			int expected_height = 1 + std::max(left_height, right_height);
+			if (node->height != expected_height)
+			{
+				std::cout << "ERRORE: Altezza memorizzata " << node->height << " invece di "
+					<< expected_height << " al nodo [" << node->data.first << "]" << std::endl;
+				return -1;
+			}
+
+			if (left_height - right_height > 1 || right_height - left_height > 1)
+			{
+				std::cout << "ERRORE: Nodo [" << node->data.first << "] sbilanciato (bf = "
+					<< left_height - right_height << ")" << std::endl;
+				return -1;
+			}
+
+			return expected_height;
+		}
+
+		// profondita' massima con una visita in ordine sui parent: niente ricorsione
+		int compute_height(const Node* node) const
 		{
 			if (!node)
 				return 0;
 
-			int left_height = compute_height(node->left);
-			int right_height = compute_height(node->right);
+			int depth = 1;
+			int max_depth = 1;
+			while (node->left != nullptr)
+			{
+				node = node->left;
+				depth++;
+			}
 
-			return 1 + std::max(left_height, right_height);
+			while (node != nullptr)
+			{
+				max_depth = std::max(max_depth, depth);
+				if (node->right != nullptr)
+				{
+					node = node->right;
+					depth++;
+					while (node->left != nullptr)
+					{
+						node = node->left;
+						depth++;
+					}
+				}
+				else
+				{
+					const Node* parent = node->parent();
+					while (parent != nullptr && node == parent->right)
+					{
+						node = parent;
+						parent = parent->parent();
+						depth--;
+					}
+					node = parent;
+					depth--;
+				}
+			}
+			return max_depth;
 		}
 
 	public:
 
-		map() : root(nullptr), _size(0)
+		class iterator;
+		class const_iterator;
+
+		map() : root(nullptr), leftmost(nullptr), rightmost(nullptr), _size(0), comp(), node_alloc()
+		{}
+
+		explicit map(const Compare& compare, const Allocator& alloc = Allocator())
+			: root(nullptr), leftmost(nullptr), rightmost(nullptr), _size(0), comp(compare), node_alloc(alloc)
+		{}
+
+		explicit map(const Allocator& alloc)
+			: root(nullptr), leftmost(nullptr), rightmost(nullptr), _size(0), comp(), node_alloc(alloc)
 		{}
 
 		~map()
@@ -639,9 +1556,13 @@ namespace STDev
 			destroy_helper(root);
 		}
 
-		map(const map& other) : root(nullptr), _size(0)
+		map(const map& other)
+			: root(nullptr), leftmost(nullptr), rightmost(nullptr), _size(0), comp(other.comp),
+			node_alloc(NodeAllocTraits::select_on_container_copy_construction(other.node_alloc))
 		{
-			root = copy_helper(other.root);
+			root = copy_tree(other.root, other._size);
+			leftmost = find_min(root);
+			rightmost = find_max(root);
 			_size = other._size;
 		}
 
@@ -650,79 +1571,620 @@ namespace STDev
 			if (this != &other)
 			{
 				destroy_helper(root);
-				root = copy_helper(other.root);
+				root = leftmost = rightmost = nullptr;
+				_size = 0;
+				root = copy_tree(other.root, other._size);
+				leftmost = find_min(root);
+				rightmost = find_max(root);
 				_size = other._size;
+				comp = other.comp;
 			}
 			return *this;
 		}
 
-		map(map&& other) noexcept
-			: root(other.root), _size(other._size)
+		// l'allocator passa alla nuova map (con arena_allocator resta l'unica proprietaria
+		// dell'arena); other riceve l'allocator di una copia e resta utilizzabile
+		map(map&& other) noexcept
+			: root(other.root), leftmost(other.leftmost), rightmost(other.rightmost),
+			_size(other._size), comp(std::move(other.comp)), node_alloc(std::move(other.node_alloc))
+		{
+			other.root = nullptr;
+			other.leftmost = nullptr;
+			other.rightmost = nullptr;
+			other._size = 0;
+			other.node_alloc = NodeAllocTraits::select_on_container_copy_construction(node_alloc);
+		}
+
+		map& operator=(map&& other) noexcept
+		{
+			if (this != &other)
+			{
+				destroy_helper(root);
+				root = other.root;
+				leftmost = other.leftmost;
+				rightmost = other.rightmost;
+				_size = other._size;
+				comp = std::move(other.comp);
+				node_alloc = std::move(other.node_alloc); // i nodi presi appartengono all'allocator di other
+				other.root = nullptr;
+				other.leftmost = nullptr;
+				other.rightmost = nullptr;
+				other._size = 0;
+				other.node_alloc = NodeAllocTraits::select_on_container_copy_construction(node_alloc);
+			}
+			return *this;
+		}
+
+		// una chiave esistente viene sovrascritta (senza ribilanciare: la struttura non cambia)
+		void insert(const K& key, const T& value)
+		{
+			insert_or_assign(key, value);
+		}
+
+		// costruisce il valore da args solo se la chiave manca; altrimenti non tocca nulla
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			Node* parentNode;
+			bool goLeft;
+			Node* node = find_insert_position(key, parentNode, goLeft);
+			if (node)
+			{
+				return { iterator(node, this), false };
+			}
+
+			node = create_node(key, std::forward<Args>(args)...);
+			link_new_node(node, parentNode, goLeft);
+			return { iterator(node, this), true };
+		}
+
+		// inserisce o sovrascrive; il flag dice se la chiave era nuova
+		template<typename M>
+		std::pair<iterator, bool> insert_or_assign(const K& key, M&& value)
+		{
+			Node* parentNode;
+			bool goLeft;
+			Node* node = find_insert_position(key, parentNode, goLeft);
+			if (node)
+			{
+				node->data.second = std::forward<M>(value);
+				refresh_path(node);
+				return { iterator(node, this), false };
+			}
+
+			node = create_node(key, std::forward<M>(value));
+			link_new_node(node, parentNode, goLeft);
+			return { iterator(node, this), true };
+		}
+
+		// insert con suggerimento: O(1) ammortizzato se key va subito prima o subito dopo hint
+		// (con hint = end() e chiavi crescenti, l'append e' sempre O(1) ammortizzato).
+		// Come insert(key, value) sovrascrive una chiave esistente
+		iterator insert(const_iterator hint, const K& key, const T& value)
+		{
+			Node* parentNode;
+			bool goLeft = false;
+			Node* node = find_hint_position(hint.current, key, parentNode, goLeft);
+			if (node)
+			{
+				node->data.second = value;
+				refresh_path(node);
+				return iterator(node, this);
+			}
+
+			node = create_node(key, value);
+			link_new_node(node, parentNode, goLeft);
+			return iterator(node, this);
+		}
+
+		// try_emplace con suggerimento: costruisce il valore da args solo se la chiave manca
+		template<typename... Args>
+		iterator emplace_hint(const_iterator hint, const K& key, Args&&... args)
+		{
+			Node* parentNode;
+			bool goLeft = false;
+			Node* node = find_hint_position(hint.current, key, parentNode, goLeft);
+			if (node)
+				return iterator(node, this);
+
+			node = create_node(key, std::forward<Args>(args)...);
+			link_new_node(node, parentNode, goLeft);
+			return iterator(node, this);
+		}
+
+		// inserisce le coppie di [first, last) con la semantica di insert(key, value).
+		// Finche' le chiavi arrivano crescenti ogni nodo viene agganciato direttamente a destra
+		// del massimo (che non ha mai figlio destro), senza ripartire dalla radice
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			Node* tail = rightmost;
+			for (; first != last; ++first)
+			{
+				if (tail == nullptr || comp(tail->data.first, first->first))
+				{
+					Node* node = create_node(first->first, first->second);
+					link_new_node(node, tail, false);
+					tail = node; // le rotazioni non cambiano l'ordine: resta il massimo
+				}
+				else
+				{
+					insert_or_assign(first->first, first->second);
+				}
+			}
+		}
+
+		// costruisce la map in O(n) da coppie ordinate per chiave strettamente crescente,
+		// senza discese ne' rotazioni. Il primo passaggio conta e verifica l'ordine prima di
+		// allocare: std::invalid_argument se l'intervallo non e' ordinato o ha duplicati
+		template<typename ForwardIt>
+		static map from_sorted(ForwardIt first, ForwardIt last, const Compare& compare = Compare(), const Allocator& alloc = Allocator())
+		{
+			map result(compare, alloc);
+
+			size_t count = 0;
+			ForwardIt previous = first;
+			for (ForwardIt it = first; it != last; ++it)
+			{
+				if (count > 0 && !result.comp(previous->first, it->first))
+					throw std::invalid_argument("map::from_sorted: keys not strictly increasing");
+				previous = it;
+				count++;
+			}
+
+			int max_depth = 0;
+			for (size_t n = count; n > 1; n >>= 1)
+				max_depth++;
+
+			result.root = result.build_sorted(first, count, 0, max_depth);
+			result.leftmost = find_min(result.root);
+			result.rightmost = find_max(result.root);
+			result._size = count;
+			return result;
+		}
+
+		// una sola discesa: il valore di default viene costruito nel nodo, senza temporanei
+		T& operator[](const K& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		iterator find(const K& key)
+		{
+			return iterator(find_helper(root, key), this);
+		}
+
+		const_iterator find(const K& key) const
+		{
+			return const_iterator(find_helper(root, key), this);
+		}
+
+		// out[i] = find(keys[i]) per un blocco di chiavi, con le discese intrecciate
+		// (find_batch_helper): conviene da qualche decina di chiavi in su su alberi fuori cache
+		void find_batch(const K* keys, size_t count, iterator* out)
+		{
+			find_batch_helper(keys, count, [this, out](size_t i, Node* node) { out[i] = iterator(node, this); });
+		}
+
+		void find_batch(const K* keys, size_t count, const_iterator* out) const
+		{
+			find_batch_helper(keys, count, [this, out](size_t i, const Node* node) { out[i] = const_iterator(node, this); });
+		}
+
+		bool contains(const K& key) const
+		{
+			return find_helper(root, key) != nullptr;
+		}
+
+		// primo elemento con chiave >= key
+		iterator lower_bound(const K& key)
+		{
+			return iterator(bound_node(key, false), this);
+		}
+
+		const_iterator lower_bound(const K& key) const
+		{
+			return const_iterator(bound_node(key, false), this);
+		}
+
+		// primo elemento con chiave > key
+		iterator upper_bound(const K& key)
+		{
+			return iterator(bound_node(key, true), this);
+		}
+
+		const_iterator upper_bound(const K& key) const
+		{
+			return const_iterator(bound_node(key, true), this);
+		}
+
+		std::pair<iterator, iterator> equal_range(const K& key)
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		// visita in ordine le coppie con lo <= chiave < hi. Scende fino al primo elemento >= lo
+		// e si ferma al primo >= hi: i sottoalberi fuori dall'intervallo non vengono mai toccati,
+		// costo O(log n + k) invece di una visita da begin()
+		template<typename Func>
+		void for_each_in_range(const K& lo, const K& hi, Func func)
+		{
+			for (Node* node = bound_node(lo, false); node != nullptr && comp(node->data.first, hi); node = next_node(node))
+				func(node->data);
+		}
+
+		template<typename Func>
+		void for_each_in_range(const K& lo, const K& hi, Func func) const
+		{
+			for (const Node* node = bound_node(lo, false); node != nullptr && comp(node->data.first, hi); node = next_node(node))
+				func(node->data);
+		}
+
+		// ricerca eterogenea: disponibile solo se Compare::is_transparent esiste,
+		// la chiave viene confrontata cos com' senza costruire un K temporaneo
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		iterator find(const KeyLike& key)
+		{
+			return iterator(find_helper(root, key), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const_iterator find(const KeyLike& key) const
+		{
+			return const_iterator(find_helper(root, key), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool contains(const KeyLike& key) const
+		{
+			return find_helper(root, key) != nullptr;
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		T& at(const KeyLike& key)
+		{
+			Node* node = find_helper(root, key);
+			if (!node)
+				throw std::out_of_range("map::at: key not found");
+			return node->data.second;
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const T& at(const KeyLike& key) const
+		{
+			Node* node = find_helper(root, key);
+			if (!node)
+				throw std::out_of_range("map::at: key not found");
+			return node->data.second;
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		iterator lower_bound(const KeyLike& key)
+		{
+			return iterator(bound_node(key, false), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const_iterator lower_bound(const KeyLike& key) const
+		{
+			return const_iterator(bound_node(key, false), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		iterator upper_bound(const KeyLike& key)
+		{
+			return iterator(bound_node(key, true), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const_iterator upper_bound(const KeyLike& key) const
+		{
+			return const_iterator(bound_node(key, true), this);
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		std::pair<iterator, iterator> equal_range(const KeyLike& key)
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		std::pair<const_iterator, const_iterator> equal_range(const KeyLike& key) const
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		// elemento di posizione k in ordine (0 = minimo), end() se k >= size(). Solo OrderStatistic
+		iterator nth(size_t k)
+		{
+			return iterator(nth_node(k), this);
+		}
+
+		const_iterator nth(size_t k) const
+		{
+			return const_iterator(nth_node(k), this);
+		}
+
+		// numero di chiavi < key, cioe' la posizione che key ha o avrebbe. Solo OrderStatistic
+		size_t rank(const K& key) const
+		{
+			static_assert(std::is_same<Augment, OrderStatistic>::value, "map::rank requires the OrderStatistic policy");
+
+			size_t result = 0;
+			const Node* node = root;
+			while (node != nullptr)
+			{
+				if (comp(node->data.first, key))
+				{
+					result += OrderStatistic::size(node->left) + 1;
+					node = node->right;
+				}
+				else
+				{
+					node = node->left;
+				}
+			}
+			return result;
+		}
+
+		// numero di chiavi con lo <= chiave < hi (stesso intervallo di for_each_in_range): due discese
+		size_t count_in_range(const K& lo, const K& hi) const
+		{
+			if (!comp(lo, hi))
+				return 0;
+			return rank(hi) - rank(lo);
+		}
+
+		// visita in ordine gli intervalli [key, value) che si sovrappongono a [lo, hi), cioe'
+		// key < hi e lo < value. Si scartano i sottoalberi che finiscono entro lo e quelli che
+		// iniziano da hi in poi: O(k log n) al massimo invece di O(n). Solo IntervalTree
+		template<typename Func>
+		void overlapping(const K& lo, const K& hi, Func func)
+		{
+			overlapping_helper(root, lo, hi, func);
+		}
+
+		template<typename Func>
+		void overlapping(const K& lo, const K& hi, Func func) const
+		{
+			overlapping_helper(static_cast<const Node*>(root), lo, hi, func);
+		}
+
+		// somma dei valori con chiave < key. Solo PrefixSum
+		T prefix_sum(const K& key) const
+		{
+			static_assert(std::is_same<Augment, PrefixSum>::value, "map::prefix_sum requires the PrefixSum policy");
+
+			T result{};
+			const Node* node = root;
+			while (node != nullptr)
+			{
+				if (comp(node->data.first, key))
+				{
+					if (node->left != nullptr)
+						result += node->left->subtree_sum;
+					result += node->data.second;
+					node = node->right;
+				}
+				else
+				{
+					node = node->left;
+				}
+			}
+			return result;
+		}
+
+		// somma dei valori con lo <= chiave < hi
+		T range_sum(const K& lo, const K& hi) const
+		{
+			if (!comp(lo, hi))
+				return T{};
+			return prefix_sum(hi) - prefix_sum(lo);
+		}
+
+		// da chiamare dopo aver modificato un valore tramite riferimento (operator[], at,
+		// iteratore): insert e insert_or_assign aggiornano gia' i dati della policy
+		void refresh(const_iterator pos)
 		{
-			other.root = nullptr;
-			other._size = 0;
+			refresh_path(const_cast<Node*>(pos.current));
 		}
 
-		map& operator=(map&& other) noexcept
+		// verifica i dati della policy in ogni nodo rispetto ai figli, O(n)
+		bool is_valid_augmentation() const
 		{
-			if (this != &other)
+			for (const Node* node = leftmost; node != nullptr; node = next_node(node))
 			{
-				destroy_helper(root);
-				root = other.root;
-				_size = other._size;
-				other.root = nullptr;
-				other._size = 0;
+				if (!Augment::check(node))
+				{
+					std::cout << "ERRORE: Dati aumentati errati al nodo [" << node->data.first << "]" << std::endl;
+					return false;
+				}
 			}
-			return *this;
+			return true;
 		}
 
-		void insert(const K& key, const T& value)
+		Compare key_comp() const
 		{
-			Node* inserted = insert_node(key, value); // for all tree
+			return comp;
+		}
 
-			if constexpr (Type == TreeType::RedBlackTree) // fixup only for RBT
-			{
-				insert_fixup(inserted);
-			}
+		Allocator get_allocator() const
+		{
+			return Allocator(node_alloc);
 		}
 
-		T& operator[](const K& key)
+		void clear()
+		{
+			destroy_helper(root);
+			root = leftmost = rightmost = nullptr;
+			_size = 0;
+		}
+
+		bool erase(const K& key)
 		{
 			Node* node = find_helper(root, key);
 			if (!node)
-			{
-				insert(key, T());
-				node = find_helper(root, key);
-			}
-			return node->data.second;
+				return false;
+
+			erase_node(node);
+			return true;
 		}
 
-		bool find(const K& key) const
+		// rimuove l'elemento puntato e ritorna l'iteratore al successivo (invalida solo pos)
+		iterator erase(const_iterator pos)
 		{
-			return find_helper(root, key) != nullptr;
+			Node* node = const_cast<Node*>(pos.current);
+			Node* next = next_node(node);
+			erase_node(node);
+			return iterator(next, this);
 		}
 
-		void clear()
+		// rimuove [first, last)
+		iterator erase(const_iterator first, const_iterator last)
 		{
-			destroy_helper(root);
-			root = nullptr;
-			_size = 0;
+			while (first != last)
+				first = erase(first);
+			return iterator(const_cast<Node*>(last.current), this);
 		}
 
-		bool erase(const K& key)
+		// divide la map in [min, key) e [key, max] ricollegando i nodi: niente copie ne' allocazioni,
+		// puntatori e riferimenti agli elementi restano validi. La discesa verso key incontra
+		// O(log n) nodi; risalendo, ognuno si unisce (join_trees) con il sottoalbero sinistro alla
+		// parte minore o con il destro alla parte maggiore. Le differenze di altezza dei join
+		// successivi si sommano in una serie telescopica: O(log n) in tutto.
+		// Le dimensioni delle parti si calcolano qui, cosi' size() resta O(1) e senza scritture:
+		// con OrderStatistic sono nella radice (split O(log n)), altrimenti si contano le due parti
+		// in parallelo fermandosi alla fine della piu' piccola (O(log n + min(k, n - k))).
+		// La map resta vuota
+		std::pair<map, map> split(const K& key)
 		{
-			bool erased = false;
+			std::pair<map, map> parts(map(comp, get_allocator()), map(comp, get_allocator()));
+			if (root == nullptr)
+				return parts;
 
-			if constexpr (Type == TreeType::RedBlackTree)
+			map& lower = parts.first;
+			map& upper = parts.second;
+
+			// black-height del nodo corrente (solo RB-Tree), tenuta aggiornata scendendo
+			int rank = black_height(root);
+			Node* node = root;
+			Node* last = nullptr;
+			int last_rank = 0;
+			while (node != nullptr)
+			{
+				last = node;
+				last_rank = rank;
+				if constexpr (Type == TreeType::RedBlackTree)
+					rank -= node->color() == BLACK ? 1 : 0;
+				node = comp(node->data.first, key) ? node->right : node->left;
+			}
+
+			// risalita con i parent: gli antenati non sono ancora stati toccati
+			int lower_rank = 0;
+			int upper_rank = 0;
+			node = last;
+			rank = last_rank;
+			while (node != nullptr)
+			{
+				Node* parent = node->parent();
+				int parent_rank = 0;
+				int child_rank = 0;
+				if constexpr (Type == TreeType::RedBlackTree)
+				{
+					parent_rank = parent != nullptr ? rank + (parent->color() == BLACK ? 1 : 0) : 0;
+					child_rank = rank - (node->color() == BLACK ? 1 : 0);
+				}
+
+				if (comp(node->data.first, key))
+				{
+					Node* subtree = detach_subtree(node->left, child_rank);
+					lower_rank = lower.join_trees(subtree, child_rank, node, lower.root, lower_rank);
+				}
+				else
+				{
+					Node* subtree = detach_subtree(node->right, child_rank);
+					upper_rank = upper.join_trees(upper.root, upper_rank, node, subtree, child_rank);
+				}
+
+				node = parent;
+				rank = parent_rank;
+			}
+
+			lower.leftmost = find_min(lower.root);
+			lower.rightmost = find_max(lower.root);
+			upper.leftmost = find_min(upper.root);
+			upper.rightmost = find_max(upper.root);
+
+			if constexpr (std::is_same<Augment, OrderStatistic>::value)
 			{
-				root = delete_node_rb(key, erased);
+				lower._size = OrderStatistic::size(lower.root);
 			}
 			else
 			{
-				root = erase_helper(root, key, erased);
+				size_t steps = 0;
+				const Node* a = lower.leftmost;
+				const Node* b = upper.leftmost;
+				while (a != nullptr && b != nullptr)
+				{
+					a = next_node(a);
+					b = next_node(b);
+					steps++;
+				}
+				lower._size = a == nullptr ? steps : _size - steps;
+			}
+			upper._size = _size - lower._size;
+
+			root = leftmost = rightmost = nullptr;
+			_size = 0;
+			return parts;
+		}
+
+		// aggiunge le chiavi di other, che devono stare tutte prima o tutte dopo quelle della map
+		// (std::invalid_argument altrimenti). Il minimo della parte maggiore viene staccato e fa da
+		// perno per join_trees: O(log n), nessun nodo copiato. other resta vuota.
+		// I nodi passano di allocator: con arena_allocator le due map devono condividere l'arena
+		void join(map&& other)
+		{
+			if (this == &other || other.root == nullptr)
+				return;
+
+			// una map vuota prende nodi e allocator di other, anche se non ha ancora un'arena
+			if (root == nullptr)
+			{
+				*this = std::move(other);
+				return;
 			}
 
-			return erased;
+			if (!(node_alloc == other.node_alloc))
+				throw std::invalid_argument("map::join: allocators differ");
+
+			bool other_after = comp(rightmost->data.first, other.leftmost->data.first);
+			if (!other_after && !comp(other.rightmost->data.first, leftmost->data.first))
+				throw std::invalid_argument("map::join: key ranges overlap");
+
+			size_t total = _size + other._size;
+			Node* new_leftmost = other_after ? leftmost : other.leftmost;
+			Node* new_rightmost = other_after ? other.rightmost : rightmost;
+
+			map& lower = other_after ? *this : other;
+			map& upper = other_after ? other : *this;
+			Node* pivot = upper.leftmost;
+			upper.unlink_node(pivot);
+
+			Node* lower_root = lower.root;
+			Node* upper_root = upper.root;
+			other.root = other.leftmost = other.rightmost = nullptr;
+			other._size = 0;
+
+			join_trees(lower_root, black_height(lower_root), pivot, upper_root, black_height(upper_root));
+			leftmost = new_leftmost;
+			rightmost = new_rightmost;
+			_size = total;
 		}
 
 		T& at(const K& key)
@@ -743,27 +2205,18 @@ namespace STDev
 
 		bool is_valid_rb_tree() const
 		{
-			if constexpr (Type == TreeType::RedBlackTree)
-			{
-				if (root != nullptr && root->color != BLACK)
-				{
-					std::cout << "ERRORE: La radice non  nera!" << std::endl;
-					return false;
-				}
-
-				int expected_black_height = -1;
-				bool valid = check_rb_properties(root, 0, expected_black_height);
-
-				if (valid)
-				{
-					std::cout << "RB-Tree valido! Black-height = "
-						<< expected_black_height << std::endl;
-				}
+			return valid_rb_tree(false);
+		}
 
-				return valid;
-			}
+		bool is_valid_avl_tree() const
+		{
+			return valid_avl_tree(false);
+		}
 
-			return true;
+		// altezza dell'albero (0 se vuoto), O(n)
+		int height() const
+		{
+			return compute_height(root);
 		}
 
 		void print_tree_info() const
@@ -777,16 +2230,31 @@ namespace STDev
 				{
 					int height = compute_height(root);
 					int black_height = -1;
-					check_rb_properties(root, 0, black_height);
+					check_rb_properties(root, 0, black_height, false);
 
 					std::cout << "Total height: " << height << std::endl;
 					std::cout << "Black height: " << black_height << std::endl;
 					std::cout << "Max theoretical height: " << 2 * black_height << std::endl;
-					std::cout << "Root color: " << (root->color == RED ? "RED" : "BLACK") << std::endl;
+					std::cout << "Root color: " << (root->color() == RED ? "RED" : "BLACK") << std::endl;
 				}
 
 				std::cout << "===================" << std::endl;
 			}
+			else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+			{
+				std::cout << "\n=== AVL-Tree Info ===" << std::endl;
+				std::cout << "Nodes: " << _size << std::endl;
+
+				if (root)
+				{
+					std::cout << "Total height: " << root->height << std::endl;
+					std::cout << "Max theoretical height: "
+						<< static_cast<int>(1.44 * std::log2(static_cast<double>(_size) + 2)) << std::endl;
+					std::cout << "Root balance factor: " << balance_factor(root) << std::endl;
+				}
+
+				std::cout << "====================" << std::endl;
+			}
 		}
 
 		void print_tree() const
@@ -807,7 +2275,11 @@ namespace STDev
 
 				if constexpr (Type == TreeType::RedBlackTree)
 				{
-					std::cout << (root->color == NodeColor::RED ? "(R)" : "(B)");
+					std::cout << (root->color() == NodeColor::RED ? "(R)" : "(B)");
+				}
+				else if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+				{
+					std::cout << "(bf=" << balance_factor(root) << ")";
 				}
 
 				std::cout << " @" << root << std::endl;
@@ -860,76 +2332,62 @@ namespace STDev
 			return _size == 0;
 		}
 
+		// iteratori bidirezionali: un nodo e la map di appartenenza (serve solo a --end()).
+		// Avanzano risalendo i parent pointer, senza stack: copiarli costa due puntatori
 		class iterator
 		{
 		private:
 			Node* current;
-			Node* root;
+			const map* owner;
+
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef typename map::value_type value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef value_type* pointer;
+			typedef value_type& reference;
 
-			Node* stack[1000];
-			int stack_size;
+			iterator(Node* node = nullptr, const map* m = nullptr) : current(node), owner(m)
+			{}
 
-			void push_left(Node* node)
+			value_type& operator*() const
 			{
-				while (node)
-				{
-					stack[stack_size++] = node;
-					node = node->left;
-				}
+				return current->data;
 			}
 
-		public:
-			iterator(Node* node, Node* r) : current(nullptr), root(r), stack_size(0)
+			value_type* operator->() const
 			{
-				if (node == nullptr && root != nullptr)
-				{
-					push_left(root);
-					if (stack_size > 0)
-						current = stack[--stack_size];
-				}
-				else
-				{
-					current = node;
-				}
+				return &(current->data);
 			}
 
-			value_type& operator*()
+			iterator& operator++()
 			{
-				return current->data;
+				if (current)
+					current = next_node(current);
+				return *this;
 			}
 
-			value_type* operator->()
+			iterator operator++(int)
 			{
-				return &(current->data);
+				iterator temp = *this;
+				++(*this);
+				return temp;
 			}
 
-			iterator& operator++()
+			// --end() porta all'ultimo elemento
+			iterator& operator--()
 			{
-				if (!current)
-					return *this;
-
-				if (current->right)
-				{
-					push_left(current->right);
-					if (stack_size > 0)
-						current = stack[--stack_size];
-				}
-				else if (stack_size > 0)
-				{
-					current = stack[--stack_size];
-				}
+				if (current)
+					current = previous_node(current);
 				else
-				{
-					current = nullptr;
-				}
-
+					current = owner->rightmost;
 				return *this;
 			}
 
-			iterator operator++(int)
+			iterator operator--(int)
 			{
 				iterator temp = *this;
-				++(*this);
+				--(*this);
 				return temp;
 			}
 
@@ -944,40 +2402,27 @@ namespace STDev
 			}
 
 			friend class map;
+			friend class const_iterator;
 		};//end iterator class
 
 		class const_iterator
 		{
 		private:
 			const Node* current;
-			const Node* root;
+			const map* owner;
 
-			const Node* stack[1000];
-			int stack_size;
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef typename map::value_type value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const value_type* pointer;
+			typedef const value_type& reference;
 
-			void push_left(const Node* node)
-			{
-				while (node)
-				{
-					stack[stack_size++] = node;
-					node = node->left;
-				}
-			}
+			const_iterator(const Node* node = nullptr, const map* m = nullptr) : current(node), owner(m)
+			{}
 
-		public:
-			const_iterator(const Node* node, const Node* r) : current(nullptr), root(r), stack_size(0)
-			{
-				if (node == nullptr && root != nullptr)
-				{
-					push_left(root);
-					if (stack_size > 0)
-						current = stack[--stack_size];
-				}
-				else
-				{
-					current = node;
-				}
-			}
+			const_iterator(const iterator& it) : current(it.current), owner(it.owner)
+			{}
 
 			const value_type& operator*() const
 			{
@@ -991,24 +2436,8 @@ namespace STDev
 
 			const_iterator& operator++()
 			{
-				if (!current)
-					return *this;
-
-				if (current->right)
-				{
-					push_left(current->right);
-					if (stack_size > 0)
-						current = stack[--stack_size];
-				}
-				else if (stack_size > 0)
-				{
-					current = stack[--stack_size];
-				}
-				else
-				{
-					current = nullptr;
-				}
-
+				if (current)
+					current = next_node(current);
 				return *this;
 			}
 
@@ -1019,6 +2448,22 @@ namespace STDev
 				return temp;
 			}
 
+			const_iterator& operator--()
+			{
+				if (current)
+					current = previous_node(current);
+				else
+					current = owner->rightmost;
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
 			bool operator==(const const_iterator& other) const
 			{
 				return current == other.current;
@@ -1032,34 +2477,163 @@ namespace STDev
 			friend class map;
 		};//end const_iterator class
 
+		typedef std::reverse_iterator<iterator> reverse_iterator;
+		typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
 		iterator begin()
 		{
-			return iterator(nullptr, root);
+			return iterator(leftmost, this);
 		}
 
 		iterator end()
 		{
-			return iterator(nullptr, nullptr);
+			return iterator(nullptr, this);
 		}
 
 		const_iterator begin() const
 		{
-			return const_iterator(nullptr, root);
+			return const_iterator(leftmost, this);
 		}
 
 		const_iterator end() const
 		{
-			return const_iterator(nullptr, nullptr);
+			return const_iterator(nullptr, this);
 		}
 
 		const_iterator cbegin() const
 		{
-			return const_iterator(nullptr, root);
+			return begin();
 		}
 
 		const_iterator cend() const
 		{
-			return const_iterator(nullptr, nullptr);
+			return end();
+		}
+
+		reverse_iterator rbegin()
+		{
+			return reverse_iterator(end());
+		}
+
+		reverse_iterator rend()
+		{
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rbegin() const
+		{
+			return const_reverse_iterator(end());
+		}
+
+		const_reverse_iterator rend() const
+		{
+			return const_reverse_iterator(begin());
+		}
+
+		const_reverse_iterator crbegin() const
+		{
+			return rbegin();
+		}
+
+		const_reverse_iterator crend() const
+		{
+			return rend();
+		}
+
+	protected:
+
+		// validatori di is_valid_rb_tree / is_valid_avl_tree: equal_keys ammette chiavi uguali
+		// tra nodi adiacenti (multimap e multiset), la map le rifiuta
+		bool valid_rb_tree(bool equal_keys) const
+		{
+			if constexpr (Type == TreeType::RedBlackTree)
+			{
+				if (root != nullptr && root->color() != BLACK)
+				{
+					std::cout << "ERRORE: La radice non  nera!" << std::endl;
+					return false;
+				}
+
+				int expected_black_height = -1;
+				bool valid = check_rb_properties(root, 0, expected_black_height, equal_keys);
+
+				if (valid)
+				{
+					std::cout << "RB-Tree valido! Black-height = "
+						<< expected_black_height << std::endl;
+				}
+
+				return valid;
+			}
+
+			return true;
+		}
+
+		bool valid_avl_tree(bool equal_keys) const
+		{
+			if constexpr (Type == TreeType::AdelsonVelskyLandisTree)
+			{
+				if (root != nullptr && root->parent() != nullptr)
+				{
+					std::cout << "ERRORE: La radice ha un parent!" << std::endl;
+					return false;
+				}
+
+				int height = check_avl_properties(root, nullptr, equal_keys);
+
+				if (height >= 0)
+				{
+					std::cout << "AVL-Tree valido! Altezza = " << height << std::endl;
+				}
+
+				return height >= 0;
+			}
+
+			return true;
+		}
+
+		// Chiavi duplicate, solo per multimap e multiset (che ereditano privatamente da map):
+		// le chiavi uguali scendono a destra, quindi un elemento nuovo finisce dopo quelli con la
+		// stessa chiave e l'ordine di inserimento resta stabile. Aggancio e ribilanciamento sono
+		// quelli di insert
+		template<typename... Args>
+		iterator insert_equal(const K& key, Args&&... args)
+		{
+			Node* parentNode = nullptr;
+			bool goLeft = false;
+
+			if (rightmost != nullptr && !comp(key, rightmost->data.first))
+			{
+				parentNode = rightmost; // chiave >= massimo: in coda senza discesa
+			}
+			else
+			{
+				for (Node* currentNode = root; currentNode != nullptr; )
+				{
+					parentNode = currentNode;
+					goLeft = comp(key, currentNode->data.first);
+					currentNode = goLeft ? currentNode->left : currentNode->right;
+				}
+			}
+
+			Node* node = create_node(key, std::forward<Args>(args)...);
+			link_new_node(node, parentNode, goLeft);
+			return iterator(node, this);
+		}
+
+		// rimuove tutti gli elementi con chiave key: una discesa e k cancellazioni, O(log n + k)
+		size_t erase_equal(const K& key)
+		{
+			size_t count = 0;
+			Node* node = bound_node(key, false);
+			while (node != nullptr && !comp(key, node->data.first))
+			{
+				Node* next = next_node(node);
+				erase_node(node);
+				node = next;
+				count++;
+			}
+			return count;
 		}
 	};
 }
\ No newline at end of file
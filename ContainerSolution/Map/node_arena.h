@@ -0,0 +1,253 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace STDev
+{
+	// Arena di nodi a dimensione fissa per map e set.
+	// A differenza di node_pool (globale, condiviso tra thread) ogni container ha la sua
+	// arena: i nodi vengono ritagliati da slab di dimensione crescente e, liberati uno a uno,
+	// tornano in una free-list locale. Quando il container e' l'unico proprietario
+	// dell'arena, clear() e il distruttore restituiscono gli slab in blocco con release()
+	// invece di visitare l'albero nodo per nodo. Non thread-safe, come il container.
+	class node_arena
+	{
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		static constexpr size_t FIRST_SLAB_BLOCKS = 64;
+		static constexpr size_t MAX_SLAB_BLOCKS = 65536;
+
+		std::vector<void*> slabs;
+		char* cursor;
+		char* limit;
+		FreeBlock* free_list;
+		size_t block_size;       // fissata alla prima allocazione (sizeof del nodo)
+		size_t block_align;
+		size_t next_slab_blocks; // raddoppia fino a MAX_SLAB_BLOCKS: O(log n) slab
+		size_t reserved;
+
+		void allocate_slab(size_t blocks)
+		{
+			size_t bytes = block_size * blocks;
+			char* slab = static_cast<char*>(::operator new(bytes));
+			slabs.push_back(slab);
+			cursor = slab;
+			limit = slab + bytes;
+			reserved += bytes;
+		}
+
+		void set_block_layout(size_t bytes, size_t align)
+		{
+			block_align = align < alignof(FreeBlock) ? alignof(FreeBlock) : align;
+			size_t size = bytes < sizeof(FreeBlock) ? sizeof(FreeBlock) : bytes;
+			block_size = (size + block_align - 1) / block_align * block_align;
+		}
+
+	public:
+		node_arena()
+			: cursor(nullptr), limit(nullptr), free_list(nullptr), block_size(0), block_align(0),
+			next_slab_blocks(FIRST_SLAB_BLOCKS), reserved(0)
+		{}
+
+		node_arena(const node_arena&) = delete;
+		node_arena& operator=(const node_arena&) = delete;
+
+		~node_arena()
+		{
+			release();
+		}
+
+		// blocchi che non entrano in block_size (un altro tipo di nodo nella stessa arena)
+		// passano direttamente da operator new
+		void* allocate(size_t bytes, size_t align)
+		{
+			if (block_size == 0)
+				set_block_layout(bytes, align);
+
+			if (bytes > block_size || align > block_align)
+				return ::operator new(bytes);
+
+			if (free_list != nullptr)
+			{
+				FreeBlock* block = free_list;
+				free_list = block->next;
+				return block;
+			}
+
+			if (cursor == limit)
+			{
+				allocate_slab(next_slab_blocks);
+				if (next_slab_blocks < MAX_SLAB_BLOCKS)
+					next_slab_blocks *= 2;
+			}
+
+			void* block = cursor;
+			cursor += block_size;
+			return block;
+		}
+
+		void deallocate(void* ptr, size_t bytes, size_t align) noexcept
+		{
+			if (bytes > block_size || align > block_align)
+			{
+				::operator delete(ptr);
+				return;
+			}
+
+			FreeBlock* block = static_cast<FreeBlock*>(ptr);
+			block->next = free_list;
+			free_list = block;
+		}
+
+		// garantisce almeno blocks blocchi contigui con una sola allocazione: la copia di un
+		// albero di n nodi finisce in un unico slab, nell'ordine in cui viene visitata
+		void reserve(size_t blocks, size_t bytes, size_t align)
+		{
+			if (block_size == 0)
+				set_block_layout(bytes, align);
+
+			if (bytes > block_size || align > block_align)
+				return;
+
+			if (static_cast<size_t>(limit - cursor) / block_size < blocks)
+				allocate_slab(blocks);
+		}
+
+		// restituisce tutti gli slab in O(numero di slab): i nodi vivi diventano invalidi
+		void release() noexcept
+		{
+			for (void* slab : slabs)
+			{
+				::operator delete(slab);
+			}
+			slabs.clear();
+			cursor = limit = nullptr;
+			free_list = nullptr;
+			next_slab_blocks = FIRST_SLAB_BLOCKS;
+			reserved = 0;
+		}
+
+		size_t slab_count() const
+		{
+			return slabs.size();
+		}
+
+		// byte presi dal sistema per gli slab
+		size_t bytes_reserved() const
+		{
+			return reserved;
+		}
+	};
+
+	// Allocator standard sopra una node_arena. Le copie condividono la stessa arena;
+	// un allocator costruito di default ne crea una nuova, e la copia di un container
+	// (select_on_container_copy_construction) riceve un'arena propria. Quest'ultima nasce
+	// al primo nodo, cosi' anche il container spostato la riceve senza allocare (move noexcept):
+	// le copie dell'allocator prese prima di quel momento non la condividono, per questo
+	// un allocator senza arena e' uguale solo a se stesso.
+	template<typename T>
+	class arena_allocator
+	{
+	private:
+		std::shared_ptr<node_arena> arena; // nullptr: arena propria non ancora creata
+
+		template<typename U>
+		friend class arena_allocator;
+
+		node_arena& bound_arena()
+		{
+			if (arena == nullptr)
+				arena = std::make_shared<node_arena>();
+			return *arena;
+		}
+
+	public:
+		typedef T value_type;
+		typedef std::false_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		static_assert(alignof(T) <= alignof(std::max_align_t), "arena_allocator: over-aligned types not supported");
+
+		arena_allocator() : arena(std::make_shared<node_arena>())
+		{}
+
+		explicit arena_allocator(std::shared_ptr<node_arena> shared) : arena(std::move(shared))
+		{}
+
+		template<typename U>
+		arena_allocator(const arena_allocator<U>& other) noexcept : arena(other.arena)
+		{}
+
+		T* allocate(size_t n)
+		{
+			if (n == 1)
+				return static_cast<T*>(bound_arena().allocate(sizeof(T), alignof(T)));
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* ptr, size_t n) noexcept
+		{
+			if (n == 1)
+				arena->deallocate(ptr, sizeof(T), alignof(T));
+			else
+				::operator delete(ptr);
+		}
+
+		// prepara n allocazioni da un oggetto senza passare dallo slab successivo
+		void reserve(size_t n)
+		{
+			bound_arena().reserve(n, sizeof(T), alignof(T));
+		}
+
+		arena_allocator select_on_container_copy_construction() const noexcept
+		{
+			return arena_allocator(std::shared_ptr<node_arena>());
+		}
+
+		// true se nessun altro (container o allocator) usa l'arena: release() e' sicura
+		bool sole_owner() const
+		{
+			return arena.use_count() == 1;
+		}
+
+		void release() noexcept
+		{
+			if (arena != nullptr)
+				arena->release();
+		}
+
+		const node_arena& resource() const
+		{
+			static const node_arena unbound;
+			return arena != nullptr ? *arena : unbound;
+		}
+
+		template<typename U>
+		bool operator==(const arena_allocator<U>& other) const
+		{
+			if (arena == nullptr)
+				return static_cast<const void*>(this) == static_cast<const void*>(&other);
+			return arena == other.arena;
+		}
+
+		template<typename U>
+		bool operator!=(const arena_allocator<U>& other) const
+		{
+			return !(*this == other);
+		}
+	};
+
+	template<typename Alloc>
+	struct is_arena_allocator : std::false_type {};
+
+	template<typename T>
+	struct is_arena_allocator<arena_allocator<T>> : std::true_type {};
+}
@@ -7,6 +7,10 @@
 #include <string>
 #include <cassert>
 #include <iomanip> 
+#include <cmath>
+#include <functional>
+#include <string_view>
+#include <limits>
 
 // ==================== UTILITIES ====================
 
@@ -74,8 +78,8 @@ void test_basic_operations()
 	test_assert(m.size() == 1, "Map size is 1 after insert");
 
 	// Test find
-	test_assert(m.find(5), "Find existing key");
-	test_assert(!m.find(10), "Don't find non-existing key");
+	test_assert(m.contains(5), "Find existing key");
+	test_assert(!m.contains(10), "Don't find non-existing key");
 
 	// Test at
 	try
@@ -107,7 +111,7 @@ void test_basic_operations()
 	bool erased = m.erase(5);
 	test_assert(erased, "erase() returns true on existing key");
 	test_assert(m.size() == 3, "Size decreased after erase");
-	test_assert(!m.find(5), "Key not found after erase");
+	test_assert(!m.contains(5), "Key not found after erase");
 
 	bool not_erased = m.erase(999);
 	test_assert(!not_erased, "erase() returns false on non-existing key");
@@ -137,7 +141,7 @@ void test_operator_bracket()
 	// Test default value creation
 	std::string val = m[999];
 	test_assert(m.size() == 2, "operator[] creates new entry");
-	test_assert(m.find(999), "New key exists");
+	test_assert(m.contains(999), "New key exists");
 }
 
 void test_copy_and_assignment()
@@ -167,7 +171,7 @@ void test_copy_and_assignment()
 	m3 = m1;
 	test_assert(m3.size() == 3, "Copy assignment: size matches");
 	test_assert(m3.at(1) == "one", "Copy assignment: data matches");
-	test_assert(!m3.find(99), "Copy assignment: old data removed");
+	test_assert(!m3.contains(99), "Copy assignment: old data removed");
 }
 
 void test_move_semantics()
@@ -263,7 +267,7 @@ void test_stress_sequential()
 	bool all_found = true;
 	for (int i = 0; i < N; i++)
 	{
-		if (!m.find(i) || m.at(i) != i * 2)
+		if (!m.contains(i) || m.at(i) != i * 2)
 		{
 			all_found = false;
 			break;
@@ -318,7 +322,7 @@ void test_stress_random()
 	bool correct = true;
 	for (int i = 250; i < 500; i++)
 	{
-		if (!m.find(values[i]))
+		if (!m.contains(values[i]))
 		{
 			correct = false;
 			break;
@@ -411,8 +415,8 @@ void test_bst_vs_rbtree()
 	bool bst_correct = true, rbt_correct = true;
 	for (int i = 0; i < N; i++)
 	{
-		if (!bst.find(i)) bst_correct = false;
-		if (!rbt.find(i)) rbt_correct = false;
+		if (!bst.contains(i)) bst_correct = false;
+		if (!rbt.contains(i)) rbt_correct = false;
 	}
 
 	test_assert(bst_correct, "BST: all elements findable");
@@ -422,6 +426,1423 @@ void test_bst_vs_rbtree()
 	std::cout << "      while RB-Tree maintains balance." << std::endl;
 }
 
+void test_avl_tree()
+{
+	section_header("TEST 11: AVL TREE");
+
+	typedef STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree> avl_map;
+
+	// Sequential insert: il caso peggiore del BST resta bilanciato
+	const int N = 1000;
+	avl_map avl;
+	for (int i = 0; i < N; i++)
+		avl.insert(i, i);
+
+	test_assert(avl.size() == N, "AVL: all sequential elements inserted");
+	test_assert(avl.is_valid_avl_tree(), "AVL: valid after sequential inserts");
+	test_assert(avl.height() <= 1.44 * std::log2(N + 2), "AVL: height <= 1.44 log2(n + 2)");
+
+	bool all_found = true;
+	for (int i = 0; i < N; i++)
+	{
+		if (!avl.contains(i) || avl.at(i) != i)
+			all_found = false;
+	}
+	test_assert(all_found, "AVL: all elements findable");
+
+	// Overwrite non cambia la struttura
+	avl.insert(500, -1);
+	test_assert(avl.at(500) == -1 && avl.size() == N, "AVL: insert on existing key overwrites");
+
+	// Erase: foglia, un figlio, due figli (radice compresa)
+	avl_map small;
+	int keys[] = { 50, 30, 70, 20, 40, 60, 80, 10 };
+	for (int k : keys)
+		small.insert(k, k);
+
+	test_assert(small.erase(10), "AVL: erase leaf");
+	test_assert(small.erase(20), "AVL: erase second leaf");
+	test_assert(small.erase(30), "AVL: erase node with one child");
+	test_assert(small.erase(50), "AVL: erase root with two children");
+	test_assert(!small.erase(50), "AVL: erase missing key returns false");
+	test_assert(small.size() == 4 && small.is_valid_avl_tree(), "AVL: valid after erases");
+
+	// Random insert/erase confrontati con un riferimento
+	const int KEYS = 2000;
+	avl_map random_avl;
+	std::vector<int> expected(KEYS, -1);
+	size_t expected_size = 0;
+	std::mt19937 rng(123);
+	bool same = true;
+
+	for (int i = 0; i < 20000; i++)
+	{
+		int key = static_cast<int>(rng() % KEYS);
+		if (rng() % 2 == 0)
+		{
+			if (random_avl.erase(key) != (expected[key] != -1))
+				same = false;
+			if (expected[key] != -1)
+				expected_size--;
+			expected[key] = -1;
+		}
+		else
+		{
+			random_avl.insert(key, i);
+			if (expected[key] == -1)
+				expected_size++;
+			expected[key] = i;
+		}
+	}
+
+	test_assert(same, "AVL: random erase results correct");
+	test_assert(random_avl.size() == expected_size, "AVL: random size correct");
+	test_assert(random_avl.is_valid_avl_tree(), "AVL: valid after random inserts/erases");
+
+	for (int k = 0; k < KEYS; k++)
+	{
+		if (random_avl.contains(k) != (expected[k] != -1) || (expected[k] != -1 && random_avl.at(k) != expected[k]))
+			same = false;
+	}
+	test_assert(same, "AVL: random contents correct");
+
+	// La copia conserva le altezze
+	avl_map copy(random_avl);
+	test_assert(copy.is_valid_avl_tree() && copy.height() == random_avl.height(), "AVL: copy keeps heights");
+
+	for (int k = 0; k < KEYS; k++)
+		random_avl.erase(k);
+	test_assert(random_avl.empty() && random_avl.is_valid_avl_tree(), "AVL: empty after erasing everything");
+}
+
+// chiave che conta i confronti fatti dalla mappa
+struct CountingKey
+{
+	int value;
+	static long long comparisons;
+
+	CountingKey(int v = 0) : value(v) {}
+
+	bool operator<(const CountingKey& other) const { comparisons++; return value < other.value; }
+	bool operator>(const CountingKey& other) const { comparisons++; return value > other.value; }
+};
+
+long long CountingKey::comparisons = 0;
+
+std::ostream& operator<<(std::ostream& os, const CountingKey& key)
+{
+	return os << key.value;
+}
+
+void test_try_emplace_and_insert_or_assign()
+{
+	section_header("TEST 12: TRY_EMPLACE / INSERT_OR_ASSIGN / OPERATOR[]");
+
+	STDev::map<int, std::string> m;
+
+	auto result = m.try_emplace(1, "one");
+	test_assert(result.second, "try_emplace inserts new key");
+	test_assert(result.first->first == 1 && result.first->second == "one", "try_emplace returns iterator to new pair");
+
+	result = m.try_emplace(1, "uno");
+	test_assert(!result.second, "try_emplace on existing key returns false");
+	test_assert(m.at(1) == "one", "try_emplace does not overwrite");
+
+	result = m.try_emplace(2, 3, 'x');
+	test_assert(result.second && m.at(2) == "xxx", "try_emplace forwards constructor arguments");
+
+	result = m.insert_or_assign(3, "three");
+	test_assert(result.second && m.at(3) == "three", "insert_or_assign inserts new key");
+
+	result = m.insert_or_assign(3, "THREE");
+	test_assert(!result.second && result.first->second == "THREE", "insert_or_assign overwrites existing key");
+	test_assert(m.size() == 3, "Size counts only new keys");
+
+	// l'iteratore restituito e' valido per proseguire la visita
+	STDev::map<int, int> seq;
+	for (int i = 0; i < 100; i += 2)
+		seq.insert(i, i);
+	auto it = seq.try_emplace(51, 51).first;
+	int expected[] = { 51, 52, 54, 56 };
+	bool ok = true;
+	for (int e : expected)
+	{
+		if (it == seq.end() || it->first != e)
+			ok = false;
+		++it;
+	}
+	test_assert(ok, "Returned iterator continues in order");
+
+	// sovrascrivere non deve ricolorare: prima il nodo esistente diventava rosso
+	STDev::map<int, int> rb;
+	for (int i = 0; i < 1000; i++)
+		rb.insert(i, i);
+	for (int i = 0; i < 1000; i += 3)
+		rb.insert(i, -i);
+	test_assert(rb.is_valid_rb_tree(), "RB-Tree stays valid after overwriting inserts");
+	for (int i = 0; i < 1000; i += 2)
+		rb.erase(i);
+	test_assert(rb.size() == 500 && rb.is_valid_rb_tree(), "RB-Tree erase after overwrites");
+
+	// operator[]: una sola discesa per una chiave nuova
+	STDev::map<CountingKey, int> counted;
+	for (int i = 0; i < 1024; i++)
+		counted.insert(CountingKey(i * 2), i);
+
+	int height = counted.height();
+	CountingKey::comparisons = 0;
+	counted[CountingKey(777)]++;
+	long long miss_comparisons = CountingKey::comparisons;
+
+	CountingKey::comparisons = 0;
+	counted[CountingKey(778)]++;
+	long long hit_comparisons = CountingKey::comparisons;
+
+	std::cout << "Height " << height << ": operator[] miss = " << miss_comparisons
+		<< " comparisons, hit = " << hit_comparisons << std::endl;
+	test_assert(miss_comparisons <= 2 * height, "operator[] miss: single descent");
+	test_assert(hit_comparisons <= 2 * height, "operator[] hit: single descent");
+	test_assert(counted[CountingKey(777)] == 1 && counted.size() == 1025, "operator[] counter value");
+}
+
+template<STDev::TreeType Type>
+bool check_erase_by_iterator()
+{
+	STDev::map<int, int, Type> m;
+	for (int i = 0; i < 200; i++)
+		m.insert((i * 71) % 200, i);
+
+	// rimuove i multipli di 3 durante la visita usando l'iteratore restituito
+	for (auto it = m.begin(); it != m.end();)
+	{
+		if (it->first % 3 == 0)
+			it = m.erase(it);
+		else
+			++it;
+	}
+
+	int expected = 0;
+	for (const auto& pair : m)
+	{
+		if (expected % 3 == 0)
+			expected++;
+		if (pair.first != expected)
+			return false;
+		expected++;
+	}
+	return m.size() == 133 && !m.contains(0) && !m.contains(99);
+}
+
+void test_bidirectional_iterators()
+{
+	section_header("TEST 13: BIDIRECTIONAL ITERATORS / ERASE(IT)");
+
+	test_assert(sizeof(STDev::map<int, int>::iterator) <= 2 * sizeof(void*), "Iterator is two pointers (no embedded stack)");
+
+	STDev::map<int, int> m;
+	for (int i = 1; i <= 10; i++)
+		m.insert(i, i * 10);
+
+	auto it = m.end();
+	--it;
+	test_assert(it->first == 10, "--end() is the last element");
+	it--;
+	test_assert(it->first == 9, "Post-decrement");
+
+	std::vector<int> reversed;
+	for (auto rit = m.rbegin(); rit != m.rend(); ++rit)
+		reversed.push_back(rit->first);
+	std::vector<int> expected = { 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+	test_assert(reversed == expected, "Reverse iteration with rbegin()/rend()");
+
+	const STDev::map<int, int>& cm = m;
+	int sum = 0;
+	for (auto rit = cm.crbegin(); rit != cm.crend(); ++rit)
+		sum += rit->second;
+	test_assert(sum == 550, "const reverse iteration");
+
+	bool round_trip = true;
+	for (auto fwd = m.begin(); fwd != m.end(); ++fwd)
+	{
+		auto back = fwd;
+		++back;
+		--back;
+		if (back != fwd)
+			round_trip = false;
+	}
+	test_assert(round_trip, "++ then -- returns to the same element");
+
+	STDev::map<int, int>::const_iterator converted = m.begin();
+	test_assert(converted == cm.begin(), "iterator converts to const_iterator");
+
+	auto next = m.erase(m.begin());
+	test_assert(next->first == 2 && m.size() == 9, "erase(begin()) returns the next element");
+
+	auto last = m.end();
+	--last;
+	next = m.erase(last);
+	test_assert(next == m.end() && m.size() == 8, "erase(last) returns end()");
+
+	auto first = m.begin();
+	++first;
+	auto stop = first;
+	++stop;
+	++stop;
+	++stop;
+	next = m.erase(first, stop);
+	test_assert(next->first == 6 && m.size() == 5, "erase(first, last) removes a range");
+	test_assert(m.is_valid_rb_tree(), "RB-Tree valid after erase(it)");
+
+	test_assert(check_erase_by_iterator<STDev::TreeType::RedBlackTree>(), "Erase while iterating: RB-Tree");
+	test_assert(check_erase_by_iterator<STDev::TreeType::AdelsonVelskyLandisTree>(), "Erase while iterating: AVL");
+	test_assert(check_erase_by_iterator<STDev::TreeType::BinarySearchTree>(), "Erase while iterating: BST");
+
+	// un iteratore su un altro elemento resta valido dopo erase (i nodi non vengono copiati)
+	STDev::map<int, int, STDev::TreeType::BinarySearchTree> bst;
+	int keys[] = { 50, 30, 70, 60, 80 };
+	for (int k : keys)
+		bst.insert(k, k);
+	auto successor = bst.try_emplace(60).first;
+	bst.erase(50);
+	test_assert(successor->first == 60 && successor->second == 60, "BST erase keeps other iterators valid");
+
+	// BST degenere piu' profondo del vecchio stack da 1000 nodi
+	STDev::map<int, int, STDev::TreeType::BinarySearchTree> chain;
+	for (int i = 0; i < 5000; i++)
+		chain.insert(i, i);
+	int count = 0;
+	bool ordered = true;
+	for (const auto& pair : chain)
+	{
+		if (pair.first != count)
+			ordered = false;
+		count++;
+	}
+	test_assert(ordered && count == 5000, "Iteration of a 5000-deep degenerate BST");
+
+	count = 0;
+	for (auto rit = chain.rbegin(); rit != chain.rend(); ++rit)
+		count++;
+	test_assert(count == 5000, "Reverse iteration of a 5000-deep degenerate BST");
+}
+
+void test_bounds_and_range_queries()
+{
+	section_header("TEST 14: FIND / LOWER_BOUND / UPPER_BOUND / RANGE QUERIES");
+
+	STDev::map<int, std::string> m;
+	for (int i = 10; i <= 100; i += 10)
+		m.insert(i, std::to_string(i));
+
+	auto it = m.find(40);
+	test_assert(it != m.end() && it->second == "40", "find() returns iterator to the pair");
+	test_assert(m.find(45) == m.end(), "find() returns end() for missing key");
+	it->second = "forty";
+	test_assert(m.at(40) == "forty", "Value modifiable through find()");
+	test_assert(m.contains(40) && !m.contains(45), "contains()");
+
+	test_assert(m.lower_bound(40)->first == 40, "lower_bound on existing key");
+	test_assert(m.lower_bound(41)->first == 50, "lower_bound between keys");
+	test_assert(m.lower_bound(-5) == m.begin(), "lower_bound before first key is begin()");
+	test_assert(m.lower_bound(101) == m.end(), "lower_bound after last key is end()");
+	test_assert(m.upper_bound(40)->first == 50, "upper_bound skips the equal key");
+	test_assert(m.upper_bound(100) == m.end(), "upper_bound of last key is end()");
+
+	auto range = m.equal_range(70);
+	test_assert(range.first->first == 70 && range.second->first == 80, "equal_range on existing key");
+	range = m.equal_range(75);
+	test_assert(range.first == range.second && range.first->first == 80, "equal_range on missing key is empty");
+
+	const STDev::map<int, std::string>& cm = m;
+	test_assert(cm.find(100)->first == 100 && cm.lower_bound(95)->first == 100, "const find / lower_bound");
+
+	// "chiave piu' vicina >= x" e predecessore
+	auto nearest = m.lower_bound(66);
+	auto before = nearest;
+	--before;
+	test_assert(nearest->first == 70 && before->first == 60, "Neighbours of a missing key");
+
+	std::vector<int> in_range;
+	m.for_each_in_range(25, 65, [&in_range](const std::pair<const int, std::string>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	std::vector<int> expected = { 30, 40, 50, 60 };
+	test_assert(in_range == expected, "for_each_in_range visits [25, 65)");
+
+	in_range.clear();
+	m.for_each_in_range(30, 30, [&in_range](const std::pair<const int, std::string>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	test_assert(in_range.empty(), "Empty range visits nothing");
+
+	m.for_each_in_range(90, 1000, [](std::pair<const int, std::string>& pair)
+		{
+			pair.second += "!";
+		});
+	test_assert(m.at(90) == "90!" && m.at(100) == "100!" && m.at(80) == "80", "Non-const visitor modifies values");
+
+	// lo stesso per BST e AVL
+	STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree> avl;
+	STDev::map<int, int, STDev::TreeType::BinarySearchTree> bst;
+	for (int i = 0; i < 1000; i += 2)
+	{
+		avl.insert(i, i);
+		bst.insert(i, i);
+	}
+	long long avl_sum = 0;
+	long long bst_sum = 0;
+	avl.for_each_in_range(101, 201, [&avl_sum](const std::pair<const int, int>& pair) { avl_sum += pair.first; });
+	bst.for_each_in_range(101, 201, [&bst_sum](const std::pair<const int, int>& pair) { bst_sum += pair.first; });
+	test_assert(avl_sum == 7550 && bst_sum == 7550, "Range query on AVL and BST");
+	test_assert(avl.upper_bound(998) == avl.end() && bst.lower_bound(997)->first == 998, "Bounds on AVL and BST");
+
+	// la visita scarta i sottoalberi fuori intervallo: poche comparazioni anche su 4096 chiavi
+	STDev::map<CountingKey, int> counted;
+	for (int i = 0; i < 4096; i++)
+		counted.insert(CountingKey(i), i);
+
+	int visited = 0;
+	CountingKey::comparisons = 0;
+	counted.for_each_in_range(CountingKey(2000), CountingKey(2010), [&visited](const std::pair<const CountingKey, int>&) { visited++; });
+	long long comparisons = CountingKey::comparisons;
+
+	std::cout << "Range di 10 chiavi su 4096: " << comparisons << " comparazioni" << std::endl;
+	test_assert(visited == 10, "Range visits exactly the keys inside");
+	test_assert(comparisons <= 2 * counted.height() + 11, "Range query prunes subtrees (O(log n + k) comparisons)");
+}
+
+// chiave che conta le proprie costruzioni: la ricerca trasparente non deve crearne
+struct TrackedName
+{
+	std::string text;
+	static int constructions;
+
+	TrackedName(const char* t) : text(t) { constructions++; }
+	TrackedName(std::string_view t) : text(t) { constructions++; }
+	TrackedName(const TrackedName& other) : text(other.text) { constructions++; }
+};
+
+int TrackedName::constructions = 0;
+
+std::ostream& operator<<(std::ostream& os, const TrackedName& name)
+{
+	return os << name.text;
+}
+
+struct TrackedNameLess
+{
+	typedef void is_transparent;
+
+	bool operator()(const TrackedName& a, const TrackedName& b) const { return a.text < b.text; }
+	bool operator()(const TrackedName& a, std::string_view b) const { return a.text < b; }
+	bool operator()(std::string_view a, const TrackedName& b) const { return a < b.text; }
+};
+
+// confronta per decine quando coarse e' attivo: dopo averlo attivato chiavi gia' inserite
+// diventano equivalenti, come un duplicato in una map
+struct CoarseLess
+{
+	static bool coarse;
+
+	bool operator()(int a, int b) const { return coarse ? a / 10 < b / 10 : a < b; }
+};
+
+bool CoarseLess::coarse = false;
+
+void test_comparator_and_transparent_lookup()
+{
+	section_header("TEST 15: CUSTOM COMPARATOR / TRANSPARENT LOOKUP");
+
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::greater<int>> desc;
+	for (int i = 1; i <= 100; i++)
+		desc.insert(i, i * 10);
+	test_assert(desc.begin()->first == 100, "std::greater: begin() is the largest key");
+	test_assert(desc.lower_bound(50)->first == 50 && desc.upper_bound(50)->first == 49, "Bounds follow the comparator");
+	test_assert(desc.is_valid_rb_tree(), "RB-Tree valid with std::greater");
+
+	bool descending = true;
+	int previous = 101;
+	for (const auto& pair : desc)
+	{
+		if (pair.first >= previous)
+			descending = false;
+		previous = pair.first;
+	}
+	test_assert(descending && desc.size() == 100, "Iteration in comparator order");
+
+	STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree, std::greater<int>> avl_desc;
+	for (int i = 0; i < 1000; i++)
+		avl_desc.insert(i, i);
+	for (int i = 0; i < 1000; i += 3)
+		avl_desc.erase(i);
+	test_assert(avl_desc.is_valid_avl_tree() && avl_desc.begin()->first == 998, "AVL with std::greater");
+
+	// comparatore con stato
+	struct ModuloLess
+	{
+		int modulo;
+		bool operator()(int a, int b) const { return a % modulo < b % modulo; }
+	};
+	STDev::map<int, std::string, STDev::TreeType::RedBlackTree, ModuloLess> mod(ModuloLess{ 10 });
+	mod.insert(3, "three");
+	mod.insert(13, "thirteen");
+	test_assert(mod.size() == 1 && mod.at(23) == "thirteen", "Stateful comparator: keys equivalent modulo 10");
+	test_assert(mod.key_comp().modulo == 10, "key_comp() returns the comparator");
+
+	STDev::map<std::string, int, STDev::TreeType::RedBlackTree, std::less<>> words;
+	words["alpha"] = 1;
+	words["beta"] = 2;
+	words["gamma"] = 3;
+
+	std::string_view view = "beta";
+	test_assert(words.find(view) != words.end() && words.find(view)->second == 2, "find(string_view) with std::less<>");
+	test_assert(words.contains("gamma") && !words.contains(std::string_view("delta")), "contains(const char*) / contains(string_view)");
+	test_assert(words.at(std::string_view("alpha")) == 1, "at(string_view)");
+	test_assert(words.lower_bound(std::string_view("b"))->first == "beta", "lower_bound(string_view)");
+
+	STDev::map<TrackedName, int, STDev::TreeType::RedBlackTree, TrackedNameLess> names;
+	names.insert("carol", 3);
+	names.insert("alice", 1);
+	names.insert("bob", 2);
+
+	TrackedName::constructions = 0;
+	bool found = names.contains(std::string_view("bob")) && names.find(std::string_view("alice")) != names.end();
+	bool missing = !names.contains(std::string_view("dave"));
+	test_assert(found && missing, "Transparent lookup finds and misses");
+	test_assert(TrackedName::constructions == 0, "Transparent lookup builds no temporary key");
+
+	// un solo confronto per livello, piu' uno per l'uguaglianza
+	STDev::map<CountingKey, int> counted;
+	for (int i = 0; i < 4096; i++)
+		counted.insert(CountingKey(i), i);
+	int height = counted.height();
+
+	CountingKey::comparisons = 0;
+	bool hit = counted.contains(CountingKey(1234));
+	long long hit_comparisons = CountingKey::comparisons;
+
+	CountingKey::comparisons = 0;
+	bool miss = !counted.contains(CountingKey(-1));
+	long long miss_comparisons = CountingKey::comparisons;
+
+	std::cout << "Height " << height << ": find hit = " << hit_comparisons
+		<< " comparisons, miss = " << miss_comparisons << std::endl;
+	test_assert(hit && hit_comparisons <= height + 1, "Lookup hit: one comparison per level");
+	test_assert(miss && miss_comparisons <= height + 1, "Lookup miss: one comparison per level");
+
+	// i validatori della map richiedono chiavi strettamente crescenti
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, CoarseLess> coarse_rb;
+	STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree, CoarseLess> coarse_avl;
+	for (int i = 0; i < 100; i++)
+	{
+		coarse_rb.insert(i, i);
+		coarse_avl.insert(i, i);
+	}
+	bool valid_before = coarse_rb.is_valid_rb_tree() && coarse_avl.is_valid_avl_tree();
+	CoarseLess::coarse = true;
+	bool rb_rejects = !coarse_rb.is_valid_rb_tree();
+	bool avl_rejects = !coarse_avl.is_valid_avl_tree();
+	CoarseLess::coarse = false;
+	test_assert(valid_before && rb_rejects && avl_rejects, "Validators reject equal keys in a map");
+}
+
+template<typename Map>
+bool is_sorted_map(const Map& m)
+{
+	bool first = true;
+	int previous = 0;
+	size_t count = 0;
+	for (const auto& pair : m)
+	{
+		if (!first && !(previous < pair.first))
+			return false;
+		previous = pair.first;
+		first = false;
+		count++;
+	}
+	return count == m.size();
+}
+
+void test_from_sorted_and_bulk_insert()
+{
+	section_header("TEST 16: FROM_SORTED / BULK INSERT");
+
+	bool all_valid = true;
+	bool all_minimal = true;
+	for (int n = 0; n <= 300; n++)
+	{
+		std::vector<std::pair<int, int>> sorted;
+		for (int i = 0; i < n; i++)
+			sorted.push_back({ i * 2, i });
+
+		auto rb = STDev::map<int, int>::from_sorted(sorted.begin(), sorted.end());
+		auto avl = STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree>::from_sorted(sorted.begin(), sorted.end());
+
+		std::cout.setstate(std::ios_base::failbit); // silenzia i messaggi di is_valid_*
+		bool valid = rb.is_valid_rb_tree() && avl.is_valid_avl_tree();
+		std::cout.clear();
+
+		int minimal_height = 0;
+		while ((1 << minimal_height) - 1 < n)
+			minimal_height++;
+
+		if (!valid || rb.size() != static_cast<size_t>(n) || !is_sorted_map(rb))
+			all_valid = false;
+		if (rb.height() != minimal_height || avl.height() != minimal_height)
+			all_minimal = false;
+	}
+	test_assert(all_valid, "from_sorted: valid RB and AVL trees for n = 0..300");
+	test_assert(all_minimal, "from_sorted: minimal height ceil(log2(n + 1))");
+
+	std::vector<std::pair<std::string, int>> words = { { "apple", 1 }, { "banana", 2 }, { "cherry", 3 } };
+	auto m = STDev::map<std::string, int>::from_sorted(words.begin(), words.end());
+	test_assert(m.size() == 3 && m.at("banana") == 2, "from_sorted with string keys");
+
+	m.insert("date", 4);
+	m.erase("apple");
+	test_assert(m.size() == 3 && m.is_valid_rb_tree(), "Insert/erase after from_sorted keep the RB-Tree valid");
+
+	std::vector<std::pair<int, int>> unsorted = { { 1, 1 }, { 3, 3 }, { 2, 2 } };
+	bool thrown = false;
+	try
+	{
+		STDev::map<int, int>::from_sorted(unsorted.begin(), unsorted.end());
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "from_sorted throws on unsorted input");
+
+	std::vector<std::pair<int, int>> duplicates = { { 1, 1 }, { 1, 2 } };
+	thrown = false;
+	try
+	{
+		STDev::map<int, int>::from_sorted(duplicates.begin(), duplicates.end());
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "from_sorted throws on duplicate keys");
+
+	std::vector<std::pair<int, int>> desc_input = { { 3, 3 }, { 2, 2 }, { 1, 1 } };
+	auto desc = STDev::map<int, int, STDev::TreeType::RedBlackTree, std::greater<int>>::from_sorted(desc_input.begin(), desc_input.end());
+	test_assert(desc.begin()->first == 3 && desc.size() == 3, "from_sorted follows the comparator");
+
+	// bulk insert: run crescenti agganciati in coda, il resto con insert normale
+	STDev::map<int, int> bulk;
+	bulk.insert(5, 500);
+	std::vector<std::pair<int, int>> runs;
+	for (int i = 10; i < 1000; i++)
+		runs.push_back({ i, i });
+	for (int i = 0; i < 10; i++)
+		runs.push_back({ i, -i });
+	runs.push_back({ 2000, 2000 });
+	bulk.insert(runs.begin(), runs.end());
+	test_assert(bulk.size() == 1001 && bulk.is_valid_rb_tree(), "Bulk insert with sorted runs keeps the RB-Tree valid");
+	test_assert(bulk.at(5) == -5 && bulk.at(2000) == 2000, "Bulk insert overwrites like insert(key, value)");
+	test_assert(is_sorted_map(bulk), "Bulk insert keeps the order");
+
+	STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree> avl_bulk;
+	avl_bulk.insert(runs.begin(), runs.end());
+	test_assert(avl_bulk.size() == 1001 && avl_bulk.is_valid_avl_tree(), "Bulk insert into AVL");
+
+	// il fast path non fa confronti sulla discesa: uno solo per elemento
+	std::vector<std::pair<CountingKey, int>> counted_input;
+	for (int i = 0; i < 1000; i++)
+		counted_input.push_back({ CountingKey(i), i });
+	STDev::map<CountingKey, int> counted;
+	CountingKey::comparisons = 0;
+	counted.insert(counted_input.begin(), counted_input.end());
+	test_assert(CountingKey::comparisons <= 1000, "Sorted bulk insert: one comparison per element");
+}
+
+void test_hinted_insert()
+{
+	section_header("TEST 17: HINTED INSERT / LEFTMOST-RIGHTMOST CACHE");
+
+	STDev::map<int, int> m;
+	for (int i = 0; i < 1000; i++)
+		m.insert(m.end(), i, i);
+	test_assert(m.size() == 1000 && m.is_valid_rb_tree() && is_sorted_map(m), "Append with hint end()");
+
+	STDev::map<int, int> desc;
+	for (int i = 1000; i > 0; i--)
+		desc.insert(desc.begin(), i, i);
+	test_assert(desc.size() == 1000 && desc.is_valid_rb_tree() && desc.begin()->first == 1, "Prepend with hint begin()");
+
+	// riempie i buchi: hint = elemento successivo alla chiave da inserire
+	STDev::map<int, int> gaps;
+	for (int i = 0; i < 1000; i += 2)
+		gaps.insert(i, i);
+	for (int i = 1; i < 1000; i += 2)
+		gaps.insert(gaps.lower_bound(i), i, i);
+	test_assert(gaps.size() == 1000 && gaps.is_valid_rb_tree() && is_sorted_map(gaps), "Insert before the lower_bound hint");
+
+	// hint sbagliato: si ricade sulla ricerca dalla radice
+	auto it = m.insert(m.begin(), 5000, 1);
+	test_assert(it->first == 5000 && m.size() == 1001 && is_sorted_map(m), "Wrong hint still inserts in the right place");
+	it = m.insert(m.find(10), 500, -1);
+	test_assert(it->first == 500 && m.at(500) == -1 && m.size() == 1001, "Hinted insert overwrites existing key");
+
+	auto emplaced = m.emplace_hint(m.end(), 6000, 6);
+	test_assert(emplaced->first == 6000 && m.at(6000) == 6, "emplace_hint inserts new key");
+	emplaced = m.emplace_hint(m.end(), 6000, 7);
+	test_assert(emplaced->second == 6, "emplace_hint does not overwrite");
+
+	STDev::map<int, std::string, STDev::TreeType::AdelsonVelskyLandisTree> avl;
+	for (int i = 0; i < 500; i++)
+		avl.emplace_hint(avl.end(), i, 3, 'a');
+	for (int i = -1; i > -500; i--)
+		avl.emplace_hint(avl.begin(), i, "neg");
+	test_assert(avl.size() == 999 && avl.is_valid_avl_tree() && avl.at(10) == "aaa", "Hinted insert keeps AVL balanced");
+
+	// leftmost/rightmost seguono insert ed erase
+	STDev::map<int, int> ends;
+	int keys[] = { 50, 30, 70, 20, 80 };
+	for (int k : keys)
+		ends.insert(k, k);
+	ends.erase(20);
+	ends.erase(80);
+	auto last = ends.end();
+	--last;
+	test_assert(ends.begin()->first == 30 && last->first == 70, "begin() and --end() after erasing min and max");
+	ends.insert(10, 10);
+	ends.insert(90, 90);
+	last = ends.end();
+	--last;
+	test_assert(ends.begin()->first == 10 && last->first == 90, "begin() and --end() after new min and max");
+
+	STDev::map<int, int> copy(ends);
+	STDev::map<int, int> moved(std::move(copy));
+	test_assert(moved.begin()->first == 10 && moved.rbegin()->first == 90 && copy.begin() == copy.end(), "Cache copied and moved");
+	moved.clear();
+	test_assert(moved.begin() == moved.end(), "clear() resets the cache");
+	moved.insert(1, 1);
+	test_assert(moved.begin()->first == 1 && moved.rbegin()->first == 1, "Single element is both ends");
+
+	// costo in confronti: un confronto per append, due per un buco accanto all'hint
+	STDev::map<CountingKey, int> counted;
+	CountingKey::comparisons = 0;
+	for (int i = 0; i < 1000; i += 2)
+		counted.insert(counted.end(), CountingKey(i), i);
+	long long append_comparisons = CountingKey::comparisons;
+
+	STDev::map<CountingKey, int> adjacent;
+	for (int i = 0; i < 1000; i += 2)
+		adjacent.insert(CountingKey(i), i);
+	long long hinted_comparisons = 0;
+	for (int i = 1; i < 999; i += 2)
+	{
+		auto hint = adjacent.upper_bound(CountingKey(i));
+		CountingKey::comparisons = 0;
+		adjacent.insert(hint, CountingKey(i), i);
+		hinted_comparisons += CountingKey::comparisons;
+	}
+
+	std::cout << "Confronti: append " << append_comparisons << " per 500 chiavi, hint adiacente "
+		<< hinted_comparisons << " per 499 chiavi" << std::endl;
+	test_assert(append_comparisons <= 500, "Append with end() hint: one comparison per key");
+	test_assert(hinted_comparisons <= 2 * 499, "Adjacent hint: two comparisons per key");
+	test_assert(adjacent.size() == 999 && adjacent.is_valid_rb_tree(), "Hinted inserts keep the RB-Tree valid");
+}
+
+// confronta nth/rank/count_in_range con un vettore ordinato dopo insert ed erase casuali
+template<STDev::TreeType Type>
+bool order_statistic_matches_reference(int operations)
+{
+	STDev::map<int, int, Type, std::less<int>, STDev::OrderStatistic> m;
+	std::vector<int> reference;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> dist(0, 2000);
+
+	for (int i = 0; i < operations; i++)
+	{
+		int key = dist(rng);
+		auto pos = std::lower_bound(reference.begin(), reference.end(), key);
+		bool present = pos != reference.end() && *pos == key;
+		if (i % 3 == 2)
+		{
+			if (m.erase(key) != present)
+				return false;
+			if (present)
+				reference.erase(pos);
+		}
+		else
+		{
+			m.insert(key, key);
+			if (!present)
+				reference.insert(pos, key);
+		}
+	}
+
+	if (m.size() != reference.size() || !m.is_valid_augmentation())
+		return false;
+
+	for (size_t k = 0; k < reference.size(); k++)
+	{
+		if (m.nth(k)->first != reference[k])
+			return false;
+	}
+	if (m.nth(reference.size()) != m.end())
+		return false;
+
+	for (int key = -1; key <= 2001; key += 7)
+	{
+		size_t expected = std::lower_bound(reference.begin(), reference.end(), key) - reference.begin();
+		if (m.rank(key) != expected)
+			return false;
+
+		size_t in_range = std::lower_bound(reference.begin(), reference.end(), key + 100) - reference.begin() - expected;
+		if (m.count_in_range(key, key + 100) != in_range)
+			return false;
+	}
+	return true;
+}
+
+void test_order_statistic()
+{
+	section_header("TEST 18: ORDER STATISTIC (RANK / SELECT)");
+
+	typedef STDev::map<int, std::string, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic> RankedMap;
+
+	RankedMap m;
+	test_assert(m.nth(0) == m.end() && m.rank(10) == 0 && m.count_in_range(0, 100) == 0, "Empty map: nth, rank, count_in_range");
+
+	for (int i = 10; i <= 100; i += 10)
+		m.insert(i, "v" + std::to_string(i));
+	test_assert(m.nth(0)->first == 10 && m.nth(4)->first == 50 && m.nth(9)->first == 100, "nth on 10 keys");
+	test_assert(m.nth(10) == m.end(), "nth(size()) == end()");
+	test_assert(m.rank(10) == 0 && m.rank(55) == 5 && m.rank(100) == 9 && m.rank(1000) == 10, "rank counts smaller keys");
+	test_assert(m.count_in_range(20, 50) == 3 && m.count_in_range(0, 1000) == 10, "count_in_range [lo, hi)");
+	test_assert(m.count_in_range(50, 50) == 0 && m.count_in_range(60, 20) == 0, "count_in_range on empty interval");
+
+	m.erase(50);
+	m.erase(m.begin());
+	test_assert(m.nth(0)->first == 20 && m.nth(3)->first == 60 && m.rank(60) == 3, "nth and rank after erase");
+	test_assert(m.is_valid_augmentation() && m.is_valid_rb_tree(), "Subtree sizes valid after erase");
+
+	const RankedMap& cm = m;
+	test_assert(cm.nth(1)->second == "v30", "const nth");
+
+	test_assert(order_statistic_matches_reference<STDev::TreeType::RedBlackTree>(20000), "RB-Tree matches sorted reference");
+	test_assert(order_statistic_matches_reference<STDev::TreeType::AdelsonVelskyLandisTree>(20000), "AVL-Tree matches sorted reference");
+	test_assert(order_statistic_matches_reference<STDev::TreeType::BinarySearchTree>(5000), "BST matches sorted reference");
+
+	// tutti i percorsi che creano nodi senza link_new_node
+	std::vector<std::pair<int, int>> sorted;
+	for (int i = 0; i < 1000; i++)
+		sorted.push_back({ i * 2, i });
+	auto built = STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic>::from_sorted(sorted.begin(), sorted.end());
+	test_assert(built.is_valid_augmentation() && built.nth(500)->first == 1000, "from_sorted sets subtree sizes");
+
+	auto copy = built;
+	copy.erase(copy.lower_bound(100), copy.lower_bound(200));
+	test_assert(copy.is_valid_augmentation() && copy.rank(300) == 100 && built.rank(300) == 150, "Copy is independent, erase(range) keeps sizes");
+
+	built.insert(built.end(), 5000, 0);
+	built.insert(built.lower_bound(1), 1, 0);
+	built.insert(sorted.begin(), sorted.end());
+	test_assert(built.is_valid_augmentation() && built.size() == 1002 && built.rank(5000) == 1001, "Hinted and bulk insert keep sizes");
+
+	// percentili su dati live
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic> latencies;
+	for (int i = 1; i <= 1000; i++)
+		latencies.insert(i, 0);
+	test_assert(latencies.nth(latencies.size() * 99 / 100)->first == 991, "p99 via nth");
+}
+
+// overlapping e prefix_sum confrontati con una scansione lineare dopo insert ed erase casuali
+template<STDev::TreeType Type>
+bool augmented_policies_match_scan(int operations)
+{
+	STDev::map<int, int, Type, std::less<int>, STDev::IntervalTree> intervals;
+	STDev::map<int, long long, Type, std::less<int>, STDev::PrefixSum> sums;
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> start_dist(0, 5000);
+	std::uniform_int_distribution<int> length_dist(1, 200);
+
+	for (int i = 0; i < operations; i++)
+	{
+		int start = start_dist(rng);
+		if (i % 4 == 3)
+		{
+			intervals.erase(start);
+			sums.erase(start);
+		}
+		else
+		{
+			intervals.insert(start, start + length_dist(rng));
+			sums.insert(start, length_dist(rng));
+		}
+	}
+
+	if (!intervals.is_valid_augmentation() || !sums.is_valid_augmentation())
+		return false;
+
+	for (int lo = -50; lo < 5300; lo += 37)
+	{
+		int hi = lo + 60;
+
+		std::vector<int> expected;
+		for (const auto& pair : intervals)
+		{
+			if (pair.first < hi && lo < pair.second)
+				expected.push_back(pair.first);
+		}
+		std::vector<int> found;
+		intervals.overlapping(lo, hi, [&](const std::pair<const int, int>& pair) { found.push_back(pair.first); });
+		if (found != expected)
+			return false;
+
+		long long prefix = 0;
+		long long range = 0;
+		for (const auto& pair : sums)
+		{
+			if (pair.first < lo)
+				prefix += pair.second;
+			else if (pair.first < hi)
+				range += pair.second;
+		}
+		if (sums.prefix_sum(lo) != prefix || sums.range_sum(lo, hi) != range)
+			return false;
+	}
+	return true;
+}
+
+void test_interval_and_prefix_sum()
+{
+	section_header("TEST 19: INTERVAL TREE / PREFIX SUM POLICIES");
+
+	// prenotazioni: inizio -> fine, intervalli [inizio, fine)
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::IntervalTree> bookings;
+	bookings.insert(10, 20);
+	bookings.insert(15, 40);
+	bookings.insert(30, 35);
+	bookings.insert(50, 60);
+	bookings.insert(0, 5);
+
+	std::vector<int> starts;
+	bookings.overlapping(18, 32, [&](const std::pair<const int, int>& b) { starts.push_back(b.first); });
+	test_assert(starts == std::vector<int>({ 10, 15, 30 }), "overlapping [18, 32)");
+
+	starts.clear();
+	bookings.overlapping(40, 50, [&](const std::pair<const int, int>& b) { starts.push_back(b.first); });
+	test_assert(starts.empty(), "Half-open intervals: touching ends do not overlap");
+
+	starts.clear();
+	bookings.insert(15, 16); // accorcia: max_end dei suoi antenati deve scendere
+	bookings.overlapping(36, 45, [&](const std::pair<const int, int>& b) { starts.push_back(b.first); });
+	test_assert(starts.empty() && bookings.is_valid_augmentation(), "Overwriting a value refreshes max_end");
+
+	bookings.erase(50);
+	starts.clear();
+	bookings.overlapping(0, 100, [&](const std::pair<const int, int>& b) { starts.push_back(b.first); });
+	test_assert(starts == std::vector<int>({ 0, 10, 15, 30 }) && bookings.is_valid_rb_tree(), "overlapping after erase");
+
+	// somme di prefisso: volume per timestamp
+	STDev::map<int, long long, STDev::TreeType::RedBlackTree, std::less<int>, STDev::PrefixSum> volume;
+	for (int t = 1; t <= 100; t++)
+		volume.insert(t, t);
+	test_assert(volume.prefix_sum(1) == 0 && volume.prefix_sum(11) == 55 && volume.prefix_sum(1000) == 5050, "prefix_sum");
+	test_assert(volume.range_sum(11, 21) == 155 && volume.range_sum(21, 11) == 0, "range_sum [lo, hi)");
+
+	volume[50] += 1000; // modifica tramite riferimento: serve refresh
+	volume.refresh(volume.find(50));
+	test_assert(volume.prefix_sum(51) == 1275 + 1000 && volume.is_valid_augmentation(), "refresh after operator[] write");
+
+	volume.insert_or_assign(1, 101);
+	test_assert(volume.prefix_sum(2) == 101 && volume.is_valid_augmentation(), "insert_or_assign refreshes sums");
+
+	const auto& const_volume = volume;
+	test_assert(const_volume.range_sum(1, 101) == 5050 + 1000 + 100, "const range_sum");
+
+	test_assert(augmented_policies_match_scan<STDev::TreeType::RedBlackTree>(20000), "RB-Tree policies match linear scan");
+	test_assert(augmented_policies_match_scan<STDev::TreeType::AdelsonVelskyLandisTree>(20000), "AVL-Tree policies match linear scan");
+	test_assert(augmented_policies_match_scan<STDev::TreeType::BinarySearchTree>(5000), "BST policies match linear scan");
+
+	std::vector<std::pair<int, long long>> sorted;
+	for (int i = 0; i < 1000; i++)
+		sorted.push_back({ i, 2 });
+	auto built = STDev::map<int, long long, STDev::TreeType::RedBlackTree, std::less<int>, STDev::PrefixSum>::from_sorted(sorted.begin(), sorted.end());
+	auto copy = built;
+	test_assert(built.range_sum(0, 1000) == 2000 && copy.prefix_sum(500) == 1000 && copy.is_valid_augmentation(), "from_sorted and copy set subtree sums");
+}
+
+void test_arena_allocator()
+{
+	section_header("TEST 20: ARENA ALLOCATOR / COMPACT NODES");
+
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+		STDev::arena_allocator<std::pair<const int, int>>> ArenaMap;
+
+	ArenaMap m;
+	std::mt19937 rng(5);
+	std::vector<int> keys;
+	for (int i = 0; i < 100000; i++)
+		keys.push_back(i);
+	std::shuffle(keys.begin(), keys.end(), rng);
+	for (int key : keys)
+		m.insert(key, key * 2);
+	test_assert(m.size() == 100000 && m.is_valid_rb_tree() && m.at(777) == 1554, "Insert into arena map");
+
+	// 32 byte per nodo (pair<int, int> + due figli + parent con il colore), pochi slab
+	const STDev::node_arena& arena = m.get_allocator().resource();
+	std::cout << "Arena: " << arena.slab_count() << " slab, " << arena.bytes_reserved() / m.size() << " byte/nodo" << std::endl;
+	test_assert(arena.bytes_reserved() <= m.size() * 32 * 2 && arena.slab_count() < 20, "Compact nodes, O(log n) slabs");
+
+	for (int i = 0; i < 100000; i += 3)
+		m.erase(i);
+	size_t reserved = arena.bytes_reserved();
+	for (int i = 0; i < 100000; i += 3)
+		m.insert(i, i);
+	test_assert(arena.bytes_reserved() == reserved && m.is_valid_rb_tree(), "Erased nodes are reused from the free list");
+
+	ArenaMap copy(m);
+	test_assert(copy.get_allocator() != m.get_allocator() && copy.size() == m.size(), "Copy gets its own arena");
+	m.clear();
+	test_assert(m.empty() && copy.at(999) == 999 && copy.is_valid_rb_tree(), "Clearing the source leaves the copy intact");
+	m.insert(1, 1);
+	test_assert(m.size() == 1 && m.begin()->first == 1, "Arena reusable after clear()");
+
+	ArenaMap moved(std::move(copy));
+	test_assert(moved.get_allocator() != copy.get_allocator() && copy.get_allocator().resource().slab_count() == 0, "Move hands the arena over, no allocation for the moved-from");
+	copy.insert(5, 5); // il moved-from riceve un'arena nuova e resta utilizzabile
+	test_assert(moved.size() == 100000 && copy.size() == 1 && moved.get_allocator() != copy.get_allocator(), "Moved-from map still usable");
+
+	ArenaMap assigned;
+	assigned.insert(1, 1);
+	assigned = std::move(moved);
+	test_assert(assigned.size() == 100000 && moved.empty() && assigned.get_allocator() != moved.get_allocator(), "Move assignment hands the arena over");
+	// unica proprietaria dell'arena: clear() restituisce gli slab invece di metterli in free-list
+	size_t slabs = assigned.get_allocator().resource().slab_count();
+	assigned.clear();
+	test_assert(slabs > 0 && assigned.get_allocator().resource().slab_count() == 0, "Moved-to map releases the arena in bulk");
+	moved.insert(2, 2);
+	test_assert(moved.size() == 1 && moved.at(2) == 2 && moved.get_allocator() != assigned.get_allocator(), "Moved-from map gets its own arena");
+
+	// due map sulla stessa arena: nessun release() finche' e' condivisa
+	STDev::arena_allocator<std::pair<const int, int>> shared;
+	{
+		ArenaMap a(std::less<int>(), shared);
+		ArenaMap b(std::less<int>(), shared);
+		for (int i = 0; i < 1000; i++)
+		{
+			a.insert(i, i);
+			b.insert(-i, i);
+		}
+		a.clear();
+		test_assert(b.size() == 1000 && b.at(-999) == 999 && b.is_valid_rb_tree(), "Shared arena: clear() frees node by node");
+	}
+
+	// valori con distruttore, albero AVL e policy insieme all'arena
+	STDev::map<int, std::string, STDev::TreeType::AdelsonVelskyLandisTree, std::less<int>, STDev::OrderStatistic,
+		STDev::arena_allocator<std::pair<const int, std::string>>> named;
+	for (int i = 0; i < 2000; i++)
+		named.insert(i, "valore abbastanza lungo da stare sullo heap " + std::to_string(i));
+	named.erase(named.nth(10));
+	test_assert(named.is_valid_avl_tree() && named.is_valid_augmentation() && named.nth(10)->first == 11, "AVL + OrderStatistic + arena");
+
+	// rilascio in blocco con valori non banali: ogni valore viene distrutto una sola volta
+	auto token = std::make_shared<int>(0);
+	{
+		STDev::map<int, std::shared_ptr<int>, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+			STDev::arena_allocator<std::pair<const int, std::shared_ptr<int>>>> holders;
+		for (int i = 0; i < 5000; i++)
+			holders.insert(i, token);
+		holders.clear();
+		bool cleared = token.use_count() == 1;
+		for (int i = 0; i < 5000; i++)
+			holders.insert(i, token);
+		test_assert(cleared && holders.is_valid_rb_tree(), "Bulk clear() destroys every value");
+	}
+	test_assert(token.use_count() == 1, "Bulk destruction destroys every value");
+
+	// le copie di una map vuota non hanno ancora un'arena: ognuna avra' la propria
+	ArenaMap empty_source;
+	ArenaMap first(empty_source);
+	ArenaMap second(empty_source);
+	bool unbound_differ = first.get_allocator() != second.get_allocator();
+	first.insert(1, 1);
+	second.insert(2, 2);
+	bool join_thrown = false;
+	try
+	{
+		first.join(std::move(second));
+	}
+	catch (const std::invalid_argument&)
+	{
+		join_thrown = true;
+	}
+	ArenaMap third(empty_source);
+	third.join(std::move(first));
+	test_assert(unbound_differ && join_thrown && second.size() == 1 && first.empty() && third.at(1) == 1,
+		"Copies of an empty map never share an arena");
+
+	std::vector<std::pair<int, int>> sorted;
+	for (int i = 0; i < 1000; i++)
+		sorted.push_back({ i, i });
+	auto built = ArenaMap::from_sorted(sorted.begin(), sorted.end());
+	test_assert(built.size() == 1000 && built.is_valid_rb_tree() && built.at(500) == 500, "from_sorted with arena allocator");
+}
+
+// valore che lancia alla copia numero fail_at: serve a verificare che una copia fallita
+// non perda nodi e non tocchi la sorgente
+struct ThrowingValue
+{
+	static int copies;
+	static int fail_at;
+	static int live;
+	int value;
+
+	ThrowingValue(int v) : value(v) { live++; }
+
+	ThrowingValue(const ThrowingValue& other) : value(other.value)
+	{
+		if (++copies == fail_at)
+			throw std::runtime_error("copy failed");
+		live++;
+	}
+
+	ThrowingValue& operator=(const ThrowingValue&) = default;
+
+	~ThrowingValue() { live--; }
+};
+
+int ThrowingValue::copies = 0;
+int ThrowingValue::fail_at = -1;
+int ThrowingValue::live = 0;
+
+std::ostream& operator<<(std::ostream& os, const ThrowingValue& v)
+{
+	return os << v.value;
+}
+
+void test_deep_copy_and_teardown()
+{
+	section_header("TEST 21: STACK-SAFE COPY / DESTROY (DEGENERATE BST)");
+
+	// chiavi ordinate in un BST: una lista di 10^6 nodi, ogni funzione ricorsiva farebbe overflow
+	const int N = 1000000;
+	{
+		STDev::map<int, int, STDev::TreeType::BinarySearchTree> chain;
+		for (int i = 0; i < N; i++)
+			chain.insert(i, i);
+		test_assert(chain.height() == N, "Degenerate BST: height() == n without recursion");
+
+		STDev::map<int, int, STDev::TreeType::BinarySearchTree> copy(chain);
+		test_assert(copy.size() == static_cast<size_t>(N) && copy.height() == N, "Copy of a 10^6-deep BST");
+		test_assert(copy.begin()->first == 0 && copy.rbegin()->first == N - 1 && copy.at(N / 2) == N / 2, "Copy has the same content");
+
+		chain.erase(N / 2);
+		test_assert(copy.contains(N / 2) && chain.size() == static_cast<size_t>(N - 1), "Copy is independent");
+
+		copy = chain;
+		test_assert(copy.size() == static_cast<size_t>(N - 1) && !copy.contains(N / 2), "Copy assignment of a deep BST");
+
+		copy.clear();
+		test_assert(copy.empty() && copy.height() == 0, "clear() of a deep BST");
+
+		// zig-zag: ogni nodo e' figlio dell'ultimo inserito, alternando sinistra e destra.
+		// Con l'hint sull'ultimo nodo ogni insert e' O(1) invece di ridiscendere la catena
+		STDev::map<int, int, STDev::TreeType::BinarySearchTree> zigzag;
+		auto last = zigzag.insert(zigzag.end(), 0, 0);
+		for (int lo = 1, hi = N - 1; lo < hi; lo++, hi--)
+		{
+			last = zigzag.insert(last, hi, hi);
+			last = zigzag.insert(last, lo, lo);
+		}
+		STDev::map<int, int, STDev::TreeType::BinarySearchTree> zigzag_copy(zigzag);
+		test_assert(zigzag.height() == static_cast<int>(zigzag.size()) && zigzag_copy.size() == zigzag.size() && zigzag_copy.height() == zigzag.height(), "Zig-zag BST copy");
+	} // i distruttori di tutte le map profonde
+
+	// la copia preserva colori, altezze AVL e dati della policy
+	STDev::map<int, int> rb;
+	STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree, std::less<int>, STDev::OrderStatistic> avl;
+	for (int i = 0; i < 5000; i++)
+	{
+		rb.insert((i * 37) % 5000, i);
+		avl.insert((i * 37) % 5000, i);
+	}
+	auto rb_copy = rb;
+	auto avl_copy = avl;
+	test_assert(rb_copy.is_valid_rb_tree() && rb_copy.height() == rb.height(), "RB copy keeps colors and shape");
+	test_assert(avl_copy.is_valid_avl_tree() && avl_copy.is_valid_augmentation() && avl_copy.nth(1234)->first == 1234, "AVL + OrderStatistic copy keeps heights and sizes");
+
+	// copia fallita a meta': nessun leak (ASan), sorgente intatta, destinazione invariata
+	STDev::map<int, ThrowingValue> source;
+	for (int i = 0; i < 1000; i++)
+		source.insert(i, ThrowingValue(i));
+	STDev::map<int, ThrowingValue> target;
+	target.insert(-1, ThrowingValue(-1));
+
+	ThrowingValue::copies = 0;
+	ThrowingValue::fail_at = 500;
+	bool thrown = false;
+	try
+	{
+		STDev::map<int, ThrowingValue> copy(source);
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown && source.size() == 1000 && source.is_valid_rb_tree(), "Throwing copy constructor leaves source intact");
+
+	ThrowingValue::copies = 0;
+	thrown = false;
+	try
+	{
+		target = source;
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	ThrowingValue::fail_at = -1;
+	test_assert(thrown && target.empty() && target.begin() == target.end(), "Throwing copy assignment leaves an empty map");
+	target = source;
+	test_assert(target.size() == 1000 && target.at(999).value == 999, "Copy assignment after a failed one");
+
+	// from_sorted e insert(first, last) falliti a meta': i nodi gia' costruiti vengono distrutti
+	std::vector<std::pair<int, ThrowingValue>> sorted_values;
+	for (int i = 0; i < 1000; i++)
+		sorted_values.push_back({ i, ThrowingValue(i) });
+	int live_before = ThrowingValue::live;
+	bool all_thrown = true;
+	for (int fail_at : { 1, 2, 500, 1000 })
+	{
+		ThrowingValue::copies = 0;
+		ThrowingValue::fail_at = fail_at;
+		thrown = false;
+		try
+		{
+			STDev::map<int, ThrowingValue, STDev::TreeType::AdelsonVelskyLandisTree>::from_sorted(sorted_values.begin(), sorted_values.end());
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		all_thrown &= thrown;
+	}
+	test_assert(all_thrown && ThrowingValue::live == live_before, "Throwing from_sorted destroys the partial tree");
+
+	ThrowingValue::copies = 0;
+	ThrowingValue::fail_at = 700;
+	thrown = false;
+	try
+	{
+		STDev::map<int, ThrowingValue> bulk;
+		bulk.insert(sorted_values.begin(), sorted_values.end());
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	ThrowingValue::fail_at = -1;
+	test_assert(thrown && ThrowingValue::live == live_before, "Throwing bulk insert leaks no node");
+
+	// con arena: tutti i nodi della copia in un solo slab
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+		STDev::arena_allocator<std::pair<const int, int>>> ArenaMap;
+	ArenaMap arena_source;
+	for (int i = 0; i < 100000; i++)
+		arena_source.insert(i, i);
+	ArenaMap arena_copy(arena_source);
+	test_assert(arena_copy.get_allocator().resource().slab_count() == 1 && arena_copy.is_valid_rb_tree(), "Arena copy: one slab for the whole tree");
+}
+
+template<typename Map>
+bool same_content(const Map& m, std::vector<std::pair<int, int>>::const_iterator first, std::vector<std::pair<int, int>>::const_iterator last)
+{
+	if (m.size() != static_cast<size_t>(last - first))
+		return false;
+	for (auto it = m.begin(); it != m.end(); ++it, ++first)
+	{
+		if (it->first != first->first || it->second != first->second)
+			return false;
+	}
+	// leftmost / rightmost delle parti
+	return m.empty() || (m.begin()->first == (last - m.size())->first && std::prev(m.end())->first == (last - 1)->first);
+}
+
+template<STDev::TreeType Type, typename Augment>
+bool check_split_join(int seed)
+{
+	typedef STDev::map<int, int, Type, std::less<int>, Augment> Map;
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> dist(0, 100000);
+	Map m;
+	for (int i = 0; i < 20000; i++)
+		m.insert(dist(rng), i);
+	std::vector<std::pair<int, int>> reference(m.begin(), m.end());
+
+	bool ok = true;
+	for (int round = 0; round < 6; round++)
+	{
+		// sotto il minimo, sopra il massimo, chiave presente, chiave casuale
+		int key = round == 0 ? -1 : round == 1 ? 200000 : round == 2 ? reference[reference.size() / 3].first : dist(rng);
+		auto middle = std::lower_bound(reference.begin(), reference.end(), std::make_pair(key, std::numeric_limits<int>::min()));
+		const int* moved_value = middle != reference.end() ? &m.at(middle->first) : nullptr;
+
+		auto parts = m.split(key);
+		Map& lower = parts.first;
+		Map& upper = parts.second;
+
+		ok = ok && m.empty() && same_content(lower, reference.cbegin(), middle) && same_content(upper, middle, reference.cend());
+		ok = ok && lower.is_valid_rb_tree() && upper.is_valid_rb_tree() && lower.is_valid_avl_tree() && upper.is_valid_avl_tree();
+		ok = ok && lower.is_valid_augmentation() && upper.is_valid_augmentation();
+		ok = ok && (moved_value == nullptr || &upper.at(middle->first) == moved_value); // nessuna copia
+
+		// ricongiunge in entrambi i versi
+		if (round % 2 == 0)
+		{
+			lower.join(std::move(upper));
+			m = std::move(lower);
+		}
+		else
+		{
+			upper.join(std::move(lower));
+			m = std::move(upper);
+		}
+		ok = ok && lower.empty() && upper.empty() && same_content(m, reference.cbegin(), reference.cend());
+	}
+	return ok && m.is_valid_rb_tree() && m.is_valid_avl_tree() && m.is_valid_augmentation();
+}
+
+void test_split_and_join()
+{
+	section_header("TEST 22: SPLIT / JOIN");
+
+	test_assert(check_split_join<STDev::TreeType::RedBlackTree, STDev::NoAugment>(1), "RB-Tree: split and join keep content and invariants");
+	test_assert(check_split_join<STDev::TreeType::AdelsonVelskyLandisTree, STDev::NoAugment>(2), "AVL-Tree: split and join keep content and invariants");
+	test_assert(check_split_join<STDev::TreeType::BinarySearchTree, STDev::NoAugment>(3), "BST: split and join keep content");
+	test_assert(check_split_join<STDev::TreeType::RedBlackTree, STDev::OrderStatistic>(4), "RB-Tree + OrderStatistic: subtree sizes after split / join");
+	test_assert(check_split_join<STDev::TreeType::AdelsonVelskyLandisTree, STDev::PrefixSum>(5), "AVL-Tree + PrefixSum: subtree sums after split / join");
+
+	// join di alberi di altezze molto diverse
+	STDev::map<int, int> big;
+	for (int i = 0; i < 100000; i++)
+		big.insert(i, i);
+	STDev::map<int, int> small;
+	small.insert(-5, -5);
+	small.insert(-3, -3);
+	big.join(std::move(small));
+	STDev::map<int, int> tail;
+	tail.insert(200000, 0);
+	big.join(std::move(tail));
+	test_assert(big.size() == 100003 && big.begin()->first == -5 && std::prev(big.end())->first == 200000 && big.is_valid_rb_tree(), "join with a much smaller map on both sides");
+
+	STDev::map<int, int> overlapping;
+	overlapping.insert(50, 0);
+	bool thrown = false;
+	try
+	{
+		big.join(std::move(overlapping));
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown && overlapping.size() == 1 && big.size() == 100003, "join of overlapping key ranges throws");
+
+	STDev::map<int, int> empty;
+	auto parts = empty.split(10);
+	big.join(std::move(parts.first));
+	test_assert(parts.first.empty() && parts.second.empty() && big.size() == 100003, "split / join of empty maps");
+
+	// BST degenere: la discesa e la risalita sono iterative
+	STDev::map<int, int, STDev::TreeType::BinarySearchTree> chain;
+	for (int i = 0; i < 100000; i++)
+		chain.insert(i, i);
+	auto halves = chain.split(50000);
+	test_assert(halves.first.size() == 50000 && halves.second.begin()->first == 50000 && std::prev(halves.first.end())->first == 49999, "split of a degenerate BST");
+
+	// senza OrderStatistic split conta la parte piu' piccola: le dimensioni restano esatte dopo altre modifiche
+	STDev::map<int, int> plain;
+	for (int i = 0; i < 1000; i++)
+		plain.insert(i, i);
+	auto plain_parts = plain.split(400);
+	plain_parts.first.insert(-1, -1);
+	plain_parts.first.erase(0);
+	plain_parts.first.erase(1);
+	plain_parts.second.join(std::move(plain_parts.first));
+	plain_parts.second.insert(5000, 0);
+	auto counted_copy = plain_parts.second;
+	test_assert(!plain_parts.second.empty() && plain_parts.second.size() == 1000 && counted_copy.size() == 1000 && plain_parts.first.empty(), "Part sizes after split, insert, erase, join and copy");
+
+	// con arena_allocator le parti condividono l'arena e si possono ricongiungere
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+		STDev::arena_allocator<std::pair<const int, int>>> ArenaMap;
+	ArenaMap arena;
+	for (int i = 0; i < 1000; i++)
+		arena.insert(i, i);
+	auto arena_parts = arena.split(300);
+	arena_parts.second.join(std::move(arena_parts.first));
+	ArenaMap other_arena;
+	other_arena.insert(5000, 0);
+	thrown = false;
+	try
+	{
+		arena_parts.second.join(std::move(other_arena));
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(arena_parts.second.size() == 1000 && arena_parts.second.is_valid_rb_tree() && thrown, "Arena: same-arena join, different arenas throw");
+}
+
+void test_find_batch()
+{
+	section_header("TEST 23: FIND_BATCH");
+
+	std::mt19937 rng(50);
+	std::uniform_int_distribution<int> dist(0, 200000);
+
+	STDev::map<int, int> rb;
+	STDev::map<int, int, STDev::TreeType::BinarySearchTree> bst;
+	for (int i = 0; i < 50000; i++)
+	{
+		int key = dist(rng);
+		rb.insert(key, i);
+		bst.insert(key, i);
+	}
+
+	// 1000 chiavi: l'ultimo gruppo e' incompleto
+	std::vector<int> keys(1000);
+	for (int& key : keys)
+		key = dist(rng);
+	keys[0] = rb.begin()->first;
+
+	std::vector<STDev::map<int, int>::iterator> found(keys.size());
+	rb.find_batch(keys.data(), keys.size(), found.data());
+	bool same = true;
+	for (size_t i = 0; i < keys.size(); i++)
+		same = same && found[i] == rb.find(keys[i]);
+	test_assert(same, "find_batch matches find (RB-Tree)");
+
+	const auto& const_bst = bst;
+	std::vector<STDev::map<int, int, STDev::TreeType::BinarySearchTree>::const_iterator> const_found(keys.size());
+	const_bst.find_batch(keys.data(), keys.size(), const_found.data());
+	same = true;
+	for (size_t i = 0; i < keys.size(); i++)
+		same = same && const_found[i] == const_bst.find(keys[i]);
+	test_assert(same, "const find_batch matches find (BST, depths differ per key)");
+
+	found[0]->second = -1;
+	test_assert(rb.at(keys[0]) == -1, "Iterators from find_batch are writable");
+
+	STDev::map<int, int> empty;
+	STDev::map<int, int>::iterator none;
+	empty.find_batch(keys.data(), 1, &none);
+	test_assert(none == empty.end(), "find_batch on empty map");
+}
+
 // ==================== BENCHMARKS ====================
 
 void benchmark_insert()
@@ -494,7 +1915,7 @@ void benchmark_search()
 	auto start = std::chrono::high_resolution_clock::now();
 	int rb_found = 0;
 	for (int key : search_keys)
-		if (rb.find(key)) rb_found++;
+		if (rb.contains(key)) rb_found++;
 	auto end = std::chrono::high_resolution_clock::now();
 	auto duration_rb = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
@@ -502,7 +1923,7 @@ void benchmark_search()
 	start = std::chrono::high_resolution_clock::now();
 	int bst_found = 0;
 	for (int key : search_keys)
-		if (bst.find(key)) bst_found++;
+		if (bst.contains(key)) bst_found++;
 	end = std::chrono::high_resolution_clock::now();
 	auto duration_bst = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
@@ -555,14 +1976,14 @@ void benchmark_worst_case()
 	start = std::chrono::high_resolution_clock::now();
 	int rb_found = 0;
 	for (int key : search_keys)
-		if (rb.find(key)) rb_found++;
+		if (rb.contains(key)) rb_found++;
 	end = std::chrono::high_resolution_clock::now();
 	duration_rb = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
 	start = std::chrono::high_resolution_clock::now();
 	int bst_found = 0;
 	for (int key : search_keys)
-		if (bst.find(key)) bst_found++;
+		if (bst.contains(key)) bst_found++;
 	end = std::chrono::high_resolution_clock::now();
 	duration_bst = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 
@@ -581,6 +2002,557 @@ void benchmark_worst_case()
 	std::cout << "      RB-Tree mantiene balance (O(log n))" << std::endl;
 }
 
+void benchmark_read_heavy()
+{
+	section_header("BENCHMARK 6: READ-HEAVY RB-TREE vs AVL");
+
+	const int N = 100000;
+	const int SEARCHES = 1000000;
+
+	std::vector<int> random_keys;
+	for (int i = 0; i < N; i++)
+		random_keys.push_back(i);
+	std::mt19937 g(42);
+	std::shuffle(random_keys.begin(), random_keys.end(), g);
+
+	std::vector<int> search_keys;
+	for (int i = 0; i < SEARCHES; i++)
+		search_keys.push_back(static_cast<int>(g() % N));
+
+	std::cout << "\n" << N << " elementi, " << SEARCHES << " ricerche casuali" << std::endl;
+	std::cout << "Insert order\tTree\tHeight\tInsert(ms)\tSearch(ms)" << std::endl;
+	std::cout << "----------------------------------------------------------" << std::endl;
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		const char* order = pass == 0 ? "random" : "sequential";
+
+		auto start = std::chrono::high_resolution_clock::now();
+		STDev::map<int, int, STDev::TreeType::RedBlackTree> rb;
+		for (int i = 0; i < N; i++)
+			rb.insert(pass == 0 ? random_keys[i] : i, i);
+		auto end = std::chrono::high_resolution_clock::now();
+		auto rb_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		start = std::chrono::high_resolution_clock::now();
+		STDev::map<int, int, STDev::TreeType::AdelsonVelskyLandisTree> avl;
+		for (int i = 0; i < N; i++)
+			avl.insert(pass == 0 ? random_keys[i] : i, i);
+		end = std::chrono::high_resolution_clock::now();
+		auto avl_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		int rb_found = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int key : search_keys)
+			if (rb.contains(key)) rb_found++;
+		end = std::chrono::high_resolution_clock::now();
+		auto rb_search = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		int avl_found = 0;
+		start = std::chrono::high_resolution_clock::now();
+		for (int key : search_keys)
+			if (avl.contains(key)) avl_found++;
+		end = std::chrono::high_resolution_clock::now();
+		auto avl_search = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+		std::cout << order << "\tRB\t" << rb.height() << "\t" << rb_insert << "\t\t" << rb_search << std::endl;
+		std::cout << order << "\tAVL\t" << avl.height() << "\t" << avl_insert << "\t\t" << avl_search
+			<< "  (found " << rb_found << "/" << avl_found << ")" << std::endl;
+	}
+
+	std::cout << "\nNote: AVL e' piu' basso (<= 1.44 log2 n contro 2 log2 n): ricerche piu' corte," << std::endl;
+	std::cout << "      al prezzo di piu' rotazioni in insert/erase." << std::endl;
+}
+
+void benchmark_counter_aggregation()
+{
+	section_header("BENCHMARK 7: COUNTER AGGREGATION (operator[])");
+
+	const int KEYS = 50000;
+	const int EVENTS = 1000000;
+
+	std::mt19937 g(42);
+	std::vector<int> events;
+	for (int i = 0; i < EVENTS; i++)
+		events.push_back(static_cast<int>(g() % KEYS));
+
+	// il vecchio schema di operator[]: find, insert(key, T()), find
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> three_pass;
+	for (int key : events)
+	{
+		if (!three_pass.contains(key))
+			three_pass.insert(key, 0);
+		three_pass.at(key)++;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto three_pass_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> single_pass;
+	for (int key : events)
+		single_pass[key]++;
+	end = std::chrono::high_resolution_clock::now();
+	auto single_pass_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << EVENTS << " incrementi su " << KEYS << " chiavi:" << std::endl;
+	std::cout << "  find + insert + at:  " << three_pass_ms << " ms" << std::endl;
+	std::cout << "  operator[]:          " << single_pass_ms << " ms" << std::endl;
+	std::cout << "  (stesso risultato: " << (three_pass.size() == single_pass.size() ? "si" : "NO") << ")" << std::endl;
+}
+
+void benchmark_range_queries()
+{
+	section_header("BENCHMARK 8: TIME-SERIES RANGE QUERIES");
+
+	const int N = 200000;
+	const int QUERIES = 1000;
+	const int WINDOW = 100;
+
+	// timestamp crescenti con passo irregolare, come un indice di serie temporale
+	std::mt19937 g(42);
+	STDev::map<int, int> series;
+	int t = 0;
+	for (int i = 0; i < N; i++)
+	{
+		t += 1 + static_cast<int>(g() % 10);
+		series.insert(t, i);
+	}
+
+	std::vector<int> starts;
+	for (int i = 0; i < QUERIES; i++)
+		starts.push_back(static_cast<int>(g() % t));
+
+	long long full_sum = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int t0 : starts)
+	{
+		for (const auto& pair : series)
+		{
+			if (pair.first >= t0 + WINDOW)
+				break;
+			if (pair.first >= t0)
+				full_sum += pair.second;
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto scan_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	long long range_sum = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int t0 : starts)
+		series.for_each_in_range(t0, t0 + WINDOW, [&range_sum](const std::pair<const int, int>& pair)
+			{
+				range_sum += pair.second;
+			});
+	end = std::chrono::high_resolution_clock::now();
+	auto range_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	std::cout << "\n" << QUERIES << " query [t0, t0 + " << WINDOW << ") su " << N << " timestamp:" << std::endl;
+	std::cout << "  scansione da begin():  " << scan_ms << " ms" << std::endl;
+	std::cout << "  for_each_in_range:     " << range_us << " us" << std::endl;
+	std::cout << "  (stesso risultato: " << (full_sum == range_sum ? "si" : "NO") << ")" << std::endl;
+}
+
+void benchmark_bulk_load()
+{
+	section_header("BENCHMARK 9: BULK LOAD OF SORTED KEYS");
+
+	const int N = 1000000;
+	std::vector<std::pair<int, int>> sorted;
+	sorted.reserve(N);
+	for (int i = 0; i < N; i++)
+		sorted.push_back({ i, i });
+
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> one_by_one;
+	for (const auto& pair : sorted)
+		one_by_one.insert(pair.first, pair.second);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto insert_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> bulk;
+	bulk.insert(sorted.begin(), sorted.end());
+	end = std::chrono::high_resolution_clock::now();
+	auto bulk_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	auto built = STDev::map<int, int>::from_sorted(sorted.begin(), sorted.end());
+	end = std::chrono::high_resolution_clock::now();
+	auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " chiavi ordinate:" << std::endl;
+	std::cout << "  N x insert(key, value):  " << insert_ms << " ms (altezza " << one_by_one.height() << ")" << std::endl;
+	std::cout << "  insert(first, last):     " << bulk_ms << " ms (altezza " << bulk.height() << ")" << std::endl;
+	std::cout << "  from_sorted:             " << build_ms << " ms (altezza " << built.height() << ")" << std::endl;
+}
+
+void benchmark_hinted_ingest()
+{
+	section_header("BENCHMARK 10: MONOTONIC INGEST (HINTED INSERT)");
+
+	const int N = 1000000;
+
+	// timestamp decrescenti (es. replay all'indietro): senza hint ogni insert scende fino al minimo
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> plain;
+	for (int i = N; i > 0; i--)
+		plain.insert(i, i);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto plain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> hinted;
+	for (int i = N; i > 0; i--)
+		hinted.insert(hinted.begin(), i, i);
+	end = std::chrono::high_resolution_clock::now();
+	auto hinted_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	// timestamp crescenti: insert(key, value) usa gia' il fast path sul massimo in cache
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> append;
+	for (int i = 0; i < N; i++)
+		append.insert(i, i);
+	end = std::chrono::high_resolution_clock::now();
+	auto append_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> append_hint;
+	for (int i = 0; i < N; i++)
+		append_hint.insert(append_hint.end(), i, i);
+	end = std::chrono::high_resolution_clock::now();
+	auto append_hint_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " timestamp:" << std::endl;
+	std::cout << "  decrescenti, insert(key, value):          " << plain_ms << " ms" << std::endl;
+	std::cout << "  decrescenti, insert(begin(), key, value): " << hinted_ms << " ms" << std::endl;
+	std::cout << "  crescenti,   insert(key, value):          " << append_ms << " ms" << std::endl;
+	std::cout << "  crescenti,   insert(end(), key, value):   " << append_hint_ms << " ms" << std::endl;
+}
+
+void benchmark_order_statistic()
+{
+	section_header("BENCHMARK 11: PERCENTILE (nth) VS ITERAZIONE");
+
+	const int N = 1000000;
+	const int QUERIES = 1000;
+
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic> ranked;
+	STDev::map<int, int> plain;
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> dist(0, N * 10);
+	for (int i = 0; i < N; i++)
+	{
+		int key = dist(rng);
+		ranked.insert(key, i);
+		plain.insert(key, i);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	long long checksum_plain = 0;
+	for (int q = 0; q < QUERIES / 100; q++)
+	{
+		auto it = plain.begin();
+		std::advance(it, plain.size() * (50 + q) / 100);
+		checksum_plain += it->first;
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto plain_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	long long checksum_ranked = 0;
+	for (int q = 0; q < QUERIES; q++)
+		checksum_ranked += ranked.nth(ranked.size() * (50 + q % 50) / 100)->first;
+	end = std::chrono::high_resolution_clock::now();
+	auto ranked_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> insert_plain;
+	for (int i = 0; i < N; i++)
+		insert_plain.insert(dist(rng), i);
+	end = std::chrono::high_resolution_clock::now();
+	auto insert_plain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic> insert_ranked;
+	for (int i = 0; i < N; i++)
+		insert_ranked.insert(dist(rng), i);
+	end = std::chrono::high_resolution_clock::now();
+	auto insert_ranked_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " chiavi casuali:" << std::endl;
+	std::cout << "  percentile con std::advance: " << plain_us / (QUERIES / 100) << " us/query" << std::endl;
+	std::cout << "  percentile con nth:          " << std::fixed << std::setprecision(2)
+		<< static_cast<double>(ranked_us) / QUERIES << " us/query" << std::endl;
+	std::cout << "  insert senza policy:         " << insert_plain_ms << " ms" << std::endl;
+	std::cout << "  insert con OrderStatistic:   " << insert_ranked_ms << " ms" << std::endl;
+	std::cout << "  (checksum " << checksum_plain + checksum_ranked << ")" << std::endl;
+}
+
+void benchmark_interval_queries()
+{
+	section_header("BENCHMARK 12: OVERLAP QUERY (INTERVAL TREE) VS SCANSIONE");
+
+	const int N = 200000;
+	const int QUERIES = 2000;
+
+	// sessioni: inizio casuale, durata breve
+	STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::IntervalTree> sessions;
+	STDev::map<int, int> plain;
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> start_dist(0, N * 50);
+	std::uniform_int_distribution<int> length_dist(1, 500);
+	for (int i = 0; i < N; i++)
+	{
+		int start = start_dist(rng);
+		int end = start + length_dist(rng);
+		sessions.insert(start, end);
+		plain.insert(start, end);
+	}
+
+	std::vector<int> probes;
+	for (int q = 0; q < QUERIES; q++)
+		probes.push_back(start_dist(rng));
+
+	// senza aumento: tutto cio' che inizia prima di hi va controllato
+	auto start = std::chrono::high_resolution_clock::now();
+	long long found_scan = 0;
+	for (int q = 0; q < QUERIES / 20; q++)
+	{
+		int lo = probes[q];
+		int hi = lo + 100;
+		for (auto it = plain.begin(); it != plain.end() && it->first < hi; ++it)
+		{
+			if (lo < it->second)
+				found_scan++;
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	auto scan_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	long long found_tree = 0;
+	for (int q = 0; q < QUERIES; q++)
+	{
+		int lo = probes[q];
+		sessions.overlapping(lo, lo + 100, [&](const std::pair<const int, int>&) { found_tree++; });
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto tree_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	std::cout << "\n" << N << " intervalli, query di ampiezza 100:" << std::endl;
+	std::cout << "  scansione da begin():  " << scan_us / (QUERIES / 20) << " us/query" << std::endl;
+	std::cout << "  overlapping():         " << std::fixed << std::setprecision(2)
+		<< static_cast<double>(tree_us) / QUERIES << " us/query" << std::endl;
+	std::cout << "  (sovrapposizioni: " << found_scan << " in " << QUERIES / 20 << " scansioni, "
+		<< found_tree << " in " << QUERIES << " query)" << std::endl;
+}
+
+void benchmark_arena_allocator()
+{
+	section_header("BENCHMARK 13: ARENA ALLOCATOR - INSERT / CLEAR");
+
+	const int N = 1000000;
+	std::vector<int> keys(N);
+	for (int i = 0; i < N; i++)
+		keys[i] = i;
+	std::mt19937 rng(9);
+	std::shuffle(keys.begin(), keys.end(), rng);
+
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+		STDev::arena_allocator<std::pair<const int, int>>> ArenaMap;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> plain;
+	for (int key : keys)
+		plain.insert(key, key);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto plain_insert_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	plain.clear();
+	end = std::chrono::high_resolution_clock::now();
+	auto plain_clear_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	ArenaMap arena;
+	for (int key : keys)
+		arena.insert(key, key);
+	end = std::chrono::high_resolution_clock::now();
+	auto arena_insert_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+	size_t arena_bytes = arena.get_allocator().resource().bytes_reserved();
+
+	start = std::chrono::high_resolution_clock::now();
+	arena.clear();
+	end = std::chrono::high_resolution_clock::now();
+	auto arena_clear_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	std::cout << "\n" << N << " chiavi casuali, map<int, int> RB-Tree (nodo da 32 byte):" << std::endl;
+	std::cout << "  std::allocator:   insert " << plain_insert_ms << " ms, clear " << plain_clear_us << " us" << std::endl;
+	std::cout << "  arena_allocator:  insert " << arena_insert_ms << " ms, clear " << arena_clear_us << " us" << std::endl;
+	std::cout << "  memoria arena: " << arena_bytes / (1024 * 1024) << " MB ("
+		<< arena_bytes / N << " byte/nodo, malloc aggiunge ~16 byte di header per nodo)" << std::endl;
+}
+
+void benchmark_copy()
+{
+	section_header("BENCHMARK 14: SNAPSHOT (COPY) DI UNA MAP GRANDE");
+
+	const int N = 2000000;
+
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::NoAugment,
+		STDev::arena_allocator<std::pair<const int, int>>> ArenaMap;
+
+	std::vector<std::pair<int, int>> sorted;
+	for (int i = 0; i < N; i++)
+		sorted.push_back({ i * 2, i });
+	auto plain = STDev::map<int, int>::from_sorted(sorted.begin(), sorted.end());
+	auto arena = ArenaMap::from_sorted(sorted.begin(), sorted.end());
+
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> plain_copy(plain);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto plain_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	ArenaMap arena_copy(arena);
+	end = std::chrono::high_resolution_clock::now();
+	auto arena_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	// riferimento: copiare gli stessi byte con memcpy
+	std::vector<char> from(static_cast<size_t>(N) * 32, 1);
+	std::vector<char> to(from.size());
+	start = std::chrono::high_resolution_clock::now();
+	std::copy(from.begin(), from.end(), to.begin());
+	end = std::chrono::high_resolution_clock::now();
+	auto memcpy_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " elementi (" << from.size() / (1024 * 1024) << " MB di nodi):" << std::endl;
+	std::cout << "  copia con std::allocator:   " << plain_ms << " ms" << std::endl;
+	std::cout << "  copia con arena_allocator:  " << arena_ms << " ms (un solo slab)" << std::endl;
+	std::cout << "  memcpy degli stessi byte:   " << memcpy_ms << " ms" << std::endl;
+	std::cout << "  (" << plain_copy.size() + arena_copy.size() + to[to.size() / 2] << ")" << std::endl;
+}
+
+void benchmark_shard_rebalance()
+{
+	section_header("BENCHMARK 15: SPOSTAMENTO DI UN RANGE TRA SHARD - SPLIT / JOIN VS ERASE + INSERT");
+
+	const int N = 1000000;
+	const int SPLIT_KEY = N / 2;
+
+	auto make_shards = [N](STDev::map<int, int>& first, STDev::map<int, int>& second)
+	{
+		std::vector<std::pair<int, int>> low;
+		std::vector<std::pair<int, int>> high;
+		for (int i = 0; i < N; i++)
+			low.push_back({ i, i });
+		for (int i = N; i < N + N / 2; i++)
+			high.push_back({ i, i });
+		first = STDev::map<int, int>::from_sorted(low.begin(), low.end());
+		second = STDev::map<int, int>::from_sorted(high.begin(), high.end());
+	};
+
+	// shard A = [0, N), shard B = [N, 1.5N): le chiavi >= N/2 passano da A a B
+	STDev::map<int, int> a;
+	STDev::map<int, int> b;
+	make_shards(a, b);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (auto it = a.lower_bound(SPLIT_KEY); it != a.end(); ++it)
+		b.insert(it->first, it->second);
+	a.erase(a.lower_bound(SPLIT_KEY), a.end());
+	auto end = std::chrono::high_resolution_clock::now();
+	auto naive_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+	size_t naive_sizes[2] = { a.size(), b.size() };
+
+	make_shards(a, b);
+	start = std::chrono::high_resolution_clock::now();
+	auto parts = a.split(SPLIT_KEY);
+	parts.second.join(std::move(b));
+	a = std::move(parts.first);
+	b = std::move(parts.second);
+	end = std::chrono::high_resolution_clock::now();
+	auto split_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	size_t split_sizes[2] = { a.size(), b.size() };
+
+	std::cout << "\n" << N - SPLIT_KEY << " chiavi spostate (shard da " << N << " e " << N / 2 << "):" << std::endl;
+	std::cout << "  erase + insert:  " << naive_ms << " ms" << std::endl;
+	std::cout << "  split + join:    " << split_us << " us (senza OrderStatistic si conta la parte piu' piccola)" << std::endl;
+	std::cout << "  shard: " << naive_sizes[0] << " / " << naive_sizes[1] << " vs " << split_sizes[0] << " / " << split_sizes[1] << std::endl;
+
+	typedef STDev::map<int, int, STDev::TreeType::RedBlackTree, std::less<int>, STDev::OrderStatistic> CountedMap;
+	std::vector<std::pair<int, int>> pairs;
+	for (int i = 0; i < N; i++)
+		pairs.push_back({ i, i });
+	auto counted = CountedMap::from_sorted(pairs.begin(), pairs.end());
+	start = std::chrono::high_resolution_clock::now();
+	auto counted_parts = counted.split(SPLIT_KEY);
+	counted_parts.first.join(std::move(counted_parts.second));
+	end = std::chrono::high_resolution_clock::now();
+	auto counted_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "  split + join con OrderStatistic (tutto O(log n)): " << counted_us << " us (" << counted_parts.first.size() << ")" << std::endl;
+}
+
+void benchmark_find_batch()
+{
+	section_header("BENCHMARK 16: FIND_BATCH VS FIND IN UN CICLO");
+
+	const int LOOKUPS = 2000000;
+	const int sizes[] = { 10000, 1000000, 4000000 };
+	const size_t blocks[] = { 64, 256, 1024 };
+
+	for (int n : sizes)
+	{
+		std::mt19937 rng(n);
+		std::uniform_int_distribution<int> dist(0, n * 2);
+		STDev::map<int, int> m;
+		for (int i = 0; i < n; i++)
+			m.insert(dist(rng), i);
+
+		std::vector<int> queries(LOOKUPS);
+		for (int& query : queries)
+			query = dist(rng);
+
+		long long scalar_sum = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+		{
+			auto it = m.find(query);
+			if (it != m.end())
+				scalar_sum += it->second;
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		auto scalar_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		std::cout << "\n" << m.size() << " chiavi, " << LOOKUPS << " ricerche casuali:" << std::endl;
+		std::cout << "  find in un ciclo:       " << scalar_ns << " ns/chiave" << std::endl;
+
+		for (size_t block : blocks)
+		{
+			std::vector<STDev::map<int, int>::iterator> results(block);
+			long long batch_sum = 0;
+			start = std::chrono::high_resolution_clock::now();
+			for (size_t first = 0; first < queries.size(); first += block)
+			{
+				size_t count = std::min(block, queries.size() - first);
+				m.find_batch(queries.data() + first, count, results.data());
+				for (size_t i = 0; i < count; i++)
+				{
+					if (results[i] != m.end())
+						batch_sum += results[i]->second;
+				}
+			}
+			end = std::chrono::high_resolution_clock::now();
+			auto batch_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+			std::cout << "  find_batch (blocchi da " << std::setw(4) << block << "): " << batch_ns << " ns/chiave"
+				<< (batch_sum == scalar_sum ? "" : "  RISULTATI DIVERSI!") << std::endl;
+		}
+	}
+}
+
 void benchmark_comparison_visual()
 {
 	section_header("BENCHMARK 5: VISUAL COMPARISON");
@@ -698,6 +2670,19 @@ int main()
 	test_edge_cases();
 	test_different_types();
 	test_bst_vs_rbtree();
+	test_avl_tree();
+	test_try_emplace_and_insert_or_assign();
+	test_bidirectional_iterators();
+	test_bounds_and_range_queries();
+	test_comparator_and_transparent_lookup();
+	test_from_sorted_and_bulk_insert();
+	test_hinted_insert();
+	test_order_statistic();
+	test_interval_and_prefix_sum();
+	test_arena_allocator();
+	test_deep_copy_and_teardown();
+	test_split_and_join();
+	test_find_batch();
 
 	// Print test summary
 	g_stats.print_summary();
@@ -713,6 +2698,17 @@ int main()
 	benchmark_worst_case();
 	benchmark_delete();
 	benchmark_comparison_visual();
+	benchmark_read_heavy();
+	benchmark_counter_aggregation();
+	benchmark_range_queries();
+	benchmark_bulk_load();
+	benchmark_hinted_ingest();
+	benchmark_order_statistic();
+	benchmark_interval_queries();
+	benchmark_arena_allocator();
+	benchmark_copy();
+	benchmark_shard_rebalance();
+	benchmark_find_batch();
 
 	std::cout << "\n";
 	std::cout << "========================================" << std::endl;
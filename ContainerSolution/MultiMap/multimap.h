@@ -0,0 +1,140 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "map.h"
+
+namespace STDev
+{
+	// Map con chiavi duplicate (indici secondari). Eredita privatamente da map: nodi, rotazioni,
+	// ribilanciamento RB/AVL, iteratori e allocator sono gli stessi, cambiano solo inserimento
+	// (insert_equal) e cancellazione per chiave (erase_equal).
+	// Gli elementi con chiave uguale restano nell'ordine di inserimento.
+	// Non ci sono operator[], at, insert_or_assign e try_emplace: con chiavi duplicate
+	// "il valore della chiave" non e' definito.
+	template<typename K, typename T, TreeType Type = TreeType::RedBlackTree, typename Compare = std::less<K>,
+		typename Allocator = std::allocator<std::pair<const K, T>>>
+	class multimap : private map<K, T, Type, Compare, NoAugment, Allocator>
+	{
+	private:
+
+		typedef map<K, T, Type, Compare, NoAugment, Allocator> Tree;
+
+	public:
+
+		typedef typename Tree::iterator iterator;
+		typedef typename Tree::const_iterator const_iterator;
+		typedef typename Tree::reverse_iterator reverse_iterator;
+		typedef typename Tree::const_reverse_iterator const_reverse_iterator;
+
+		multimap() : Tree()
+		{}
+
+		explicit multimap(const Compare& compare, const Allocator& alloc = Allocator()) : Tree(compare, alloc)
+		{}
+
+		explicit multimap(const Allocator& alloc) : Tree(alloc)
+		{}
+
+		// inserisce sempre, dopo gli elementi con la stessa chiave. O(log n), O(1) in coda
+		iterator insert(const K& key, const T& value)
+		{
+			return Tree::insert_equal(key, value);
+		}
+
+		// costruisce il valore da args direttamente nel nodo
+		template<typename... Args>
+		iterator emplace(const K& key, Args&&... args)
+		{
+			return Tree::insert_equal(key, std::forward<Args>(args)...);
+		}
+
+		// inserisce le coppie di [first, last) nell'ordine dato
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			for (; first != last; ++first)
+				Tree::insert_equal(first->first, first->second);
+		}
+
+		// primo elemento (in ordine di inserimento) con chiave key
+		iterator find(const K& key)
+		{
+			iterator it = Tree::lower_bound(key);
+			if (it != end() && !key_comp()(key, it->first))
+				return it;
+			return end();
+		}
+
+		const_iterator find(const K& key) const
+		{
+			const_iterator it = Tree::lower_bound(key);
+			if (it != end() && !key_comp()(key, it->first))
+				return it;
+			return end();
+		}
+
+		bool contains(const K& key) const
+		{
+			return find(key) != end();
+		}
+
+		// O(log n + k)
+		size_t count(const K& key) const
+		{
+			auto range = Tree::equal_range(key);
+			return static_cast<size_t>(std::distance(range.first, range.second));
+		}
+
+		// rimuove tutte le coppie con chiave key e ritorna quante erano, O(log n + k)
+		size_t erase(const K& key)
+		{
+			return Tree::erase_equal(key);
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return Tree::erase(pos);
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			return Tree::erase(first, last);
+		}
+
+		using Tree::lower_bound;
+		using Tree::upper_bound;
+		using Tree::equal_range;
+		using Tree::for_each_in_range;
+
+		using Tree::begin;
+		using Tree::end;
+		using Tree::cbegin;
+		using Tree::cend;
+		using Tree::rbegin;
+		using Tree::rend;
+		using Tree::crbegin;
+		using Tree::crend;
+
+		using Tree::size;
+		using Tree::empty;
+		using Tree::clear;
+		using Tree::key_comp;
+		using Tree::get_allocator;
+
+		// le chiavi uguali sono ammesse: validazione con ordine non decrescente
+		bool is_valid_rb_tree() const
+		{
+			return Tree::valid_rb_tree(true);
+		}
+
+		bool is_valid_avl_tree() const
+		{
+			return Tree::valid_avl_tree(true);
+		}
+
+		using Tree::height;
+		using Tree::print_tree;
+	};
+}
@@ -0,0 +1,360 @@
+#include "multimap.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <map>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+template<typename Map>
+std::vector<std::pair<int, int>> contents(const Map& m)
+{
+	std::vector<std::pair<int, int>> result;
+	for (const auto& pair : m)
+		result.push_back({ pair.first, pair.second });
+	return result;
+}
+
+// ==================== TESTS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: BASIC OPERATIONS");
+
+	multimap<std::string, int> m;
+	test_assert(m.empty() && m.begin() == m.end(), "New multimap is empty");
+
+	m.insert("red", 1);
+	m.insert("blue", 2);
+	m.insert("red", 3);
+	m.emplace("red", 4);
+	test_assert(m.size() == 4 && m.count("red") == 3 && m.count("blue") == 1 && m.count("green") == 0, "Duplicate keys are kept");
+	test_assert(m.contains("blue") && !m.contains("green"), "contains");
+
+	auto it = m.find("red");
+	test_assert(it != m.end() && it->second == 1, "find returns the first inserted");
+	test_assert(m.find("green") == m.end(), "find on missing key");
+
+	auto range = m.equal_range("red");
+	std::vector<int> values;
+	for (auto r = range.first; r != range.second; ++r)
+		values.push_back(r->second);
+	test_assert(values == std::vector<int>({ 1, 3, 4 }), "equal_range in insertion order");
+
+	it->second = 10;
+	test_assert(m.find("red")->second == 10, "Values are writable through iterators");
+
+	test_assert(m.erase("red") == 3 && m.size() == 1 && !m.contains("red"), "erase(key) removes all duplicates");
+	test_assert(m.erase("red") == 0, "erase(key) on missing key");
+
+	m.clear();
+	test_assert(m.empty(), "clear()");
+}
+
+template<TreeType Type>
+void check_stable_order(const std::string& name)
+{
+	multimap<int, int, Type> m;
+	std::mt19937 rng(46);
+	std::uniform_int_distribution<int> key_dist(0, 50);
+
+	for (int i = 0; i < 5000; i++)
+		m.insert(key_dist(rng), i);
+
+	bool stable = true;
+	auto previous = m.begin();
+	for (auto it = std::next(m.begin()); it != m.end(); ++it, ++previous)
+	{
+		if (previous->first > it->first || (previous->first == it->first && previous->second > it->second))
+			stable = false;
+	}
+	test_assert(stable && m.size() == 5000, name + ": equal keys keep insertion order");
+}
+
+void test_stable_order()
+{
+	section_header("TEST 2: INSERTION ORDER FOR EQUAL KEYS");
+
+	check_stable_order<TreeType::RedBlackTree>("RB-Tree");
+	check_stable_order<TreeType::AdelsonVelskyLandisTree>("AVL-Tree");
+	check_stable_order<TreeType::BinarySearchTree>("BST");
+
+	// le chiavi uguali in coda non scendono dalla radice
+	multimap<int, int> m;
+	for (int i = 0; i < 10; i++)
+		m.insert(7, i);
+	test_assert(m.begin()->second == 0 && std::prev(m.end())->second == 9, "Appending equal keys at the end");
+
+	// tante chiavi uguali finiscono in nodi adiacenti: la validazione le accetta
+	multimap<int, int, TreeType::RedBlackTree> rb;
+	multimap<int, int, TreeType::AdelsonVelskyLandisTree> avl;
+	for (int i = 0; i < 1000; i++)
+	{
+		rb.insert(i % 3, i);
+		avl.insert(i % 3, i);
+	}
+	test_assert(rb.is_valid_rb_tree() && avl.is_valid_avl_tree(), "Validators accept equal adjacent keys");
+}
+
+void test_erase_iterators()
+{
+	section_header("TEST 3: ERASE BY ITERATOR");
+
+	multimap<int, int> m;
+	for (int i = 0; i < 10; i++)
+		m.insert(i % 3, i);
+
+	// rimuove solo il secondo elemento con chiave 1
+	auto it = std::next(m.find(1));
+	it = m.erase(it);
+	test_assert(m.count(1) == 2 && it->first == 1 && it->second == 7, "erase(iterator) removes a single duplicate");
+
+	auto range = m.equal_range(0);
+	auto after = m.erase(range.first, range.second);
+	test_assert(m.count(0) == 0 && after == m.find(1) && m.size() == 5, "erase(first, last)");
+
+	int visited = 0;
+	m.for_each_in_range(1, 3, [&visited](const std::pair<const int, int>&) { visited++; });
+	test_assert(visited == 5, "for_each_in_range visits duplicates");
+}
+
+template<TreeType Type>
+void check_against_std(const std::string& name)
+{
+	multimap<int, int, Type> m;
+	std::multimap<int, int> reference;
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> key_dist(0, 500);
+	bool counts_match = true;
+
+	for (int step = 0; step < 30000; step++)
+	{
+		int key = key_dist(rng);
+		if (step % 4 == 0)
+		{
+			if (m.erase(key) != reference.erase(key))
+				counts_match = false;
+		}
+		else if (step % 4 == 1)
+		{
+			auto it = m.find(key);
+			auto ref = reference.find(key);
+			if ((it == m.end()) != (ref == reference.end()))
+			{
+				counts_match = false;
+			}
+			else if (it != m.end())
+			{
+				// std::multimap::find puo' tornare un duplicato qualsiasi: si toglie il primo in entrambi
+				m.erase(it);
+				reference.erase(reference.lower_bound(key));
+			}
+		}
+		else
+		{
+			m.insert(key, step);
+			reference.insert({ key, step });
+		}
+
+		if (step % 1000 == 0 && m.count(key) != reference.count(key))
+			counts_match = false;
+	}
+
+	std::vector<std::pair<int, int>> expected(reference.begin(), reference.end());
+	test_assert(counts_match && contents(m) == expected && m.size() == reference.size(), name + ": matches std::multimap");
+	test_assert(m.is_valid_rb_tree() && m.is_valid_avl_tree(), name + ": tree invariants hold");
+}
+
+void test_random_operations()
+{
+	section_header("TEST 4: RANDOM OPERATIONS VS std::multimap");
+
+	check_against_std<TreeType::RedBlackTree>("RB-Tree");
+	check_against_std<TreeType::AdelsonVelskyLandisTree>("AVL-Tree");
+	check_against_std<TreeType::BinarySearchTree>("BST");
+}
+
+void test_copy_and_move()
+{
+	section_header("TEST 5: COPY AND MOVE");
+
+	multimap<int, std::string> m;
+	m.insert(1, "a");
+	m.insert(1, "b");
+	m.insert(2, "c");
+
+	multimap<int, std::string> copy(m);
+	m.insert(1, "d");
+	test_assert(copy.count(1) == 2 && m.count(1) == 3, "Copy is independent");
+
+	multimap<int, std::string> moved(std::move(m));
+	test_assert(moved.size() == 4 && m.empty(), "Move");
+
+	copy = moved;
+	test_assert(copy.size() == 4 && std::prev(copy.equal_range(1).second)->second == "d", "Copy assignment");
+}
+
+// ==================== BENCHMARKS ====================
+
+void benchmark_secondary_index()
+{
+	section_header("BENCHMARK 1: INDICE SECONDARIO - multimap VS std::multimap");
+
+	const int N = 1000000;
+	const int DISTINCT = 1000; // ~1000 duplicati per chiave
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> dist(0, DISTINCT - 1);
+	std::vector<int> keys(N);
+	for (int& key : keys)
+		key = dist(rng);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	multimap<int, int> index;
+	for (int i = 0; i < N; i++)
+		index.insert(keys[i], i);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto stdev_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	std::multimap<int, int> reference;
+	for (int i = 0; i < N; i++)
+		reference.insert({ keys[i], i });
+	end = std::chrono::high_resolution_clock::now();
+	auto std_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	long long checksum = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int key = 0; key < DISTINCT; key += 10)
+	{
+		auto range = index.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+			checksum += it->second;
+	}
+	end = std::chrono::high_resolution_clock::now();
+	auto stdev_scan = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	size_t erased = 0;
+	for (int key = 0; key < DISTINCT; key += 2)
+		erased += index.erase(key);
+	end = std::chrono::high_resolution_clock::now();
+	auto stdev_erase = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	size_t std_erased = 0;
+	for (int key = 0; key < DISTINCT; key += 2)
+		std_erased += reference.erase(key);
+	end = std::chrono::high_resolution_clock::now();
+	auto std_erase = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " elementi, " << DISTINCT << " chiavi distinte:" << std::endl;
+	std::cout << "  insert:        multimap " << stdev_insert << " ms, std::multimap " << std_insert << " ms" << std::endl;
+	std::cout << "  equal_range:   100 chiavi in " << stdev_scan << " us (checksum " << checksum << ")" << std::endl;
+	std::cout << "  erase(key):    multimap " << stdev_erase << " ms, std::multimap " << std_erase << " ms ("
+		<< erased << " / " << std_erased << " elementi)" << std::endl;
+}
+
+// ==================== VISUAL DEMO ====================
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	// indice secondario: citta' -> id dell'utente
+	multimap<std::string, int> by_city;
+	by_city.insert("Milano", 17);
+	by_city.insert("Roma", 4);
+	by_city.insert("Milano", 3);
+	by_city.insert("Torino", 8);
+	by_city.insert("Milano", 21);
+
+	std::cout << "Utenti a Milano (" << by_city.count("Milano") << "):";
+	auto range = by_city.equal_range("Milano");
+	for (auto it = range.first; it != range.second; ++it)
+		std::cout << " " << it->second;
+	std::cout << std::endl;
+
+	std::cout << "Indice completo:" << std::endl;
+	for (const auto& pair : by_city)
+		std::cout << "  " << pair.first << " -> " << pair.second << std::endl;
+}
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   MULTIMAP TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_stable_order();
+	test_erase_iterators();
+	test_random_operations();
+	test_copy_and_move();
+
+	g_stats.print_summary();
+
+	benchmark_secondary_index();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "map.h"
+#include "set.h"
+
+namespace STDev
+{
+	// valore vuoto nei nodi di multiset: map<int, multiset_slot> ha nodi da 32 byte come set<int>
+	struct multiset_slot
+	{};
+
+	// Set con chiavi duplicate. Come multimap eredita privatamente da map (con un valore vuoto),
+	// quindi usa il ribilanciamento di map; SetTreeType sceglie tra RedBlackTree e
+	// BinarySearchTree come in set. Le chiavi uguali restano nell'ordine di inserimento.
+	template<typename K, SetTreeType Type = SetTreeType::RedBlackTree, typename Compare = std::less<K>,
+		typename Allocator = std::allocator<K>>
+	class multiset : private map<K, multiset_slot,
+		Type == SetTreeType::RedBlackTree ? TreeType::RedBlackTree : TreeType::BinarySearchTree, Compare, NoAugment,
+		typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const K, multiset_slot>>>
+	{
+	private:
+
+		typedef map<K, multiset_slot,
+			Type == SetTreeType::RedBlackTree ? TreeType::RedBlackTree : TreeType::BinarySearchTree, Compare, NoAugment,
+			typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const K, multiset_slot>>> Tree;
+
+		typedef typename Tree::const_iterator TreeIterator;
+
+	public:
+
+		// iteratore bidirezionale sulle sole chiavi: avvolge quello di map (due puntatori)
+		class iterator
+		{
+		private:
+			TreeIterator it;
+
+			explicit iterator(TreeIterator position) : it(position)
+			{}
+
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef K value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const K* pointer;
+			typedef const K& reference;
+
+			iterator()
+			{}
+
+			const K& operator*() const
+			{
+				return it->first;
+			}
+
+			const K* operator->() const
+			{
+				return &(it->first);
+			}
+
+			iterator& operator++()
+			{
+				++it;
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			iterator& operator--()
+			{
+				--it;
+				return *this;
+			}
+
+			iterator operator--(int)
+			{
+				iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return it == other.it;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return it != other.it;
+			}
+
+			friend class multiset;
+		};
+
+		typedef iterator const_iterator;
+
+		multiset() : Tree()
+		{}
+
+		explicit multiset(const Compare& compare, const Allocator& alloc = Allocator()) : Tree(compare, alloc)
+		{}
+
+		explicit multiset(const Allocator& alloc) : Tree(alloc)
+		{}
+
+		// inserisce sempre, dopo le chiavi uguali gia' presenti. O(log n), O(1) in coda
+		iterator insert(const K& key)
+		{
+			return iterator(Tree::insert_equal(key));
+		}
+
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			for (; first != last; ++first)
+				Tree::insert_equal(*first);
+		}
+
+		// prima occorrenza di key
+		iterator find(const K& key) const
+		{
+			TreeIterator position = Tree::lower_bound(key);
+			if (position != Tree::end() && !key_comp()(key, position->first))
+				return iterator(position);
+			return end();
+		}
+
+		bool contains(const K& key) const
+		{
+			return find(key) != end();
+		}
+
+		// O(log n + k)
+		size_t count(const K& key) const
+		{
+			return static_cast<size_t>(std::distance(lower_bound(key), upper_bound(key)));
+		}
+
+		iterator lower_bound(const K& key) const
+		{
+			return iterator(Tree::lower_bound(key));
+		}
+
+		iterator upper_bound(const K& key) const
+		{
+			return iterator(Tree::upper_bound(key));
+		}
+
+		std::pair<iterator, iterator> equal_range(const K& key) const
+		{
+			return { lower_bound(key), upper_bound(key) };
+		}
+
+		// rimuove tutte le occorrenze di key e ritorna quante erano, O(log n + k)
+		size_t erase(const K& key)
+		{
+			return Tree::erase_equal(key);
+		}
+
+		// rimuove una sola occorrenza
+		iterator erase(iterator pos)
+		{
+			return iterator(Tree::erase(pos.it));
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			return iterator(Tree::erase(first.it, last.it));
+		}
+
+		iterator begin() const
+		{
+			return iterator(Tree::begin());
+		}
+
+		iterator end() const
+		{
+			return iterator(Tree::end());
+		}
+
+		using Tree::size;
+		using Tree::empty;
+		using Tree::clear;
+		using Tree::key_comp;
+
+		Allocator get_allocator() const
+		{
+			return Allocator(Tree::get_allocator());
+		}
+
+		bool is_valid_rb_tree() const
+		{
+			return Tree::valid_rb_tree(true);
+		}
+
+		using Tree::height;
+	};
+}
@@ -0,0 +1,248 @@
+#include "multiset.h"
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <set>
+#include <type_traits>
+
+using namespace STDev;
+
+// ==================== TEST FUNCTIONS ====================
+
+void test_basic_insert()
+{
+	std::cout << "Test: inserimento con duplicati... ";
+	multiset<int> s;
+
+	assert(s.empty());
+	assert(s.begin() == s.end());
+
+	s.insert(5);
+	s.insert(3);
+	s.insert(5);
+	s.insert(5);
+	s.insert(7);
+
+	assert(s.size() == 5);
+	assert(s.count(5) == 3);
+	assert(s.count(3) == 1);
+	assert(s.count(4) == 0);
+	assert(s.contains(7) && !s.contains(6));
+
+	std::vector<int> values(s.begin(), s.end());
+	assert(values == std::vector<int>({ 3, 5, 5, 5, 7 }));
+
+	std::cout << "OK\n";
+}
+
+void test_equal_range_and_erase()
+{
+	std::cout << "Test: equal_range ed erase... ";
+	multiset<int> s;
+
+	for (int i = 0; i < 100; i++)
+	{
+		s.insert(i % 10);
+	}
+	assert(s.size() == 100);
+
+	auto range = s.equal_range(4);
+	assert(std::distance(range.first, range.second) == 10);
+	assert(*range.first == 4 && *range.second == 5);
+
+	// una sola occorrenza
+	auto next = s.erase(s.find(4));
+	assert(*next == 4 && s.count(4) == 9);
+
+	// tutte le occorrenze
+	assert(s.erase(4) == 9);
+	assert(s.erase(4) == 0);
+	assert(!s.contains(4) && s.size() == 90);
+
+	range = s.equal_range(0);
+	s.erase(range.first, range.second);
+	assert(s.count(0) == 0 && *s.begin() == 1);
+
+	assert(*s.lower_bound(4) == 5 && *s.upper_bound(8) == 9 && s.upper_bound(9) == s.end());
+
+	std::cout << "OK\n";
+}
+
+// chiave con un campo che non partecipa al confronto: rende visibile l'ordine dei duplicati
+struct Tagged
+{
+	int key;
+	int tag;
+};
+
+struct TaggedLess
+{
+	bool operator()(const Tagged& a, const Tagged& b) const
+	{
+		return a.key < b.key;
+	}
+};
+
+void test_stable_order()
+{
+	std::cout << "Test: ordine di inserimento dei duplicati... ";
+	multiset<Tagged, SetTreeType::RedBlackTree, TaggedLess> s;
+
+	std::mt19937 rng(46);
+	std::uniform_int_distribution<int> dist(0, 20);
+	for (int i = 0; i < 2000; i++)
+	{
+		s.insert({ dist(rng), i });
+	}
+
+	bool stable = true;
+	const Tagged* previous = nullptr;
+	for (const Tagged& t : s)
+	{
+		if (previous && (previous->key > t.key || (previous->key == t.key && previous->tag > t.tag)))
+			stable = false;
+		previous = &t;
+	}
+	assert(stable);
+	assert(s.find({ 3, 0 })->tag == s.lower_bound({ 3, 0 })->tag);
+
+	std::cout << "OK\n";
+}
+
+template<SetTreeType Type>
+void check_against_std()
+{
+	multiset<int, Type> s;
+	std::multiset<int> reference;
+
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> dist(0, 300);
+	for (int step = 0; step < 20000; step++)
+	{
+		int key = dist(rng);
+		if (step % 3 == 0)
+		{
+			assert(s.erase(key) == reference.erase(key));
+		}
+		else
+		{
+			s.insert(key);
+			reference.insert(key);
+		}
+	}
+
+	assert(s.size() == reference.size());
+	assert(std::equal(s.begin(), s.end(), reference.begin(), reference.end()));
+	for (int key = 0; key <= 300; key += 7)
+	{
+		assert(s.count(key) == reference.count(key));
+	}
+}
+
+void test_random_operations()
+{
+	std::cout << "Test: operazioni casuali vs std::multiset... ";
+
+	check_against_std<SetTreeType::RedBlackTree>();
+	check_against_std<SetTreeType::BinarySearchTree>();
+
+	std::cout << "OK\n";
+}
+
+void test_iterators()
+{
+	std::cout << "Test: iteratori bidirezionali... ";
+
+	static_assert(std::is_trivially_copyable<multiset<int>::iterator>::value, "multiset iterator must be trivially copyable");
+
+	multiset<int> s;
+	std::vector<int> input = { 4, 1, 4, 2, 4, 3 };
+	s.insert(input.begin(), input.end());
+
+	std::vector<int> backwards;
+	for (auto it = s.end(); it != s.begin();)
+	{
+		--it;
+		backwards.push_back(*it);
+	}
+	assert(backwards == std::vector<int>({ 4, 4, 4, 3, 2, 1 }));
+	assert(*std::prev(s.end()) == 4);
+
+	std::cout << "OK\n";
+}
+
+void test_copy_and_move()
+{
+	std::cout << "Test: copy e move... ";
+	multiset<std::string> s;
+
+	s.insert("b");
+	s.insert("a");
+	s.insert("b");
+
+	multiset<std::string> copy(s);
+	s.insert("b");
+	assert(copy.count("b") == 2 && s.count("b") == 3);
+
+	multiset<std::string> moved(std::move(s));
+	assert(moved.size() == 4 && s.empty());
+
+	copy = moved;
+	assert(copy.size() == 4 && copy.count("b") == 3);
+
+	std::cout << "OK\n";
+}
+
+void test_visual_demonstration()
+{
+	std::cout << "\n=== DIMOSTRAZIONE VISIVA ===" << std::endl;
+
+	multiset<int> scores;
+	std::vector<int> input = { 30, 18, 30, 25, 18, 30 };
+	scores.insert(input.begin(), input.end());
+
+	std::cout << "\nPunteggi: ";
+	for (int v : scores)
+	{
+		std::cout << v << " ";
+	}
+	std::cout << "\nOccorrenze di 30: " << scores.count(30) << std::endl;
+
+	scores.erase(30);
+	std::cout << "Dopo erase(30): ";
+	for (int v : scores)
+	{
+		std::cout << v << " ";
+	}
+	std::cout << "\n" << std::endl;
+}
+
+// ==================== MAIN ====================
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   MULTISET TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	test_basic_insert();
+	test_equal_range_and_erase();
+	test_stable_order();
+	test_random_operations();
+	test_iterators();
+	test_copy_and_move();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "       TUTTI I TEST SONO PASSATI!" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_visual_demonstration();
+
+	return 0;
+}
@@ -0,0 +1,476 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace STDev
+{
+	// Map persistente: AVL-Tree con nodi immutabili e condivisi tra versioni.
+	// Un aggiornamento non modifica mai un nodo esistente: copia solo il percorso dalla radice
+	// al punto modificato (O(log n) nodi) e riusa tutti gli altri sottoalberi. Copiare la map
+	// o prenderne uno snapshot() costa O(1): si incrementa il contatore della radice.
+	//
+	// Concorrenza:
+	// - i nodi hanno un contatore di riferimenti atomico, quindi versioni diverse possono
+	//   essere lette, copiate e distrutte da thread diversi senza lock
+	// - un singolo oggetto persistent_map non e' sincronizzato: chi scrive lavora sulla propria
+	//   copia e passa ai lettori uno snapshot() (anche attraverso un lock tenuto per O(1))
+	// - gli iteratori restano validi finche' vive la versione da cui sono stati presi
+	template<typename K, typename T, typename Compare = std::less<K>>
+	class persistent_map
+	{
+	private:
+
+		typedef std::pair<const K, T> value_type;
+
+		struct Node
+		{
+			value_type data;
+			const Node* left;
+			const Node* right;
+			int height;
+			mutable std::atomic<size_t> refs;
+
+			Node(const K& key, const T& value, const Node* l, const Node* r)
+				: data(key, value), left(l), right(r),
+				height(1 + std::max(node_height(l), node_height(r))), refs(1)
+			{}
+		};
+
+		const Node* root;
+		size_t _size;
+		Compare comp;
+
+		static int node_height(const Node* node)
+		{
+			return node != nullptr ? node->height : 0;
+		}
+
+		static const Node* retain(const Node* node)
+		{
+			if (node != nullptr)
+				node->refs.fetch_add(1, std::memory_order_relaxed);
+			return node;
+		}
+
+		// l'ultimo riferimento libera il nodo e rilascia i figli: la profondita' della
+		// ricorsione e' limitata dall'altezza dell'albero
+		static void release(const Node* node)
+		{
+			if (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				release(node->left);
+				release(node->right);
+				delete node;
+			}
+		}
+
+		// Convenzione: ogni funzione che riceve un const Node* "owned" ne consuma il
+		// riferimento e ritorna un riferimento nuovo; i figli passati a make_node sono
+		// gia' stati trattenuti dal chiamante
+		static const Node* make_node(const value_type& data, const Node* left, const Node* right)
+		{
+			return new Node(data.first, data.second, left, right);
+		}
+
+		static const Node* rotate_right(const Node* owned)
+		{
+			const Node* pivot = owned->left;
+			const Node* lowered = make_node(owned->data, retain(pivot->right), retain(owned->right));
+			const Node* result = make_node(pivot->data, retain(pivot->left), lowered);
+			release(owned);
+			return result;
+		}
+
+		static const Node* rotate_left(const Node* owned)
+		{
+			const Node* pivot = owned->right;
+			const Node* lowered = make_node(owned->data, retain(owned->left), retain(pivot->left));
+			const Node* result = make_node(pivot->data, lowered, retain(pivot->right));
+			release(owned);
+			return result;
+		}
+
+		static int balance_factor(const Node* node)
+		{
+			return node_height(node->left) - node_height(node->right);
+		}
+
+		static const Node* rebalance(const Node* owned)
+		{
+			int balance = balance_factor(owned);
+
+			if (balance > 1)
+			{
+				if (balance_factor(owned->left) < 0) // caso sinistra-destra
+				{
+					const Node* fixed = make_node(owned->data, rotate_left(retain(owned->left)), retain(owned->right));
+					release(owned);
+					owned = fixed;
+				}
+				return rotate_right(owned);
+			}
+
+			if (balance < -1)
+			{
+				if (balance_factor(owned->right) > 0) // caso destra-sinistra
+				{
+					const Node* fixed = make_node(owned->data, retain(owned->left), rotate_right(retain(owned->right)));
+					release(owned);
+					owned = fixed;
+				}
+				return rotate_left(owned);
+			}
+
+			return owned;
+		}
+
+		// nuova versione del sottoalbero con key -> value; node (non owned) resta intatto
+		const Node* insert_helper(const Node* node, const K& key, const T& value, bool& inserted) const
+		{
+			if (node == nullptr)
+			{
+				inserted = true;
+				return new Node(key, value, nullptr, nullptr);
+			}
+
+			if (comp(key, node->data.first))
+			{
+				const Node* left = insert_helper(node->left, key, value, inserted);
+				return rebalance(make_node(node->data, left, retain(node->right)));
+			}
+
+			if (comp(node->data.first, key))
+			{
+				const Node* right = insert_helper(node->right, key, value, inserted);
+				return rebalance(make_node(node->data, retain(node->left), right));
+			}
+
+			// chiave esistente: stesso nodo con il valore nuovo, figli condivisi
+			return new Node(node->data.first, value, retain(node->left), retain(node->right));
+		}
+
+		// rimuove il minimo del sottoalbero (non vuoto)
+		static const Node* erase_min(const Node* node)
+		{
+			if (node->left == nullptr)
+				return retain(node->right);
+
+			return rebalance(make_node(node->data, erase_min(node->left), retain(node->right)));
+		}
+
+		// key deve esistere nel sottoalbero
+		const Node* erase_helper(const Node* node, const K& key) const
+		{
+			if (comp(key, node->data.first))
+				return rebalance(make_node(node->data, erase_helper(node->left, key), retain(node->right)));
+
+			if (comp(node->data.first, key))
+				return rebalance(make_node(node->data, retain(node->left), erase_helper(node->right, key)));
+
+			if (node->left == nullptr)
+				return retain(node->right);
+			if (node->right == nullptr)
+				return retain(node->left);
+
+			const Node* successor = node->right;
+			while (successor->left != nullptr)
+				successor = successor->left;
+
+			return rebalance(make_node(successor->data, retain(node->left), erase_min(node->right)));
+		}
+
+		const Node* find_helper(const K& key) const
+		{
+			const Node* node = root;
+			while (node != nullptr)
+			{
+				if (comp(key, node->data.first))
+					node = node->left;
+				else if (comp(node->data.first, key))
+					node = node->right;
+				else
+					return node;
+			}
+			return nullptr;
+		}
+
+		// ritorna l'altezza, -1 se ordine, altezze o bilanciamento sono violati
+		int check_avl_properties(const Node* node) const
+		{
+			if (node == nullptr)
+				return 0;
+
+			if ((node->left && !comp(node->left->data.first, node->data.first)) ||
+				(node->right && !comp(node->data.first, node->right->data.first)))
+			{
+				std::cout << "ERRORE: Ordine violato al nodo [" << node->data.first << "]" << std::endl;
+				return -1;
+			}
+
+			int left_height = check_avl_properties(node->left);
+			int right_height = check_avl_properties(node->right);
+			if (left_height < 0 || right_height < 0)
+				return -1;
+
+			if (node->height != 1 + std::max(left_height, right_height) ||
+				left_height - right_height > 1 || right_height - left_height > 1)
+			{
+				std::cout << "ERRORE: Nodo [" << node->data.first << "] sbilanciato o con altezza errata" << std::endl;
+				return -1;
+			}
+
+			return node->height;
+		}
+
+		size_t count_nodes(const Node* node) const
+		{
+			return node != nullptr ? 1 + count_nodes(node->left) + count_nodes(node->right) : 0;
+		}
+
+	public:
+
+		class const_iterator;
+
+		persistent_map() : root(nullptr), _size(0), comp()
+		{}
+
+		explicit persistent_map(const Compare& compare) : root(nullptr), _size(0), comp(compare)
+		{}
+
+		~persistent_map()
+		{
+			release(root);
+		}
+
+		// O(1): le due map condividono tutti i nodi
+		persistent_map(const persistent_map& other) : root(retain(other.root)), _size(other._size), comp(other.comp)
+		{}
+
+		persistent_map& operator=(const persistent_map& other)
+		{
+			if (this != &other)
+			{
+				const Node* old_root = root;
+				root = retain(other.root);
+				_size = other._size;
+				comp = other.comp;
+				release(old_root);
+			}
+			return *this;
+		}
+
+		persistent_map(persistent_map&& other) noexcept : root(other.root), _size(other._size), comp(std::move(other.comp))
+		{
+			other.root = nullptr;
+			other._size = 0;
+		}
+
+		persistent_map& operator=(persistent_map&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release(root);
+				root = other.root;
+				_size = other._size;
+				comp = std::move(other.comp);
+				other.root = nullptr;
+				other._size = 0;
+			}
+			return *this;
+		}
+
+		// versione immutabile corrente, O(1). Gli aggiornamenti successivi di questa map
+		// non la toccano
+		persistent_map snapshot() const
+		{
+			return *this;
+		}
+
+		// inserisce o sovrascrive (come map::insert), copiando O(log n) nodi
+		void insert(const K& key, const T& value)
+		{
+			bool inserted = false;
+			const Node* new_root = insert_helper(root, key, value, inserted);
+			release(root);
+			root = new_root;
+			if (inserted)
+				_size++;
+		}
+
+		bool erase(const K& key)
+		{
+			if (find_helper(key) == nullptr)
+				return false;
+
+			const Node* new_root = erase_helper(root, key);
+			release(root);
+			root = new_root;
+			_size--;
+			return true;
+		}
+
+		void clear()
+		{
+			release(root);
+			root = nullptr;
+			_size = 0;
+		}
+
+		const_iterator find(const K& key) const
+		{
+			const Node* node = find_helper(key);
+			return node != nullptr ? const_iterator(root, node, comp) : end();
+		}
+
+		bool contains(const K& key) const
+		{
+			return find_helper(key) != nullptr;
+		}
+
+		const T& at(const K& key) const
+		{
+			const Node* node = find_helper(key);
+			if (!node)
+				throw std::out_of_range("persistent_map::at: key not found");
+			return node->data.second;
+		}
+
+		size_t size() const
+		{
+			return _size;
+		}
+
+		bool empty() const
+		{
+			return _size == 0;
+		}
+
+		Compare key_comp() const
+		{
+			return comp;
+		}
+
+		int height() const
+		{
+			return node_height(root);
+		}
+
+		bool is_valid_avl_tree() const
+		{
+			return check_avl_properties(root) >= 0 && count_nodes(root) == _size;
+		}
+
+		// true se le due versioni condividono la radice (nessuna modifica tra le due)
+		bool shares_root_with(const persistent_map& other) const
+		{
+			return root == other.root;
+		}
+
+		// iteratore in ordine: senza parent pointer (un nodo appartiene a piu' versioni).
+		// Il successore e' il minimo del sottoalbero destro o, se manca, si cerca dalla radice
+		// della versione: O(log n) per passo, nessuno stack da portarsi dietro (i nodi sono immutabili)
+		class const_iterator
+		{
+		private:
+			const Node* root;
+			const Node* current;
+			Compare comp;
+
+			const_iterator(const Node* r, const Node* node, const Compare& compare)
+				: root(r), current(node), comp(compare)
+			{}
+
+			static const Node* leftmost(const Node* node)
+			{
+				while (node->left != nullptr)
+					node = node->left;
+				return node;
+			}
+
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef std::pair<const K, T> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const value_type* pointer;
+			typedef const value_type& reference;
+
+			const_iterator() : root(nullptr), current(nullptr), comp()
+			{}
+
+			reference operator*() const
+			{
+				return current->data;
+			}
+
+			pointer operator->() const
+			{
+				return &current->data;
+			}
+
+			const_iterator& operator++()
+			{
+				if (current == nullptr)
+					return *this;
+
+				if (current->right != nullptr)
+				{
+					current = leftmost(current->right);
+					return *this;
+				}
+
+				// l'ultimo antenato in cui si scende a sinistra
+				const Node* successor = nullptr;
+				for (const Node* node = root; node != current;)
+				{
+					if (comp(current->data.first, node->data.first))
+					{
+						successor = node;
+						node = node->left;
+					}
+					else
+					{
+						node = node->right;
+					}
+				}
+				current = successor;
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return current != other.current;
+			}
+
+			friend class persistent_map;
+		};
+
+		const_iterator begin() const
+		{
+			return root != nullptr ? const_iterator(root, const_iterator::leftmost(root), comp) : end();
+		}
+
+		const_iterator end() const
+		{
+			return const_iterator();
+		}
+	};
+}
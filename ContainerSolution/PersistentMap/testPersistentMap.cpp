@@ -0,0 +1,436 @@
+#include "persistent_map.h"
+#include "map.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+template<typename Map>
+std::vector<std::pair<int, int>> contents(const Map& m)
+{
+	std::vector<std::pair<int, int>> result;
+	for (const auto& pair : m)
+		result.push_back({ pair.first, pair.second });
+	return result;
+}
+
+// conta copie e istanze vive: path copying e rilascio dei nodi condivisi
+struct CountedValue
+{
+	static std::atomic<int> live;
+	static std::atomic<int> copies;
+	int value;
+
+	CountedValue(int v = 0) : value(v) { live++; }
+	CountedValue(const CountedValue& other) : value(other.value) { live++; copies++; }
+	CountedValue& operator=(const CountedValue& other) { value = other.value; return *this; }
+	~CountedValue() { live--; }
+};
+
+std::atomic<int> CountedValue::live{ 0 };
+std::atomic<int> CountedValue::copies{ 0 };
+
+std::ostream& operator<<(std::ostream& os, const CountedValue& v)
+{
+	return os << v.value;
+}
+
+// ==================== TESTS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: BASIC OPERATIONS");
+
+	persistent_map<int, std::string> m;
+	test_assert(m.empty() && m.size() == 0 && m.begin() == m.end(), "New persistent_map is empty");
+
+	m.insert(5, "five");
+	m.insert(2, "two");
+	m.insert(8, "eight");
+	test_assert(m.size() == 3 && m.at(5) == "five" && m.contains(2) && !m.contains(3), "insert, at, contains");
+	test_assert(m.find(8) != m.end() && m.find(8)->second == "eight" && m.find(7) == m.end(), "find");
+
+	m.insert(5, "FIVE");
+	test_assert(m.size() == 3 && m.at(5) == "FIVE", "insert on existing key overwrites");
+
+	bool thrown = false;
+	try
+	{
+		m.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "at() throws on missing key");
+
+	test_assert(m.erase(2) && !m.erase(2) && m.size() == 2 && !m.contains(2), "erase");
+
+	std::vector<int> keys;
+	for (const auto& pair : m)
+		keys.push_back(pair.first);
+	test_assert(keys == std::vector<int>({ 5, 8 }), "In-order iteration");
+
+	persistent_map<int, int> big;
+	for (int i = 0; i < 1000; i++)
+		big.insert(i, i);
+	auto it = big.find(500);
+	std::vector<int> tail;
+	for (; it != big.end(); ++it)
+		tail.push_back(it->first);
+	test_assert(tail.size() == 500 && tail.front() == 500 && tail.back() == 999, "Iteration continues from find()");
+	test_assert(big.is_valid_avl_tree() && big.height() <= 15, "Sequential inserts stay balanced");
+	// l'iteratore non porta con se' uno stack di antenati: radice, nodo e comparatore
+	test_assert(sizeof(persistent_map<int, int>::const_iterator) <= 3 * sizeof(void*), "Iterator holds no ancestor stack");
+
+	m.clear();
+	test_assert(m.empty() && m.begin() == m.end(), "clear()");
+}
+
+void test_snapshot_isolation()
+{
+	section_header("TEST 2: SNAPSHOT ISOLATION");
+
+	persistent_map<int, int> config;
+	for (int i = 0; i < 100; i++)
+		config.insert(i, i);
+
+	persistent_map<int, int> v1 = config.snapshot();
+	test_assert(v1.shares_root_with(config) && v1.size() == 100, "snapshot() shares the whole tree");
+
+	config.insert(50, -50);
+	config.insert(1000, 1000);
+	config.erase(0);
+	test_assert(!v1.shares_root_with(config), "Update creates a new root");
+	test_assert(v1.at(50) == 50 && !v1.contains(1000) && v1.contains(0) && v1.size() == 100, "Snapshot does not see later updates");
+	test_assert(config.at(50) == -50 && config.contains(1000) && !config.contains(0) && config.size() == 100, "Writer sees its updates");
+
+	persistent_map<int, int> v2 = config.snapshot();
+	config.clear();
+	test_assert(v2.size() == 100 && v2.at(1000) == 1000 && v1.at(99) == 99, "Snapshots survive clear() of the source");
+	test_assert(v1.is_valid_avl_tree() && v2.is_valid_avl_tree(), "Every version is a valid AVL-Tree");
+
+	persistent_map<int, int> moved(std::move(v2));
+	test_assert(moved.size() == 100 && v2.empty(), "Move");
+	v2 = moved;
+	test_assert(v2.shares_root_with(moved), "Copy assignment is O(1)");
+}
+
+void test_path_copying()
+{
+	section_header("TEST 3: PATH COPYING");
+
+	{
+		persistent_map<int, CountedValue> m;
+		for (int i = 0; i < 10000; i++)
+			m.insert(i, CountedValue(i));
+
+		persistent_map<int, CountedValue> snapshot = m.snapshot();
+		CountedValue::copies = 0;
+		m.insert(5000, CountedValue(-1));
+		int update_copies = CountedValue::copies;
+
+		CountedValue::copies = 0;
+		m.insert(20000, CountedValue(1));
+		int insert_copies = CountedValue::copies;
+
+		CountedValue::copies = 0;
+		m.erase(1234);
+		int erase_copies = CountedValue::copies;
+
+		std::cout << "Valori copiati (altezza " << m.height() << "): overwrite " << update_copies
+			<< ", insert " << insert_copies << ", erase " << erase_copies << std::endl;
+		test_assert(update_copies <= m.height() + 1, "Overwrite copies only the root-to-key path");
+		test_assert(insert_copies <= 3 * m.height(), "Insert copies O(log n) nodes");
+		test_assert(erase_copies <= 3 * m.height(), "Erase copies O(log n) nodes");
+		test_assert(snapshot.at(5000).value == 5000 && snapshot.contains(1234), "Snapshot intact");
+
+		test_assert(CountedValue::live < 10000 + 3 * 3 * m.height() + 10, "Versions share all untouched nodes");
+	}
+	test_assert(CountedValue::live == 0, "All nodes released with the last version");
+}
+
+void test_random_versions()
+{
+	section_header("TEST 4: RANDOM UPDATES VS map, 200 VERSIONS");
+
+	persistent_map<int, int> current;
+	STDev::map<int, int> reference;
+	std::vector<persistent_map<int, int>> versions;
+	std::vector<std::vector<std::pair<int, int>>> expected;
+
+	std::mt19937 rng(17);
+	std::uniform_int_distribution<int> key_dist(0, 3000);
+	bool all_match = true;
+
+	for (int step = 0; step < 40000; step++)
+	{
+		int key = key_dist(rng);
+		if (step % 3 == 0)
+		{
+			if (current.erase(key) != reference.erase(key))
+				all_match = false;
+		}
+		else
+		{
+			current.insert(key, step);
+			reference.insert(key, step);
+		}
+
+		if (step % 200 == 0)
+		{
+			versions.push_back(current.snapshot());
+			expected.push_back(contents(reference));
+		}
+	}
+
+	test_assert(all_match && contents(current) == contents(reference), "Latest version matches map");
+
+	bool versions_intact = true;
+	bool versions_valid = true;
+	for (size_t i = 0; i < versions.size(); i++)
+	{
+		if (contents(versions[i]) != expected[i] || versions[i].size() != expected[i].size())
+			versions_intact = false;
+		if (!versions[i].is_valid_avl_tree())
+			versions_valid = false;
+	}
+	test_assert(versions_intact, "All 200 old versions unchanged");
+	test_assert(versions_valid, "All versions are valid AVL-Trees");
+}
+
+void test_concurrent_readers()
+{
+	section_header("TEST 5: CONCURRENT SNAPSHOT READERS");
+
+	// il writer pubblica versioni in cui tutte le chiavi hanno lo stesso valore:
+	// un lettore che vedesse una versione a meta' troverebbe valori diversi
+	const int KEYS = 200;
+	const int VERSIONS = 300;
+
+	std::mutex publish_mutex;
+	persistent_map<int, int> published;
+	{
+		persistent_map<int, int> initial;
+		for (int k = 0; k < KEYS; k++)
+			initial.insert(k, 0);
+		published = initial;
+	}
+
+	std::atomic<bool> done{ false };
+	std::atomic<int> inconsistent{ 0 };
+	std::atomic<long long> reads{ 0 };
+
+	std::thread writer([&]()
+	{
+		persistent_map<int, int> working = published.snapshot();
+		for (int v = 1; v <= VERSIONS; v++)
+		{
+			for (int k = 0; k < KEYS; k++)
+				working.insert(k, v);
+
+			std::lock_guard<std::mutex> lock(publish_mutex); // tenuto solo per la copia O(1)
+			published = working.snapshot();
+		}
+		done = true;
+	});
+
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 4; r++)
+	{
+		readers.emplace_back([&]()
+		{
+			while (!done)
+			{
+				persistent_map<int, int> view;
+				{
+					std::lock_guard<std::mutex> lock(publish_mutex);
+					view = published.snapshot();
+				}
+
+				// lettura senza lock mentre il writer crea e rilascia altre versioni
+				int first = view.at(0);
+				int count = 0;
+				for (const auto& pair : view)
+				{
+					if (pair.second != first)
+						inconsistent++;
+					count++;
+				}
+				if (count != KEYS)
+					inconsistent++;
+				reads++;
+			}
+		});
+	}
+
+	writer.join();
+	for (auto& reader : readers)
+		reader.join();
+
+	std::cout << "Snapshot letti: " << reads << std::endl;
+	test_assert(inconsistent == 0, "Readers always see a complete version");
+	test_assert(published.at(KEYS - 1) == VERSIONS && published.is_valid_avl_tree(), "Final version published");
+}
+
+// ==================== BENCHMARKS ====================
+
+void benchmark_snapshot()
+{
+	section_header("BENCHMARK 1: SNAPSHOT - persistent_map VS COPIA DI map");
+
+	const int N = 1000000;
+	const int UPDATES = 100000;
+
+	std::vector<std::pair<int, int>> sorted;
+	for (int i = 0; i < N; i++)
+		sorted.push_back({ i, i });
+
+	auto plain = STDev::map<int, int>::from_sorted(sorted.begin(), sorted.end());
+	persistent_map<int, int> persistent;
+	for (int i = 0; i < N; i++)
+		persistent.insert(i, i);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	STDev::map<int, int> copy(plain);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto copy_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	persistent_map<int, int> view = persistent.snapshot();
+	end = std::chrono::high_resolution_clock::now();
+	auto snapshot_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> dist(0, N - 1);
+	std::vector<int> keys(UPDATES);
+	for (int& key : keys)
+		key = dist(rng);
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int key : keys)
+		plain.insert(key, -key);
+	end = std::chrono::high_resolution_clock::now();
+	auto plain_update_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int key : keys)
+		persistent.insert(key, -key);
+	end = std::chrono::high_resolution_clock::now();
+	auto persistent_update_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "\n" << N << " elementi:" << std::endl;
+	std::cout << "  snapshot con copia di map:    " << copy_us / 1000 << " ms" << std::endl;
+	std::cout << "  snapshot di persistent_map:   " << snapshot_ns << " ns" << std::endl;
+	std::cout << "\n" << UPDATES << " aggiornamenti casuali:" << std::endl;
+	std::cout << "  map (in place):               " << plain_update_ms << " ms" << std::endl;
+	std::cout << "  persistent_map (path copy):   " << persistent_update_ms << " ms" << std::endl;
+	std::cout << "  (" << copy.size() + view.size() << ")" << std::endl;
+}
+
+// ==================== VISUAL DEMO ====================
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	persistent_map<std::string, int> limits;
+	limits.insert("connections", 100);
+	limits.insert("timeout_ms", 5000);
+
+	persistent_map<std::string, int> before = limits.snapshot();
+	limits.insert("connections", 200);
+	limits.insert("retries", 3);
+
+	std::cout << "Versione precedente:" << std::endl;
+	for (const auto& pair : before)
+		std::cout << "  " << pair.first << " = " << pair.second << std::endl;
+
+	std::cout << "Versione corrente:" << std::endl;
+	for (const auto& pair : limits)
+		std::cout << "  " << pair.first << " = " << pair.second << std::endl;
+}
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   PERSISTENT_MAP TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_snapshot_isolation();
+	test_path_copying();
+	test_random_versions();
+	test_concurrent_readers();
+
+	g_stats.print_summary();
+
+	benchmark_snapshot();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}
@@ -1,8 +1,19 @@
 #pragma once
 #include <utility>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
-#include "stack.h"
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "node_arena.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
 
 namespace STDev
 {
@@ -12,60 +23,112 @@ namespace STDev
 		RedBlackTree
 	};
 
-	template<typename K, SetTreeType Type = SetTreeType::RedBlackTree>
+	// Compare come in map: std::less<K> di default, std::less<> abilita find/contains eterogenei.
+	// Allocator come in map: arena_allocator<K> alloca i nodi a slab
+	template<typename K, SetTreeType Type = SetTreeType::RedBlackTree, typename Compare = std::less<K>, typename Allocator = std::allocator<K>>
 	class set
 	{
 	private:
-		enum NodeColor { NONE, RED, BLACK };
+		enum NodeColor { RED = 0, BLACK = 1 };
 
 		struct Node
 		{
 			K key;
 			Node* left;
 			Node* right;
-			Node* parent;
-			NodeColor color;
+			std::uintptr_t parent_and_color; // colore nel bit basso, come in map
 
 			Node(const K& k)
-				: key(k), left(nullptr), right(nullptr),
-				parent(nullptr), color(NONE)
+				: key(k), left(nullptr), right(nullptr), parent_and_color(0)
 			{}
+
+			Node* parent() const
+			{
+				return reinterpret_cast<Node*>(parent_and_color & ~std::uintptr_t(1));
+			}
+
+			void set_parent(Node* node)
+			{
+				parent_and_color = reinterpret_cast<std::uintptr_t>(node) | (parent_and_color & 1);
+			}
+
+			NodeColor color() const
+			{
+				return static_cast<NodeColor>(parent_and_color & 1);
+			}
+
+			void set_color(NodeColor color)
+			{
+				parent_and_color = (parent_and_color & ~std::uintptr_t(1)) | color;
+			}
 		};
 
+		typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+		typedef std::allocator_traits<NodeAllocator> NodeAllocTraits;
+
 		Node* root;
 		size_t _size;
+		Compare comp;
+		NodeAllocator node_alloc;
 
+		Node* create_node(const K& key)
+		{
+			Node* node = NodeAllocTraits::allocate(node_alloc, 1);
+			try
+			{
+				NodeAllocTraits::construct(node_alloc, node, key);
+			}
+			catch (...)
+			{
+				NodeAllocTraits::deallocate(node_alloc, node, 1);
+				throw;
+			}
+			return node;
+		}
+
+		void destroy_node(Node* node)
+		{
+			NodeAllocTraits::destroy(node_alloc, node);
+			NodeAllocTraits::deallocate(node_alloc, node, 1);
+		}
+
+		// un confronto per livello; candidate e' l'ultimo nodo con chiave <= key
 		Node* insert_node(const K& key, bool& inserted)
 		{
 			Node* parentNode = nullptr;
+			Node* candidate = nullptr;
 			Node* currentNode = root;
+			bool goLeft = false;
 
 			while (currentNode != nullptr)
 			{
 				parentNode = currentNode;
-				if (key < currentNode->key)
+				goLeft = comp(key, currentNode->key);
+				if (goLeft)
 				{
 					currentNode = currentNode->left;
 				}
-				else if (key > currentNode->key)
+				else
 				{
+					candidate = currentNode;
 					currentNode = currentNode->right;
 				}
-				else // Chiave gi esistente
-				{
-					inserted = false;
-					return currentNode;
-				}
 			}
 
-			Node* newNode = new Node(key);
-			newNode->parent = parentNode;
+			if (candidate != nullptr && !comp(candidate->key, key)) // Chiave gi esistente
+			{
+				inserted = false;
+				return candidate;
+			}
+
+			Node* newNode = create_node(key);
+			newNode->set_parent(parentNode);
 
 			if (parentNode == nullptr)
 			{
 				root = newNode;
 			}
-			else if (newNode->key < parentNode->key)
+			else if (goLeft)
 			{
 				parentNode->left = newNode;
 			}
@@ -81,56 +144,56 @@ namespace STDev
 
 		void insert_fixup(Node* node)
 		{
-			node->color = RED;
+			node->set_color(RED);
 
-			while (node->parent != nullptr && node->parent->color == RED)
+			while (node->parent() != nullptr && node->parent()->color() == RED)
 			{
-				if (node->parent == node->parent->parent->left)
+				if (node->parent() == node->parent()->parent()->left)
 				{
-					Node* uncle = node->parent->parent->right;
-					if (uncle != nullptr && uncle->color == RED)
+					Node* uncle = node->parent()->parent()->right;
+					if (uncle != nullptr && uncle->color() == RED)
 					{
-						node->parent->color = BLACK;
-						uncle->color = BLACK;
-						node->parent->parent->color = RED;
-						node = node->parent->parent;
+						node->parent()->set_color(BLACK);
+						uncle->set_color(BLACK);
+						node->parent()->parent()->set_color(RED);
+						node = node->parent()->parent();
 					}
 					else
 					{
-						if (node == node->parent->right)
+						if (node == node->parent()->right)
 						{
-							node = node->parent;
+							node = node->parent();
 							rotate_left(node);
 						}
-						node->parent->color = BLACK;
-						node->parent->parent->color = RED;
-						rotate_right(node->parent->parent);
+						node->parent()->set_color(BLACK);
+						node->parent()->parent()->set_color(RED);
+						rotate_right(node->parent()->parent());
 					}
 				}
 				else
 				{
-					Node* uncle = node->parent->parent->left;
-					if (uncle != nullptr && uncle->color == RED)
+					Node* uncle = node->parent()->parent()->left;
+					if (uncle != nullptr && uncle->color() == RED)
 					{
-						node->parent->color = BLACK;
-						uncle->color = BLACK;
-						node->parent->parent->color = RED;
-						node = node->parent->parent;
+						node->parent()->set_color(BLACK);
+						uncle->set_color(BLACK);
+						node->parent()->parent()->set_color(RED);
+						node = node->parent()->parent();
 					}
 					else
 					{
-						if (node == node->parent->left)
+						if (node == node->parent()->left)
 						{
-							node = node->parent;
+							node = node->parent();
 							rotate_right(node);
 						}
-						node->parent->color = BLACK;
-						node->parent->parent->color = RED;
-						rotate_left(node->parent->parent);
+						node->parent()->set_color(BLACK);
+						node->parent()->parent()->set_color(RED);
+						rotate_left(node->parent()->parent());
 					}
 				}
 			}
-			root->color = BLACK;
+			root->set_color(BLACK);
 		}
 
 		void rotate_left(Node* node)
@@ -140,26 +203,26 @@ namespace STDev
 
 			if (rightChild->left != nullptr)
 			{
-				rightChild->left->parent = node;
+				rightChild->left->set_parent(node);
 			}
 
-			rightChild->parent = node->parent;
+			rightChild->set_parent(node->parent());
 
-			if (node->parent == nullptr)
+			if (node->parent() == nullptr)
 			{
 				root = rightChild;
 			}
-			else if (node == node->parent->left)
+			else if (node == node->parent()->left)
 			{
-				node->parent->left = rightChild;
+				node->parent()->left = rightChild;
 			}
 			else
 			{
-				node->parent->right = rightChild;
+				node->parent()->right = rightChild;
 			}
 
 			rightChild->left = node;
-			node->parent = rightChild;
+			node->set_parent(rightChild);
 		}
 
 		void rotate_right(Node* node)
@@ -169,46 +232,115 @@ namespace STDev
 
 			if (leftChild->right != nullptr)
 			{
-				leftChild->right->parent = node;
+				leftChild->right->set_parent(node);
 			}
 
-			leftChild->parent = node->parent;
+			leftChild->set_parent(node->parent());
 
-			if (node->parent == nullptr)
+			if (node->parent() == nullptr)
 			{
 				root = leftChild;
 			}
-			else if (node == node->parent->left)
+			else if (node == node->parent()->left)
 			{
-				node->parent->left = leftChild;
+				node->parent()->left = leftChild;
 			}
 			else
 			{
-				node->parent->right = leftChild;
+				node->parent()->right = leftChild;
 			}
 
 			leftChild->right = node;
-			node->parent = leftChild;
+			node->set_parent(leftChild);
 		}
 
-		Node* find_helper(Node* node, const K& key) const
+		template<typename KeyLike>
+		Node* find_helper(Node* node, const KeyLike& key) const
 		{
+			Node* candidate = nullptr;
 			while (node != nullptr)
 			{
-				if (key < node->key)
+				if (comp(key, node->key))
 				{
 					node = node->left;
 				}
-				else if (key > node->key)
+				else
 				{
+					candidate = node;
 					node = node->right;
 				}
-				else
+			}
+
+			if (candidate != nullptr && !comp(candidate->key, key))
+				return candidate;
+
+			return nullptr;
+		}
+
+		// discese intrecciate da find_batch
+		static constexpr size_t BATCH_LANES = 16;
+
+		static void prefetch(const void* address)
+		{
+#if defined(_MSC_VER)
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+			__builtin_prefetch(address);
+#endif
+		}
+
+		// come in map: BATCH_LANES discese insieme, un livello per giro, con il prefetch del nodo
+		// del giro dopo. sink(i, node) riceve il nodo di keys[i] o nullptr
+		template<typename KeyLike, typename Sink>
+		void find_batch_helper(const KeyLike* keys, size_t count, Sink sink) const
+		{
+			Node* nodes[BATCH_LANES];
+			Node* candidates[BATCH_LANES];
+			for (size_t first = 0; first < count; first += BATCH_LANES)
+			{
+				size_t group = std::min(BATCH_LANES, count - first);
+				for (size_t lane = 0; lane < group; lane++)
 				{
-					return node;
+					nodes[lane] = root;
+					candidates[lane] = nullptr;
+				}
+
+				bool active = root != nullptr;
+				while (active)
+				{
+					active = false;
+					for (size_t lane = 0; lane < group; lane++)
+					{
+						Node* node = nodes[lane];
+						if (node == nullptr)
+							continue;
+
+						if (comp(keys[first + lane], node->key))
+						{
+							node = node->left;
+						}
+						else
+						{
+							candidates[lane] = node;
+							node = node->right;
+						}
+
+						if (node != nullptr)
+						{
+							prefetch(node);
+							active = true;
+						}
+						nodes[lane] = node;
+					}
+				}
+
+				for (size_t lane = 0; lane < group; lane++)
+				{
+					Node* candidate = candidates[lane];
+					bool found = candidate != nullptr && !comp(candidate->key, keys[first + lane]);
+					sink(first + lane, found ? candidate : nullptr);
 				}
 			}
-			return nullptr;
 		}
 
 		Node* find_min(Node* node) const
@@ -218,26 +350,71 @@ namespace STDev
 			return node;
 		}
 
+		Node* find_max(Node* node) const
+		{
+			while (node && node->right)
+				node = node->right;
+			return node;
+		}
+
+		// come map::build_sorted: albero bilanciato in ordine, ultimo livello rosso nel RB-Tree
+		template<typename ForwardIt>
+		Node* build_sorted(ForwardIt& it, size_t n, int depth, int max_depth)
+		{
+			if (n == 0)
+				return nullptr;
+
+			size_t left_count = n / 2;
+			Node* left = build_sorted(it, left_count, depth + 1, max_depth);
+
+			Node* node = nullptr;
+			try
+			{
+				node = create_node(*it);
+				node->left = left;
+				if (left)
+					left->set_parent(node);
+				++it;
+				node->right = build_sorted(it, n - left_count - 1, depth + 1, max_depth);
+			}
+			catch (...)
+			{
+				// come in map: il sottoalbero parziale non e' ancora agganciato a root
+				destroy_helper(node != nullptr ? node : left);
+				throw;
+			}
+
+			if (node->right)
+				node->right->set_parent(node);
+
+			if constexpr (Type == SetTreeType::RedBlackTree)
+			{
+				node->set_color((depth == max_depth && depth > 0) ? RED : BLACK);
+			}
+
+			return node;
+		}
+
 		Node* copy_helper(Node* node)
 		{
 			if (!node)
 				return nullptr;
 
-			Node* new_node = new Node(node->key);
+			Node* new_node = create_node(node->key);
 
 			if constexpr (Type == SetTreeType::RedBlackTree)
 			{
-				new_node->color = node->color;
+				new_node->set_color(node->color());
 			}
 
 			new_node->left = copy_helper(node->left);
 			new_node->right = copy_helper(node->right);
 
 			if (new_node->left)
-				new_node->left->parent = new_node;
+				new_node->left->set_parent(new_node);
 
 			if (new_node->right)
-				new_node->right->parent = new_node;
+				new_node->right->set_parent(new_node);
 
 			return new_node;
 		}
@@ -247,11 +424,11 @@ namespace STDev
 			if (!node)
 				return nullptr;
 
-			if (key < node->key)
+			if (comp(key, node->key))
 			{
 				node->left = erase_helper(node->left, key, erased);
 			}
-			else if (key > node->key)
+			else if (comp(node->key, key))
 			{
 				node->right = erase_helper(node->right, key, erased);
 			}
@@ -262,19 +439,21 @@ namespace STDev
 
 				if (!node->left && !node->right)
 				{
-					delete node;
+					destroy_node(node);
 					return nullptr;
 				}
 				else if (!node->left)
 				{
 					Node* temp = node->right;
-					delete node;
+					temp->set_parent(node->parent());
+					destroy_node(node);
 					return temp;
 				}
 				else if (!node->right)
 				{
 					Node* temp = node->left;
-					delete node;
+					temp->set_parent(node->parent());
+					destroy_node(node);
 					return temp;
 				}
 				else
@@ -288,28 +467,283 @@ namespace STDev
 			return node;
 		}
 
-		void destroy_helper(Node* node) //meglio questa versione ciclica che quella ricorsiva
+		// successore in-order risalendo i parent, come map::next_node
+		static const Node* next_node(const Node* node)
 		{
-			if (!node) return;
+			if (node->right)
+			{
+				node = node->right;
+				while (node->left)
+					node = node->left;
+				return node;
+			}
+
+			const Node* parent = node->parent();
+			while (parent && node == parent->right)
+			{
+				node = parent;
+				parent = parent->parent();
+			}
+			return parent;
+		}
+
+		static const Node* previous_node(const Node* node)
+		{
+			if (node->left)
+			{
+				node = node->left;
+				while (node->right)
+					node = node->right;
+				return node;
+			}
+
+			const Node* parent = node->parent();
+			while (parent && node == parent->left)
+			{
+				node = parent;
+				parent = parent->parent();
+			}
+			return parent;
+		}
+
+		// adatta un vector<const K*> a build_sorted senza copiare le chiavi due volte
+		struct KeyRefIterator
+		{
+			typename std::vector<const K*>::const_iterator position;
+
+			const K& operator*() const
+			{
+				return **position;
+			}
+
+			KeyRefIterator& operator++()
+			{
+				++position;
+				return *this;
+			}
+		};
+
+		// risultato di un'operazione insiemistica: chiavi gia' ordinate e distinte, O(n)
+		static set build_from_keys(const std::vector<const K*>& keys, const set& source)
+		{
+			set result(source.comp, Allocator(NodeAllocTraits::select_on_container_copy_construction(source.node_alloc)));
+
+			int max_depth = 0;
+			for (size_t n = keys.size(); n > 1; n >>= 1)
+				max_depth++;
+
+			KeyRefIterator it{ keys.begin() };
+			result.root = result.build_sorted(it, keys.size(), 0, max_depth);
+			result._size = keys.size();
+			return result;
+		}
+
+		// finger search: chiavi cercate in ordine crescente ripartono dal nodo in cui si e' fermata
+		// la ricerca precedente, risalendo solo finche' il sottoalbero puo' contenere key.
+		// m ricerche su n nodi costano O(m log(n/m)) invece di O(m log n)
+		const Node* finger_search(const Node*& finger, const K& key) const
+		{
+			const Node* subtree = root;
+			if (finger != nullptr)
+			{
+				subtree = finger;
+				while (subtree->parent() != nullptr)
+				{
+					const Node* parent = subtree->parent();
+					if (subtree == parent->left && comp(key, parent->key))
+						break; // tutte le chiavi tra finger e key stanno in subtree
+					subtree = parent;
+				}
+			}
+
+			const Node* candidate = nullptr;
+			for (const Node* node = subtree; node != nullptr; )
+			{
+				finger = node;
+				if (comp(key, node->key))
+				{
+					node = node->left;
+				}
+				else
+				{
+					candidate = node;
+					node = node->right;
+				}
+			}
+
+			if (candidate != nullptr && !comp(candidate->key, key))
+				return candidate;
+			return nullptr;
+		}
+
+		// con dimensioni molto sbilanciate conviene cercare le chiavi del set piccolo nel grande
+		// (O(m log(n/m))) invece di scorrerli entrambi (O(n + m))
+		static bool prefer_lookups(size_t small_size, size_t large_size)
+		{
+			if (small_size == 0)
+				return true;
+
+			size_t log_ratio = 1;
+			for (size_t n = large_size / small_size; n > 1; n >>= 1)
+				log_ratio++;
+			return small_size * log_ratio < large_size;
+		}
+
+		enum class MergeMode { Union, Intersection, Difference };
+
+		static set merge_sets(const set& a, const set& b, MergeMode mode)
+		{
+			const Compare& comp = a.comp;
+			std::vector<const K*> keys;
+
+			if (mode == MergeMode::Intersection && (prefer_lookups(a._size, b._size) || prefer_lookups(b._size, a._size)))
+			{
+				const set& small = a._size <= b._size ? a : b;
+				const set& large = a._size <= b._size ? b : a;
+				keys.reserve(small._size);
+				const Node* finger = nullptr;
+				for (const Node* node = small.find_min(small.root); node != nullptr; node = next_node(node))
+				{
+					if (large.finger_search(finger, node->key) != nullptr)
+						keys.push_back(&node->key);
+				}
+				return build_from_keys(keys, a);
+			}
+
+			if (mode == MergeMode::Difference && prefer_lookups(a._size, b._size))
+			{
+				keys.reserve(a._size);
+				const Node* finger = nullptr;
+				for (const Node* node = a.find_min(a.root); node != nullptr; node = next_node(node))
+				{
+					if (b.finger_search(finger, node->key) == nullptr)
+						keys.push_back(&node->key);
+				}
+				return build_from_keys(keys, a);
+			}
 
-			stack<Node*> s;
-			s.push(node);
+			// merge lineare delle due visite in ordine
+			keys.reserve(mode == MergeMode::Union ? a._size + b._size : a._size);
+			const Node* x = a.find_min(a.root);
+			const Node* y = b.find_min(b.root);
+			while (x != nullptr && y != nullptr)
+			{
+				if (comp(x->key, y->key))
+				{
+					if (mode != MergeMode::Intersection)
+						keys.push_back(&x->key);
+					x = next_node(x);
+				}
+				else if (comp(y->key, x->key))
+				{
+					if (mode == MergeMode::Union)
+						keys.push_back(&y->key);
+					y = next_node(y);
+				}
+				else
+				{
+					if (mode != MergeMode::Difference)
+						keys.push_back(&x->key);
+					x = next_node(x);
+					y = next_node(y);
+				}
+			}
 
-			while (!s.empty())
+			if (mode != MergeMode::Intersection)
+			{
+				for (; x != nullptr; x = next_node(x))
+					keys.push_back(&x->key);
+			}
+			if (mode == MergeMode::Union)
 			{
-				Node* current = s.top();
-				s.pop();
+				for (; y != nullptr; y = next_node(y))
+					keys.push_back(&y->key);
+			}
+
+			return build_from_keys(keys, a);
+		}
 
-				if (current->left)
+		static bool includes_helper(const set& a, const set& b)
+		{
+			if (b._size > a._size)
+				return false;
+
+			if (prefer_lookups(b._size, a._size))
+			{
+				const Node* finger = nullptr;
+				for (const Node* node = b.find_min(b.root); node != nullptr; node = next_node(node))
+				{
+					if (a.finger_search(finger, node->key) == nullptr)
+						return false;
+				}
+				return true;
+			}
+
+			const Node* x = a.find_min(a.root);
+			const Node* y = b.find_min(b.root);
+			while (y != nullptr)
+			{
+				if (x == nullptr || a.comp(y->key, x->key))
+					return false;
+
+				if (!a.comp(x->key, y->key))
+					y = next_node(y);
+				x = next_node(x);
+			}
+			return true;
+		}
+
+		void destroy_helper(Node* node)
+		{
+			if (!node) return;
+
+			// come in map: arena non condivisa, nodi solo distrutti e slab liberati in blocco;
+			// la visita serve solo se le chiavi hanno un distruttore
+			bool bulk = false;
+			if constexpr (is_arena_allocator<NodeAllocator>::value)
+			{
+				bulk = node_alloc.sole_owner();
+				if (bulk && std::is_trivially_destructible<K>::value)
 				{
-					s.push(current->left);
+					node_alloc.release();
+					return;
 				}
+			}
 
-				if (current->right)
+			// post-ordine senza stack come in map: si stacca una foglia alla volta e si
+			// riparte dal parent. O(n), nessuna allocazione
+			while (node != nullptr)
+			{
+				if (node->left != nullptr)
 				{
-					s.push(current->right);
+					node = node->left;
+				}
+				else if (node->right != nullptr)
+				{
+					node = node->right;
+				}
+				else
+				{
+					Node* parent = node->parent();
+					if (parent != nullptr)
+					{
+						if (parent->left == node)
+							parent->left = nullptr;
+						else
+							parent->right = nullptr;
+					}
+					if (bulk)
+						NodeAllocTraits::destroy(node_alloc, node);
+					else
+						destroy_node(node);
+					node = parent;
 				}
-				delete current;
+			}
+
+			if constexpr (is_arena_allocator<NodeAllocator>::value)
+			{
+				if (bulk)
+					node_alloc.release();
 			}
 		}
 
@@ -323,7 +757,7 @@ namespace STDev
 
 				if constexpr (Type == SetTreeType::RedBlackTree)
 				{
-					std::cout << (node->color == RED ? "(R)" : "(B)");
+					std::cout << (node->color() == RED ? "(R)" : "(B)");
 				}
 
 				std::cout << std::endl;
@@ -344,7 +778,12 @@ namespace STDev
 		}
 
 	public:
-		set() : root(nullptr), _size(0) {}
+		set() : root(nullptr), _size(0), comp(), node_alloc() {}
+
+		explicit set(const Compare& compare, const Allocator& alloc = Allocator())
+			: root(nullptr), _size(0), comp(compare), node_alloc(alloc) {}
+
+		explicit set(const Allocator& alloc) : root(nullptr), _size(0), comp(), node_alloc(alloc) {}
 
 		~set()
 		{
@@ -352,7 +791,9 @@ namespace STDev
 		}
 
 		// Copy constructor
-		set(const set& other) : root(nullptr), _size(0)
+		set(const set& other)
+			: root(nullptr), _size(0), comp(other.comp),
+			node_alloc(NodeAllocTraits::select_on_container_copy_construction(other.node_alloc))
 		{
 			root = copy_helper(other.root);
 			_size = other._size;
@@ -366,16 +807,18 @@ namespace STDev
 				destroy_helper(root);
 				root = copy_helper(other.root);
 				_size = other._size;
+				comp = other.comp;
 			}
 			return *this;
 		}
 
-		// Move constructor
+		// Move constructor: l'allocator passa al nuovo set, other riceve quello di una copia
 		set(set&& other) noexcept
-			: root(other.root), _size(other._size)
+			: root(other.root), _size(other._size), comp(std::move(other.comp)), node_alloc(std::move(other.node_alloc))
 		{
 			other.root = nullptr;
 			other._size = 0;
+			other.node_alloc = NodeAllocTraits::select_on_container_copy_construction(node_alloc);
 		}
 
 		// Move assignment
@@ -386,8 +829,11 @@ namespace STDev
 				destroy_helper(root);
 				root = other.root;
 				_size = other._size;
+				comp = std::move(other.comp);
+				node_alloc = std::move(other.node_alloc);
 				other.root = nullptr;
 				other._size = 0;
+				other.node_alloc = NodeAllocTraits::select_on_container_copy_construction(node_alloc);
 			}
 			return *this;
 		}
@@ -405,6 +851,61 @@ namespace STDev
 			return inserted;
 		}
 
+		// chiavi crescenti agganciate direttamente a destra del massimo, le altre con insert
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		void insert(InputIt first, InputIt last)
+		{
+			Node* tail = find_max(root);
+			for (; first != last; ++first)
+			{
+				if (tail == nullptr || comp(tail->key, *first))
+				{
+					Node* node = create_node(*first);
+					node->set_parent(tail);
+					if (tail == nullptr)
+						root = node;
+					else
+						tail->right = node;
+					++_size;
+
+					if constexpr (Type == SetTreeType::RedBlackTree)
+					{
+						insert_fixup(node);
+					}
+					tail = node;
+				}
+				else
+				{
+					insert(*first);
+				}
+			}
+		}
+
+		// costruzione O(n) da chiavi strettamente crescenti (std::invalid_argument altrimenti)
+		template<typename ForwardIt>
+		static set from_sorted(ForwardIt first, ForwardIt last, const Compare& compare = Compare(), const Allocator& alloc = Allocator())
+		{
+			set result(compare, alloc);
+
+			size_t count = 0;
+			ForwardIt previous = first;
+			for (ForwardIt it = first; it != last; ++it)
+			{
+				if (count > 0 && !result.comp(*previous, *it))
+					throw std::invalid_argument("set::from_sorted: keys not strictly increasing");
+				previous = it;
+				count++;
+			}
+
+			int max_depth = 0;
+			for (size_t n = count; n > 1; n >>= 1)
+				max_depth++;
+
+			result.root = result.build_sorted(first, count, 0, max_depth);
+			result._size = count;
+			return result;
+		}
+
 		bool erase(const K& key)
 		{
 			bool erased = false;
@@ -422,6 +923,35 @@ namespace STDev
 			return find(key);
 		}
 
+		// out[i] = find(keys[i]) per un blocco di chiavi
+		void find_batch(const K* keys, size_t count, bool* out) const
+		{
+			find_batch_helper(keys, count, [out](size_t i, const Node* node) { out[i] = node != nullptr; });
+		}
+
+		// ricerca eterogenea, solo con Compare::is_transparent (es. set<std::string, ..., std::less<>>)
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool find(const KeyLike& key) const
+		{
+			return find_helper(root, key) != nullptr;
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool contains(const KeyLike& key) const
+		{
+			return find_helper(root, key) != nullptr;
+		}
+
+		Compare key_comp() const
+		{
+			return comp;
+		}
+
+		Allocator get_allocator() const
+		{
+			return Allocator(node_alloc);
+		}
+
 		size_t size() const { return _size; }
 		bool empty() const { return _size == 0; }
 
@@ -447,7 +977,7 @@ namespace STDev
 				std::cout << "ROOT [" << root->key << "]";
 				if constexpr (Type == SetTreeType::RedBlackTree)
 				{
-					std::cout << (root->color == RED ? "(R)" : "(B)");
+					std::cout << (root->color() == RED ? "(R)" : "(B)");
 				}
 				std::cout << std::endl;
 
@@ -467,39 +997,27 @@ namespace STDev
 			std::cout << std::endl;
 		}
 
+		// iteratori bidirezionali come in map: un nodo e il set di appartenenza (serve solo
+		// a --end()). Avanzano sui parent pointer: begin()/end() non allocano e la copia e'
+		// banale (due puntatori)
 		class iterator
 		{
 		private:
-			Node* current;
-			Node* root_node;
-			stack<Node*> _stack;
+			const Node* current;
+			const set* owner;
 
-			void push_left(Node* node)
-			{
-				while (node)
-				{
-					_stack.push(node);
-					node = node->left;
-				}
-			}
+			iterator(const Node* node, const set* s) : current(node), owner(s)
+			{}
 
 		public:
-			iterator(Node* node, Node* r) : current(nullptr), root_node(r)
-			{
-				if (node == nullptr && root_node != nullptr)
-				{
-					push_left(root_node);
-					if (_stack.size() > 0)
-					{
-						current = _stack.top();
-						_stack.pop();
-					}
-				}
-				else
-				{
-					current = node;
-				}
-			}
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef K value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const K* pointer;
+			typedef const K& reference;
+
+			iterator() : current(nullptr), owner(nullptr)
+			{}
 
 			const K& operator*() const
 			{
@@ -513,28 +1031,8 @@ namespace STDev
 
 			iterator& operator++()
 			{
-				if (!current)
-					return *this;
-
-				if (current->right)
-				{
-					push_left(current->right);
-					if (_stack.size() > 0)
-					{
-						current = _stack.top();
-						_stack.pop();
-					}
-				}
-				else if (_stack.size() > 0)
-				{
-					current = _stack.top();
-					_stack.pop();
-				}
-				else
-				{
-					current = nullptr;
-				}
-
+				if (current)
+					current = next_node(current);
 				return *this;
 			}
 
@@ -545,6 +1043,23 @@ namespace STDev
 				return temp;
 			}
 
+			// --end() porta all'ultimo elemento
+			iterator& operator--()
+			{
+				if (current)
+					current = previous_node(current);
+				else
+					current = owner->find_max(owner->root);
+				return *this;
+			}
+
+			iterator operator--(int)
+			{
+				iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
 			bool operator==(const iterator& other) const
 			{
 				return current == other.current;
@@ -554,26 +1069,63 @@ namespace STDev
 			{
 				return current != other.current;
 			}
-		};
 
-		iterator begin()
-		{
-			return iterator(nullptr, root);
-		}
-
-		iterator end()
-		{
-			return iterator(nullptr, nullptr);
-		}
+			friend class set;
+		};
 
 		iterator begin() const
 		{
-			return iterator(nullptr, root);
+			return iterator(find_min(root), this);
 		}
 
 		iterator end() const
 		{
-			return iterator(nullptr, nullptr);
+			return iterator(nullptr, this);
 		}
+
+		// Algebra insiemistica: il risultato usa il comparatore e (come una copia) l'allocator di a.
+		// Merge lineare O(n + m) delle visite in ordine, oppure O(m log(n/m)) cercando le chiavi
+		// del set piccolo nel grande quando le dimensioni sono sbilanciate; l'albero risultante e'
+		// costruito in O(size) come from_sorted
+		template<typename K2, SetTreeType Type2, typename Compare2, typename Allocator2>
+		friend set<K2, Type2, Compare2, Allocator2> set_union(const set<K2, Type2, Compare2, Allocator2>& a, const set<K2, Type2, Compare2, Allocator2>& b);
+
+		template<typename K2, SetTreeType Type2, typename Compare2, typename Allocator2>
+		friend set<K2, Type2, Compare2, Allocator2> set_intersection(const set<K2, Type2, Compare2, Allocator2>& a, const set<K2, Type2, Compare2, Allocator2>& b);
+
+		template<typename K2, SetTreeType Type2, typename Compare2, typename Allocator2>
+		friend set<K2, Type2, Compare2, Allocator2> set_difference(const set<K2, Type2, Compare2, Allocator2>& a, const set<K2, Type2, Compare2, Allocator2>& b);
+
+		template<typename K2, SetTreeType Type2, typename Compare2, typename Allocator2>
+		friend bool includes(const set<K2, Type2, Compare2, Allocator2>& a, const set<K2, Type2, Compare2, Allocator2>& b);
 	};
+
+	template<typename K, SetTreeType Type, typename Compare, typename Allocator>
+	set<K, Type, Compare, Allocator> set_union(const set<K, Type, Compare, Allocator>& a, const set<K, Type, Compare, Allocator>& b)
+	{
+		typedef set<K, Type, Compare, Allocator> Set;
+		return Set::merge_sets(a, b, Set::MergeMode::Union);
+	}
+
+	template<typename K, SetTreeType Type, typename Compare, typename Allocator>
+	set<K, Type, Compare, Allocator> set_intersection(const set<K, Type, Compare, Allocator>& a, const set<K, Type, Compare, Allocator>& b)
+	{
+		typedef set<K, Type, Compare, Allocator> Set;
+		return Set::merge_sets(a, b, Set::MergeMode::Intersection);
+	}
+
+	// chiavi di a che non sono in b
+	template<typename K, SetTreeType Type, typename Compare, typename Allocator>
+	set<K, Type, Compare, Allocator> set_difference(const set<K, Type, Compare, Allocator>& a, const set<K, Type, Compare, Allocator>& b)
+	{
+		typedef set<K, Type, Compare, Allocator> Set;
+		return Set::merge_sets(a, b, Set::MergeMode::Difference);
+	}
+
+	// true se ogni chiave di b e' in a
+	template<typename K, SetTreeType Type, typename Compare, typename Allocator>
+	bool includes(const set<K, Type, Compare, Allocator>& a, const set<K, Type, Compare, Allocator>& b)
+	{
+		return set<K, Type, Compare, Allocator>::includes_helper(a, b);
+	}
 }
\ No newline at end of file
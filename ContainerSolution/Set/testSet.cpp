@@ -4,6 +4,16 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <cctype>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <random>
+#include <chrono>
+#include <iterator>
+#include <type_traits>
+#include <memory>
+#include <stdexcept>
 
 using namespace STDev;
 
@@ -261,6 +271,55 @@ void test_iterator()
 	std::cout << "OK\n";
 }
 
+void test_stackless_iterator()
+{
+	std::cout << "Test: iteratori senza stack... ";
+
+	static_assert(std::is_trivially_copyable<set<int>::iterator>::value, "set iterator must be trivially copyable");
+	static_assert(std::is_same<std::iterator_traits<set<int>::iterator>::iterator_category, std::bidirectional_iterator_tag>::value,
+		"set iterator must be bidirectional");
+
+	set<int> s;
+	assert(s.begin() == s.end());
+
+	for (int i = 0; i < 1000; i++)
+	{
+		s.insert((i * 7) % 1000);
+	}
+
+	// avanti e indietro
+	int expected = 0;
+	for (auto it = s.begin(); it != s.end(); ++it)
+	{
+		assert(*it == expected++);
+	}
+	expected = 999;
+	for (auto it = s.end(); it != s.begin();)
+	{
+		--it;
+		assert(*it == expected--);
+	}
+	assert(*std::prev(s.end()) == 999 && *std::next(s.begin(), 10) == 10);
+	assert(std::distance(s.begin(), s.end()) == 1000);
+
+	// albero degenere (BST con chiavi crescenti): 10^5 livelli, visita e clear() senza stack
+	set<int, SetTreeType::BinarySearchTree> chain;
+	std::vector<int> keys;
+	for (int i = 0; i < 100000; i++)
+	{
+		keys.push_back(i);
+	}
+	chain.insert(keys.begin(), keys.end());
+	assert(std::distance(chain.begin(), chain.end()) == 100000);
+	assert(*std::prev(chain.end()) == 99999);
+
+	set<int, SetTreeType::BinarySearchTree> chain_copy(std::move(chain));
+	chain_copy.clear();
+	assert(chain_copy.empty() && chain_copy.begin() == chain_copy.end());
+
+	std::cout << "OK\n";
+}
+
 void test_empty_operations()
 {
 	std::cout << "Test: operazioni su set vuoto... ";
@@ -425,6 +484,430 @@ void test_order_verification()
 	std::cout << "OK\n";
 }
 
+void test_custom_comparator()
+{
+	std::cout << "Test: comparatore personalizzato... ";
+	set<int, SetTreeType::RedBlackTree, std::greater<int>> s;
+
+	for (int i = 1; i <= 10; i++)
+	{
+		s.insert(i);
+	}
+	assert(!s.insert(5));
+	assert(s.size() == 10);
+
+	std::vector<int> visited;
+	for (int v : s)
+	{
+		visited.push_back(v);
+	}
+	assert(visited.front() == 10 && visited.back() == 1);
+	assert(std::is_sorted(visited.begin(), visited.end(), std::greater<int>()));
+
+	assert(s.erase(10));
+	assert(!s.contains(10) && s.contains(9));
+	assert(*s.begin() == 9);
+
+	// ordinamento senza distinzione maiuscole/minuscole
+	auto case_insensitive = [](const std::string& a, const std::string& b)
+	{
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+			[](char x, char y) { return std::tolower(x) < std::tolower(y); });
+	};
+	set<std::string, SetTreeType::RedBlackTree, decltype(case_insensitive)> names(case_insensitive);
+	names.insert("Alice");
+	assert(!names.insert("ALICE"));
+	assert(names.contains("alice"));
+
+	std::cout << "OK\n";
+}
+
+void test_transparent_lookup()
+{
+	std::cout << "Test: ricerca eterogenea con std::less<>... ";
+	set<std::string, SetTreeType::RedBlackTree, std::less<>> s;
+	s.insert("apple");
+	s.insert("banana");
+
+	std::string_view view = "banana";
+	const char* literal = "apple";
+	assert(s.contains(view));
+	assert(s.find(literal));
+	assert(!s.contains(std::string_view("cherry")));
+
+	std::cout << "OK\n";
+}
+
+// chiave che lancia alla copia numero fail_at e conta le istanze vive
+struct ThrowingKey
+{
+	static int copies;
+	static int fail_at;
+	static int live;
+	int value;
+
+	ThrowingKey(int v) : value(v) { live++; }
+
+	ThrowingKey(const ThrowingKey& other) : value(other.value)
+	{
+		if (++copies == fail_at)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		live++;
+	}
+
+	ThrowingKey& operator=(const ThrowingKey&) = default;
+
+	~ThrowingKey() { live--; }
+
+	bool operator<(const ThrowingKey& other) const { return value < other.value; }
+};
+
+int ThrowingKey::copies = 0;
+int ThrowingKey::fail_at = -1;
+int ThrowingKey::live = 0;
+
+void test_from_sorted_and_bulk_insert()
+{
+	std::cout << "Test: from_sorted e insert(first, last)... ";
+
+	for (int n = 0; n <= 100; n++)
+	{
+		std::vector<int> sorted;
+		for (int i = 0; i < n; i++)
+		{
+			sorted.push_back(i * 3);
+		}
+
+		auto s = set<int>::from_sorted(sorted.begin(), sorted.end());
+		assert(s.size() == static_cast<size_t>(n));
+
+		std::vector<int> visited;
+		for (int v : s)
+		{
+			visited.push_back(v);
+		}
+		assert(visited == sorted);
+	}
+
+	std::vector<int> keys = { 10, 20, 30, 40, 50 };
+	auto s = set<int>::from_sorted(keys.begin(), keys.end());
+	assert(s.insert(25));
+	assert(s.erase(10));
+	assert(s.contains(25) && !s.contains(10) && s.size() == 5);
+
+	std::vector<int> unsorted = { 1, 3, 2 };
+	bool thrown = false;
+	try
+	{
+		set<int>::from_sorted(unsorted.begin(), unsorted.end());
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+
+	set<int> bulk;
+	bulk.insert(500);
+	std::vector<int> runs;
+	for (int i = 0; i < 1000; i++)
+	{
+		runs.push_back(i);
+	}
+	runs.push_back(7);
+	bulk.insert(runs.begin(), runs.end());
+	assert(bulk.size() == 1000);
+
+	std::vector<int> ordered;
+	for (int v : bulk)
+	{
+		ordered.push_back(v);
+	}
+	assert(std::is_sorted(ordered.begin(), ordered.end()));
+	assert(ordered.front() == 0 && ordered.back() == 999);
+
+	// from_sorted fallito a meta': il sottoalbero gia' costruito viene distrutto
+	std::vector<ThrowingKey> throwing_keys;
+	for (int i = 0; i < 1000; i++)
+	{
+		throwing_keys.push_back(ThrowingKey(i));
+	}
+	int live_before = ThrowingKey::live;
+	for (int fail_at : { 1, 2, 500, 1000 })
+	{
+		ThrowingKey::copies = 0;
+		ThrowingKey::fail_at = fail_at;
+		thrown = false;
+		try
+		{
+			set<ThrowingKey>::from_sorted(throwing_keys.begin(), throwing_keys.end());
+		}
+		catch (const std::runtime_error&)
+		{
+			thrown = true;
+		}
+		assert(thrown && ThrowingKey::live == live_before);
+	}
+	ThrowingKey::fail_at = -1;
+
+	std::cout << "OK\n";
+}
+
+template<typename Set>
+std::vector<int> to_vector(const Set& s)
+{
+	std::vector<int> result;
+	for (int v : s)
+	{
+		result.push_back(v);
+	}
+	return result;
+}
+
+void test_set_algebra()
+{
+	std::cout << "Test: set_union, set_intersection, set_difference, includes... ";
+
+	std::mt19937 rng(44);
+
+	// dimensioni bilanciate e sbilanciate (percorso con lookup)
+	const size_t sizes[][2] = { { 0, 0 }, { 0, 50 }, { 50, 0 }, { 300, 300 }, { 5, 5000 }, { 5000, 5 }, { 1, 20000 } };
+	for (const auto& pair : sizes)
+	{
+		std::uniform_int_distribution<int> dist(0, static_cast<int>(pair[0] + pair[1]) * 2);
+		set<int> a, b;
+		while (a.size() < pair[0])
+			a.insert(dist(rng));
+		while (b.size() < pair[1])
+			b.insert(dist(rng));
+
+		std::vector<int> va = to_vector(a), vb = to_vector(b), expected;
+
+		std::set_union(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+		set<int> u = set_union(a, b);
+		assert(to_vector(u) == expected && u.size() == expected.size());
+
+		expected.clear();
+		std::set_intersection(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+		set<int> i = set_intersection(a, b);
+		assert(to_vector(i) == expected && i.size() == expected.size());
+
+		expected.clear();
+		std::set_difference(va.begin(), va.end(), vb.begin(), vb.end(), std::back_inserter(expected));
+		set<int> d = set_difference(a, b);
+		assert(to_vector(d) == expected && d.size() == expected.size());
+
+		assert(includes(a, b) == std::includes(va.begin(), va.end(), vb.begin(), vb.end()));
+		assert(includes(u, a) && includes(u, b) && includes(a, i) && includes(a, d));
+	}
+
+	// b sottoinsieme di a, sia con merge che con lookup
+	set<int> big;
+	for (int k = 0; k < 10000; k++)
+	{
+		big.insert(k);
+	}
+	set<int> few;
+	few.insert(10);
+	few.insert(9999);
+	assert(includes(big, few) && !includes(few, big));
+	few.insert(10000);
+	assert(!includes(big, few));
+
+	// il risultato e' un set normale: resta modificabile
+	set<int> diff = set_difference(big, few);
+	assert(diff.size() == 9998 && !diff.contains(10) && diff.insert(10) && diff.erase(0));
+
+	// comparatore del set
+	set<int, SetTreeType::RedBlackTree, std::greater<int>> x, y;
+	for (int k = 0; k < 10; k++)
+	{
+		x.insert(k);
+		y.insert(k + 5);
+	}
+	auto merged = set_union(x, y);
+	assert(merged.size() == 15 && *merged.begin() == 14);
+	assert(to_vector(set_intersection(x, y)) == std::vector<int>({ 9, 8, 7, 6, 5 }));
+
+	std::cout << "OK\n";
+}
+
+void test_find_batch()
+{
+	std::cout << "Test: find_batch... ";
+
+	std::mt19937 rng(50);
+	std::uniform_int_distribution<int> dist(0, 100000);
+
+	set<int> rb;
+	set<int, SetTreeType::BinarySearchTree> bst;
+	for (int i = 0; i < 30000; i++)
+	{
+		int key = dist(rng);
+		rb.insert(key);
+		bst.insert(key);
+	}
+
+	// 1003 chiavi: l'ultimo gruppo e' incompleto
+	std::vector<int> keys(1003);
+	for (int& key : keys)
+	{
+		key = dist(rng);
+	}
+
+	std::unique_ptr<bool[]> found(new bool[keys.size()]);
+	rb.find_batch(keys.data(), keys.size(), found.get());
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		assert(found[i] == rb.find(keys[i]));
+	}
+
+	bst.find_batch(keys.data(), keys.size(), found.get());
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		assert(found[i] == bst.find(keys[i]));
+	}
+
+	set<int> empty;
+	bool flag = true;
+	empty.find_batch(keys.data(), 1, &flag);
+	assert(!flag);
+
+	std::cout << "OK\n";
+}
+
+// migliore di tre esecuzioni, in microsecondi
+template<typename Func>
+long long best_of_three(Func func)
+{
+	long long best = -1;
+	for (int run = 0; run < 3; run++)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		func();
+		auto end = std::chrono::high_resolution_clock::now();
+		long long elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		if (best < 0 || elapsed < best)
+			best = elapsed;
+	}
+	return best;
+}
+
+void benchmark_set_algebra()
+{
+	std::cout << "\n=== BENCHMARK: set_intersection VS contains() ===" << std::endl;
+
+	const size_t LARGE = 1000000;
+	std::vector<int> keys(LARGE);
+	for (size_t k = 0; k < LARGE; k++)
+	{
+		keys[k] = static_cast<int>(k * 2);
+	}
+	auto large = set<int>::from_sorted(keys.begin(), keys.end());
+
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> dist(0, static_cast<int>(LARGE) * 2);
+
+	const size_t small_sizes[] = { 100, 10000, 1000000 };
+	for (size_t small_size : small_sizes)
+	{
+		set<int> small;
+		while (small.size() < small_size)
+			small.insert(dist(rng));
+
+		// approccio precedente: scorrere un set e interrogare l'altro, inserendo uno alla volta
+		size_t naive_size = 0;
+		long long naive_us = best_of_three([&]()
+		{
+			set<int> naive;
+			for (int v : small)
+			{
+				if (large.contains(v))
+					naive.insert(v);
+			}
+			naive_size = naive.size();
+		});
+
+		size_t result_size = 0;
+		long long intersection_us = best_of_three([&]()
+		{
+			result_size = set_intersection(small, large).size();
+		});
+
+		long long difference_us = best_of_three([&]()
+		{
+			set_difference(small, large);
+		});
+
+		long long union_us = best_of_three([&]()
+		{
+			set_union(small, large);
+		});
+
+		assert(naive_size == result_size);
+		std::cout << small_size << " : " << LARGE << " -> contains + insert: " << naive_us << " us, set_intersection: "
+			<< intersection_us << " us, set_difference: " << difference_us << " us, set_union: " << union_us << " us" << std::endl;
+	}
+}
+
+void benchmark_find_batch()
+{
+	std::cout << "\n=== BENCHMARK: find_batch VS find() IN UN CICLO ===" << std::endl;
+
+	const size_t LOOKUPS = 2000000;
+	const size_t BLOCK = 256;
+	const int sizes[] = { 10000, 1000000 };
+
+	for (int n : sizes)
+	{
+		std::mt19937 rng(n);
+		std::uniform_int_distribution<int> dist(0, n * 2);
+		set<int> s;
+		for (int i = 0; i < n; i++)
+		{
+			s.insert(dist(rng));
+		}
+
+		std::vector<int> queries(LOOKUPS);
+		for (int& query : queries)
+		{
+			query = dist(rng);
+		}
+
+		size_t scalar_hits = 0;
+		long long scalar_us = best_of_three([&]()
+		{
+			scalar_hits = 0;
+			for (int query : queries)
+			{
+				scalar_hits += s.find(query);
+			}
+		});
+
+		size_t batch_hits = 0;
+		long long batch_us = best_of_three([&]()
+		{
+			bool found[BLOCK];
+			batch_hits = 0;
+			for (size_t first = 0; first < LOOKUPS; first += BLOCK)
+			{
+				size_t count = std::min(BLOCK, LOOKUPS - first);
+				s.find_batch(queries.data() + first, count, found);
+				for (size_t i = 0; i < count; i++)
+				{
+					batch_hits += found[i];
+				}
+			}
+		});
+
+		assert(scalar_hits == batch_hits);
+		std::cout << s.size() << " chiavi -> find: " << scalar_us * 1000 / LOOKUPS << " ns/chiave, find_batch (blocchi da "
+			<< BLOCK << "): " << batch_us * 1000 / LOOKUPS << " ns/chiave" << std::endl;
+	}
+}
+
 void test_visual_demonstration()
 {
 	std::cout << "\n=== DIMOSTRAZIONE VISIVA ===" << std::endl;
@@ -466,6 +949,62 @@ void test_visual_demonstration()
 
 // ==================== MAIN ====================
 
+void test_arena_allocator()
+{
+	std::cout << "Test: arena_allocator... ";
+
+	typedef set<int, SetTreeType::RedBlackTree, std::less<int>, arena_allocator<int>> ArenaSet;
+
+	ArenaSet s;
+	for (int i = 0; i < 10000; i++)
+	{
+		s.insert((i * 7919) % 10000);
+	}
+	assert(s.size() == 10000);
+	assert(s.get_allocator().resource().slab_count() > 0);
+
+	for (int i = 0; i < 10000; i += 2)
+	{
+		assert(s.erase(i));
+	}
+	assert(s.size() == 5000 && s.contains(1) && !s.contains(2));
+
+	// la copia riceve un'arena propria
+	ArenaSet copy(s);
+	assert(copy.get_allocator() != s.get_allocator());
+	s.clear();
+	assert(s.empty() && copy.size() == 5000 && copy.contains(9999));
+
+	// dopo clear() l'arena e' di nuovo utilizzabile
+	s.insert(42);
+	assert(s.contains(42) && s.size() == 1);
+
+	// il move passa l'arena, il set spostato ne riceve una nuova
+	ArenaSet moved(std::move(copy));
+	assert(moved.size() == 5000 && copy.empty());
+	copy.insert(1);
+	assert(copy.contains(1) && moved.contains(1));
+	assert(copy.get_allocator() != moved.get_allocator());
+
+	// unica proprietaria dell'arena: clear() restituisce gli slab in blocco
+	s = std::move(moved);
+	assert(s.size() == 5000 && moved.empty());
+	s.clear();
+	assert(s.get_allocator().resource().slab_count() == 0);
+
+	// chiavi con distruttore: la visita resta, gli slab vengono comunque rilasciati in blocco
+	set<std::string, SetTreeType::RedBlackTree, std::less<std::string>, arena_allocator<std::string>> words;
+	for (int i = 0; i < 1000; i++)
+	{
+		words.insert("parola-lunga-abbastanza-da-allocare-" + std::to_string(i));
+	}
+	assert(words.size() == 1000);
+	words.clear();
+	assert(words.empty());
+
+	std::cout << "OK\n";
+}
+
 int main()
 {
 	std::cout << "\n";
@@ -488,6 +1027,7 @@ int main()
 
 	std::cout << "\n--- TEST ITERATOR ---\n";
 	test_iterator();
+	test_stackless_iterator();
 
 	std::cout << "\n--- TEST EDGE CASES ---\n";
 	test_empty_operations();
@@ -501,12 +1041,21 @@ int main()
 	std::cout << "\n--- TEST VARI ---\n";
 	test_different_types();
 	test_order_verification();
+	test_custom_comparator();
+	test_transparent_lookup();
+	test_from_sorted_and_bulk_insert();
+	test_arena_allocator();
+	test_set_algebra();
+	test_find_batch();
 
 	std::cout << "\n";
 	std::cout << "========================================" << std::endl;
 	std::cout << "       TUTTI I TEST SONO PASSATI!" << std::endl;
 	std::cout << "========================================" << std::endl;
 
+	benchmark_set_algebra();
+	benchmark_find_batch();
+
 	test_visual_demonstration();
 
 	return 0;
@@ -0,0 +1,580 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace STDev
+{
+	// Skip list ordinata con la stessa interfaccia di map (insert/find/erase/operator[]/iteratori).
+	// Niente rotazioni: un inserimento modifica solo i link dei predecessori, uno per livello,
+	// quindi si puo' pubblicare con una CAS per livello senza lock.
+	//
+	// Concorrenza:
+	// - try_insert, operator[], find, at, contains, lower_bound, for_each_in_range e l'iterazione
+	//   sono sicure tra loro da piu' thread (lock-free: i nodi non vengono mai liberati mentre
+	//   la skip list e' condivisa, quindi un lettore non vede mai memoria rilasciata)
+	// - insert su una chiave esistente sovrascrive il valore senza sincronizzazione, come una
+	//   normale assegnazione: non va fatta mentre altri thread leggono la stessa chiave
+	// - erase, clear, copia e move richiedono accesso esclusivo
+	template<typename K, typename T>
+	class skip_list_map
+	{
+	public:
+
+		static const int MAX_LEVEL = 16; // con p = 1/4 basta fino a ~4^16 elementi
+
+	private:
+
+		typedef std::pair<const K, T> value_type;
+
+		struct Node;
+		typedef std::atomic<Node*> Link;
+
+		// il nodo e' allocato con height link in coda (nodi alti rari: in media 1.33 link per nodo)
+		struct alignas(Link) Node
+		{
+			value_type data;
+			int height;
+
+			Node(const K& key, const T& value, int h) : data{ key, value }, height(h)
+			{}
+
+			Link* next()
+			{
+				return reinterpret_cast<Link*>(this + 1);
+			}
+
+			const Link* next() const
+			{
+				return reinterpret_cast<const Link*>(this + 1);
+			}
+		};
+
+		Link head[MAX_LEVEL];           // link della sentinella, nessun valore (T non deve essere default-constructible)
+		std::atomic<int> _level;        // altezza massima in uso, solo un suggerimento per le ricerche
+		std::atomic<size_t> _size;
+
+		static Node* create_node(const K& key, const T& value, int height)
+		{
+			void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+			Node* node = new (memory) Node(key, value, height);
+			for (int i = 0; i < height; ++i)
+			{
+				new (&node->next()[i]) Link(nullptr);
+			}
+			return node;
+		}
+
+		static void destroy_node(Node* node)
+		{
+			node->~Node(); // i Link sono banalmente distruttibili
+			::operator delete(node);
+		}
+
+		// livello geometrico con p = 1/4: due bit a zero per ogni livello in piu'
+		static int random_level()
+		{
+			thread_local uint32_t state = 0;
+			if (state == 0)
+			{
+				static std::atomic<uint32_t> seed{ 0x9E3779B9u };
+				state = seed.fetch_add(0x6D2B79F5u, std::memory_order_relaxed) | 1u;
+			}
+
+			// xorshift32
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+
+			uint32_t bits = state;
+			int level = 1;
+			while (level < MAX_LEVEL && (bits & 3u) == 0)
+			{
+				++level;
+				bits >>= 2;
+			}
+			return level;
+		}
+
+		Link* head_links() const
+		{
+			return const_cast<Link*>(head);
+		}
+
+		// per ogni livello: preds[i] = link dell'ultimo nodo con chiave < key, succs[i] = il nodo dopo.
+		// Scende da MAX_LEVEL e non dal suggerimento _level: un livello saltato lascerebbe
+		// preds sbagliati per un nodo alto appena pubblicato.
+		bool find_position(const K& key, Link** preds, Node** succs) const
+		{
+			Link* links = head_links();
+			for (int i = MAX_LEVEL - 1; i >= 0; --i)
+			{
+				Node* next = links[i].load(std::memory_order_acquire);
+				while (next != nullptr && next->data.first < key)
+				{
+					links = next->next();
+					next = links[i].load(std::memory_order_acquire);
+				}
+				preds[i] = links;
+				succs[i] = next;
+			}
+			return succs[0] != nullptr && !(key < succs[0]->data.first);
+		}
+
+		// primo nodo con chiave >= key
+		Node* lower_bound_node(const K& key) const
+		{
+			Link* links = head_links();
+			Node* next = nullptr;
+			for (int i = _level.load(std::memory_order_relaxed) - 1; i >= 0; --i)
+			{
+				next = links[i].load(std::memory_order_acquire);
+				while (next != nullptr && next->data.first < key)
+				{
+					links = next->next();
+					next = links[i].load(std::memory_order_acquire);
+				}
+			}
+			return next;
+		}
+
+		Node* find_node(const K& key) const
+		{
+			Node* node = lower_bound_node(key);
+			if (node != nullptr && !(key < node->data.first))
+				return node;
+			return nullptr;
+		}
+
+		void raise_level(int height)
+		{
+			int current = _level.load(std::memory_order_relaxed);
+			while (current < height &&
+				!_level.compare_exchange_weak(current, height, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void destroy_all()
+		{
+			Node* current = head[0].load(std::memory_order_relaxed);
+			while (current != nullptr)
+			{
+				Node* next = current->next()[0].load(std::memory_order_relaxed);
+				destroy_node(current);
+				current = next;
+			}
+
+			for (int i = 0; i < MAX_LEVEL; ++i)
+			{
+				head[i].store(nullptr, std::memory_order_relaxed);
+			}
+			_level.store(1, std::memory_order_relaxed);
+			_size.store(0, std::memory_order_relaxed);
+		}
+
+		// le chiavi arrivano gia' ordinate: si appende in coda a ogni livello, O(n)
+		void copy_from(const skip_list_map& other)
+		{
+			Link* tails[MAX_LEVEL];
+			for (int i = 0; i < MAX_LEVEL; ++i)
+			{
+				tails[i] = head;
+			}
+
+			int level = 1;
+			size_t count = 0;
+			for (const Node* current = other.head[0].load(std::memory_order_acquire); current != nullptr;
+				current = current->next()[0].load(std::memory_order_acquire))
+			{
+				Node* node = create_node(current->data.first, current->data.second, current->height);
+				for (int i = 0; i < node->height; ++i)
+				{
+					tails[i][i].store(node, std::memory_order_relaxed);
+					tails[i] = node->next();
+				}
+				if (node->height > level)
+					level = node->height;
+				++count;
+			}
+
+			_level.store(level, std::memory_order_relaxed);
+			_size.store(count, std::memory_order_release);
+		}
+
+		void steal(skip_list_map& other)
+		{
+			for (int i = 0; i < MAX_LEVEL; ++i)
+			{
+				head[i].store(other.head[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				other.head[i].store(nullptr, std::memory_order_relaxed);
+			}
+			_level.store(other._level.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			_size.store(other._size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			other._level.store(1, std::memory_order_relaxed);
+			other._size.store(0, std::memory_order_relaxed);
+		}
+
+	public:
+
+		class iterator;
+		class const_iterator;
+
+		skip_list_map() : _level(1), _size(0)
+		{
+			for (int i = 0; i < MAX_LEVEL; ++i)
+			{
+				head[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+
+		~skip_list_map()
+		{
+			destroy_all();
+		}
+
+		skip_list_map(const skip_list_map& other) : skip_list_map()
+		{
+			copy_from(other);
+		}
+
+		skip_list_map& operator=(const skip_list_map& other)
+		{
+			if (this != &other)
+			{
+				destroy_all();
+				copy_from(other);
+			}
+			return *this;
+		}
+
+		skip_list_map(skip_list_map&& other) noexcept : skip_list_map()
+		{
+			steal(other);
+		}
+
+		skip_list_map& operator=(skip_list_map&& other) noexcept
+		{
+			if (this != &other)
+			{
+				destroy_all();
+				steal(other);
+			}
+			return *this;
+		}
+
+		// inserisce solo se la chiave manca; ritorna il nodo della chiave e true se e' nuovo.
+		// Lock-free: il nodo diventa visibile con la CAS al livello 0, i livelli alti sono
+		// solo scorciatoie e vengono collegati dopo, uno alla volta.
+		std::pair<iterator, bool> try_insert(const K& key, const T& value)
+		{
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+
+			if (find_position(key, preds, succs))
+				return { iterator(succs[0]), false };
+
+			int height = random_level();
+			Node* node = create_node(key, value, height);
+			raise_level(height);
+
+			while (true)
+			{
+				node->next()[0].store(succs[0], std::memory_order_relaxed);
+				if (preds[0][0].compare_exchange_strong(succs[0], node,
+					std::memory_order_release, std::memory_order_relaxed))
+					break;
+
+				// un altro thread ha inserito tra pred e succ: ricalcola (magari era la stessa chiave)
+				if (find_position(key, preds, succs))
+				{
+					destroy_node(node); // mai pubblicato
+					return { iterator(succs[0]), false };
+				}
+			}
+			_size.fetch_add(1, std::memory_order_relaxed);
+
+			for (int i = 1; i < height; ++i)
+			{
+				while (true)
+				{
+					node->next()[i].store(succs[i], std::memory_order_relaxed);
+					if (preds[i][i].compare_exchange_strong(succs[i], node,
+						std::memory_order_release, std::memory_order_relaxed))
+						break;
+
+					// il nodo e' gia' al livello 0, quindi find_position lo trova: interessano
+					// solo i preds/succs dei livelli non ancora collegati
+					find_position(key, preds, succs);
+				}
+			}
+
+			return { iterator(node), true };
+		}
+
+		// come map::insert: una chiave esistente viene sovrascritta
+		void insert(const K& key, const T& value)
+		{
+			std::pair<iterator, bool> result = try_insert(key, value);
+			if (!result.second)
+			{
+				result.first->second = value;
+			}
+		}
+
+		// T() viene costruito solo se la chiave manca
+		T& operator[](const K& key)
+		{
+			Node* node = find_node(key);
+			if (node != nullptr)
+				return node->data.second;
+			return try_insert(key, T()).first->second;
+		}
+
+		// come map::find: end() se la chiave manca
+		iterator find(const K& key)
+		{
+			return iterator(find_node(key));
+		}
+
+		const_iterator find(const K& key) const
+		{
+			return const_iterator(find_node(key));
+		}
+
+		bool contains(const K& key) const
+		{
+			return find_node(key) != nullptr;
+		}
+
+		T& at(const K& key)
+		{
+			Node* node = find_node(key);
+			if (!node)
+				throw std::out_of_range("skip_list_map::at: key not found");
+			return node->data.second;
+		}
+
+		const T& at(const K& key) const
+		{
+			Node* node = find_node(key);
+			if (!node)
+				throw std::out_of_range("skip_list_map::at: key not found");
+			return node->data.second;
+		}
+
+		// richiede accesso esclusivo: il nodo viene liberato subito
+		bool erase(const K& key)
+		{
+			Link* preds[MAX_LEVEL];
+			Node* succs[MAX_LEVEL];
+
+			if (!find_position(key, preds, succs))
+				return false;
+
+			Node* node = succs[0];
+			for (int i = 0; i < node->height; ++i)
+			{
+				preds[i][i].store(node->next()[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+
+			while (_level.load(std::memory_order_relaxed) > 1 &&
+				head[_level.load(std::memory_order_relaxed) - 1].load(std::memory_order_relaxed) == nullptr)
+			{
+				_level.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			destroy_node(node);
+			_size.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		void clear()
+		{
+			destroy_all();
+		}
+
+		iterator lower_bound(const K& key)
+		{
+			return iterator(lower_bound_node(key));
+		}
+
+		const_iterator lower_bound(const K& key) const
+		{
+			return const_iterator(lower_bound_node(key));
+		}
+
+		// visita in ordine le coppie con first <= chiave < last: O(log n + k).
+		// Sicura durante inserimenti concorrenti (vede o no i nodi appena pubblicati).
+		template<typename Func>
+		void for_each_in_range(const K& first, const K& last, Func func) const
+		{
+			for (const Node* node = lower_bound_node(first); node != nullptr && node->data.first < last;
+				node = node->next()[0].load(std::memory_order_acquire))
+			{
+				func(node->data);
+			}
+		}
+
+		size_t size() const
+		{
+			return _size.load(std::memory_order_relaxed);
+		}
+
+		bool empty() const
+		{
+			return size() == 0;
+		}
+
+		int level() const
+		{
+			return _level.load(std::memory_order_relaxed);
+		}
+
+		void print_structure() const
+		{
+			std::cout << "\n=== SKIP_LIST_MAP STRUCTURE ===" << std::endl;
+			std::cout << "Size: " << size() << "  Levels: " << level() << "\n" << std::endl;
+
+			for (int i = level() - 1; i >= 0; --i)
+			{
+				std::cout << "L" << i << ": HEAD";
+				for (const Node* node = head[i].load(std::memory_order_acquire); node != nullptr;
+					node = node->next()[i].load(std::memory_order_acquire))
+				{
+					std::cout << " -> [" << node->data.first << ":" << node->data.second << "]";
+				}
+				std::cout << " -> NULL" << std::endl;
+			}
+			std::cout << "===============================\n" << std::endl;
+		}
+
+		class iterator // forward iterator sul livello 0
+		{
+		private:
+			Node* current;
+
+		public:
+			iterator(Node* node = nullptr) : current(node)
+			{}
+
+			value_type& operator*() const
+			{
+				return current->data;
+			}
+
+			value_type* operator->() const
+			{
+				return &(current->data);
+			}
+
+			iterator& operator++()
+			{
+				current = current->next()[0].load(std::memory_order_acquire);
+				return *this;
+			}
+
+			iterator operator++(int)
+			{
+				iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const iterator& other) const
+			{
+				return current != other.current;
+			}
+
+			friend class skip_list_map;
+			friend class const_iterator;
+		};//end iterator class
+
+		class const_iterator
+		{
+		private:
+			const Node* current;
+
+		public:
+			const_iterator(const Node* node = nullptr) : current(node)
+			{}
+
+			const_iterator(const iterator& it) : current(it.current)
+			{}
+
+			const value_type& operator*() const
+			{
+				return current->data;
+			}
+
+			const value_type* operator->() const
+			{
+				return &(current->data);
+			}
+
+			const_iterator& operator++()
+			{
+				current = current->next()[0].load(std::memory_order_acquire);
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return current == other.current;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return current != other.current;
+			}
+
+			friend class skip_list_map;
+		};//end const_iterator class
+
+		iterator begin()
+		{
+			return iterator(head[0].load(std::memory_order_acquire));
+		}
+
+		iterator end()
+		{
+			return iterator(nullptr);
+		}
+
+		const_iterator begin() const
+		{
+			return const_iterator(head[0].load(std::memory_order_acquire));
+		}
+
+		const_iterator end() const
+		{
+			return const_iterator(nullptr);
+		}
+
+		const_iterator cbegin() const
+		{
+			return begin();
+		}
+
+		const_iterator cend() const
+		{
+			return end();
+		}
+	};
+}
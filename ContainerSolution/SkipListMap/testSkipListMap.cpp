@@ -0,0 +1,666 @@
+#include "skip_list_map.h"
+#include "map.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+template<typename Map>
+bool is_sorted_map(const Map& m)
+{
+	bool first = true;
+	int previous = 0;
+	size_t count = 0;
+	for (const auto& pair : m)
+	{
+		if (!first && !(previous < pair.first))
+			return false;
+		previous = pair.first;
+		first = false;
+		count++;
+	}
+	return count == m.size();
+}
+
+// ==================== TEST FUNCTIONS ====================
+
+void test_basic_operations()
+{
+	section_header("TEST 1: BASIC OPERATIONS");
+
+	skip_list_map<int, std::string> m;
+
+	test_assert(m.empty(), "New skip list is empty");
+	test_assert(m.size() == 0, "New skip list size is 0");
+
+	m.insert(5, "five");
+	test_assert(!m.empty(), "Not empty after insert");
+	test_assert(m.size() == 1, "Size is 1 after insert");
+
+	auto found = m.find(5);
+	test_assert(found != m.end() && found->first == 5 && found->second == "five", "Find existing key");
+	test_assert(m.find(10) == m.end(), "Don't find non-existing key");
+	const skip_list_map<int, std::string>& cm = m;
+	test_assert(cm.find(5) == cm.begin() && cm.find(10) == cm.end(), "const find");
+	test_assert(m.at(5) == "five", "at() returns correct value");
+
+	m.insert(5, "FIVE");
+	test_assert(m.size() == 1, "Insert on existing key does not grow");
+	test_assert(m.at(5) == "FIVE", "Insert on existing key overwrites (like map)");
+
+	auto result = m.try_insert(5, "cinque");
+	test_assert(!result.second, "try_insert on existing key returns false");
+	test_assert(result.first->second == "FIVE", "try_insert does not overwrite");
+
+	result = m.try_insert(3, "three");
+	test_assert(result.second && result.first->first == 3, "try_insert on new key returns the new node");
+
+	bool thrown = false;
+	try
+	{
+		m.at(100);
+	}
+	catch (const std::out_of_range&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "at() throws on missing key");
+}
+
+struct DefaultCounted
+{
+	static int constructed;
+	int value;
+
+	DefaultCounted() : value(0) { constructed++; }
+};
+
+int DefaultCounted::constructed = 0;
+
+void test_operator_bracket()
+{
+	section_header("TEST 2: OPERATOR[]");
+
+	skip_list_map<std::string, int> m;
+
+	m["apple"] = 5;
+	m["banana"] = 3;
+	test_assert(m.size() == 2, "operator[] inserts new keys");
+	test_assert(m["apple"] == 5, "operator[] reads existing key");
+
+	m["apple"] += 10;
+	test_assert(m.at("apple") == 15, "operator[] returns a modifiable reference");
+
+	int missing = m["cherry"];
+	test_assert(missing == 0 && m.size() == 3, "operator[] default-constructs missing value");
+
+	// su una chiave esistente non si costruisce nessun valore
+	skip_list_map<int, DefaultCounted> counted;
+	counted[1].value = 7;
+	int before = DefaultCounted::constructed;
+	counted[1].value += 1;
+	test_assert(DefaultCounted::constructed == before && counted.at(1).value == 8, "operator[] on existing key constructs no value");
+}
+
+void test_erase()
+{
+	section_header("TEST 3: ERASE");
+
+	skip_list_map<int, int> m;
+	for (int i = 0; i < 100; i++)
+		m.insert(i, i * 10);
+
+	test_assert(m.erase(50), "Erase existing key returns true");
+	test_assert(!m.erase(50), "Erase missing key returns false");
+	test_assert(m.find(50) == m.end(), "Erased key is not found");
+	test_assert(m.size() == 99, "Size decreases after erase");
+
+	test_assert(m.erase(0) && m.erase(99), "Erase first and last keys");
+	test_assert(m.begin()->first == 1, "begin() moves after erasing the first key");
+
+	for (int i = 1; i < 99; i += 2)
+		m.erase(i);
+	test_assert(m.size() == 48, "Erase every odd key");
+	test_assert(is_sorted_map(m), "Order preserved after erases");
+
+	m.clear();
+	test_assert(m.empty() && m.begin() == m.end(), "clear() empties the skip list");
+
+	m.insert(7, 70);
+	test_assert(m.size() == 1 && m.at(7) == 70, "Reusable after clear()");
+}
+
+void test_iterators()
+{
+	section_header("TEST 4: ORDERED ITERATION");
+
+	skip_list_map<int, int> m;
+	int keys[] = { 50, 30, 70, 20, 40, 60, 80, 10 };
+	for (int k : keys)
+		m.insert(k, k * 2);
+
+	std::vector<int> visited;
+	for (auto it = m.begin(); it != m.end(); ++it)
+		visited.push_back(it->first);
+
+	std::vector<int> expected = { 10, 20, 30, 40, 50, 60, 70, 80 };
+	test_assert(visited == expected, "Iteration visits keys in order");
+
+	for (auto& pair : m)
+		pair.second += 1;
+	test_assert(m.at(40) == 81, "Values modifiable through iterator");
+
+	const skip_list_map<int, int>& cm = m;
+	int sum = 0;
+	for (auto it = cm.cbegin(); it != cm.cend(); ++it)
+		sum += it->first;
+	test_assert(sum == 360, "const_iterator visits all keys");
+}
+
+void test_range_scan()
+{
+	section_header("TEST 5: LOWER_BOUND AND RANGE SCAN");
+
+	skip_list_map<int, int> m;
+	for (int i = 0; i < 100; i += 10)
+		m.insert(i, i);
+
+	test_assert(m.lower_bound(30)->first == 30, "lower_bound on existing key");
+	test_assert(m.lower_bound(31)->first == 40, "lower_bound between keys");
+	test_assert(m.lower_bound(-5)->first == 0, "lower_bound before first key");
+	test_assert(m.lower_bound(95) == m.end(), "lower_bound after last key is end()");
+
+	std::vector<int> in_range;
+	m.for_each_in_range(25, 65, [&in_range](const std::pair<const int, int>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	std::vector<int> expected = { 30, 40, 50, 60 };
+	test_assert(in_range == expected, "for_each_in_range visits [25, 65)");
+
+	in_range.clear();
+	m.for_each_in_range(30, 30, [&in_range](const std::pair<const int, int>& pair)
+		{
+			in_range.push_back(pair.first);
+		});
+	test_assert(in_range.empty(), "Empty range visits nothing");
+}
+
+void test_copy_and_move()
+{
+	section_header("TEST 6: COPY AND MOVE");
+
+	skip_list_map<int, std::string> m1;
+	for (int i = 0; i < 50; i++)
+		m1.insert(i, std::to_string(i));
+
+	skip_list_map<int, std::string> m2(m1);
+	test_assert(m2.size() == 50 && m2.at(25) == "25", "Copy constructor copies all pairs");
+	test_assert(m2.level() == m1.level(), "Copy keeps the same tower heights");
+
+	m2.insert(25, "changed");
+	test_assert(m1.at(25) == "25", "Copy is independent");
+
+	skip_list_map<int, std::string> m3;
+	m3 = m1;
+	test_assert(m3.size() == 50 && is_sorted_map(m3), "Copy assignment");
+
+	skip_list_map<int, std::string> m4(std::move(m1));
+	test_assert(m4.size() == 50 && m1.empty(), "Move constructor steals the nodes");
+
+	m1.insert(1, "one");
+	test_assert(m1.size() == 1, "Moved-from skip list is reusable");
+
+	m3 = std::move(m4);
+	test_assert(m3.size() == 50 && m4.empty(), "Move assignment");
+}
+
+void test_stress_random()
+{
+	section_header("TEST 7: RANDOM STRESS");
+
+	const int KEYS = 5000;
+	skip_list_map<int, int> skip;
+	std::vector<int> expected(KEYS + 1, -1); // valore atteso per chiave, -1 = assente
+	size_t expected_size = 0;
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<int> key_dist(0, KEYS);
+
+	bool same = true;
+	for (int i = 0; i < 20000; i++)
+	{
+		int key = key_dist(rng);
+		if (rng() % 3 == 0)
+		{
+			if (skip.erase(key) != (expected[key] != -1))
+				same = false;
+			if (expected[key] != -1)
+				expected_size--;
+			expected[key] = -1;
+		}
+		else
+		{
+			skip.insert(key, i);
+			if (expected[key] == -1)
+				expected_size++;
+			expected[key] = i;
+		}
+	}
+
+	test_assert(same, "erase() reports presence correctly");
+	test_assert(skip.size() == expected_size, "Size matches reference");
+
+	int next_key = 0;
+	for (auto it = skip.begin(); it != skip.end() && same; ++it)
+	{
+		while (next_key <= KEYS && expected[next_key] == -1)
+			next_key++;
+		if (it->first != next_key || it->second != expected[next_key])
+			same = false;
+		next_key++;
+	}
+	test_assert(same, "Same ordered contents as reference");
+	test_assert(skip.level() <= skip_list_map<int, int>::MAX_LEVEL, "Level within MAX_LEVEL");
+}
+
+// ==================== CONCURRENCY TESTS ====================
+
+void test_concurrent_insert()
+{
+	section_header("TEST 8: CONCURRENT INSERT");
+
+	const int THREADS = 8;
+	const int PER_THREAD = 5000;
+
+	skip_list_map<int, int> m;
+	std::vector<std::thread> workers;
+	for (int t = 0; t < THREADS; t++)
+	{
+		// chiavi interlacciate: i thread inseriscono di continuo negli stessi punti
+		workers.emplace_back([&m, t]()
+			{
+				for (int i = 0; i < PER_THREAD; i++)
+					m.try_insert(i * THREADS + t, t);
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+
+	test_assert(m.size() == static_cast<size_t>(THREADS * PER_THREAD), "All disjoint keys inserted");
+	test_assert(is_sorted_map(m), "Skip list sorted after concurrent inserts");
+
+	bool all_found = true;
+	for (int k = 0; k < THREADS * PER_THREAD; k++)
+	{
+		if (!m.contains(k) || m.at(k) != k % THREADS)
+			all_found = false;
+	}
+	test_assert(all_found, "Every key found with its value");
+}
+
+void test_concurrent_same_keys()
+{
+	section_header("TEST 9: CONCURRENT INSERT OF THE SAME KEYS");
+
+	const int THREADS = 8;
+	const int KEYS = 10000;
+
+	skip_list_map<int, int> m;
+	std::atomic<int> winners{ 0 };
+	std::vector<std::thread> workers;
+	for (int t = 0; t < THREADS; t++)
+	{
+		workers.emplace_back([&m, &winners, t]()
+			{
+				for (int k = 0; k < KEYS; k++)
+				{
+					if (m.try_insert(k, t).second)
+						winners.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+
+	test_assert(m.size() == static_cast<size_t>(KEYS), "Each key inserted once");
+	test_assert(winners.load() == KEYS, "Exactly one try_insert wins per key");
+	test_assert(is_sorted_map(m), "No duplicate nodes");
+}
+
+void test_concurrent_insert_and_lookup()
+{
+	section_header("TEST 10: CONCURRENT INSERT, LOOKUP AND RANGE SCAN");
+
+	const int KEYS = 20000;
+
+	skip_list_map<int, int> m;
+	for (int k = 0; k < KEYS; k += 2)
+		m.insert(k, k);
+
+	std::atomic<bool> readers_ok{ true };
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> workers;
+
+	// due writer riempiono le chiavi dispari
+	for (int t = 0; t < 2; t++)
+	{
+		workers.emplace_back([&m, t]()
+			{
+				for (int k = 1 + 2 * t; k < KEYS; k += 4)
+					m.try_insert(k, k);
+			});
+	}
+
+	// i reader devono sempre trovare le chiavi pari e vedere range ordinati
+	for (int t = 0; t < 4; t++)
+	{
+		workers.emplace_back([&m, &readers_ok, &done, t]()
+			{
+				std::mt19937 rng(t);
+				while (!done.load(std::memory_order_acquire))
+				{
+					int key = static_cast<int>(rng() % (KEYS / 2)) * 2;
+					if (!m.contains(key) || m.at(key) != key)
+						readers_ok.store(false);
+
+					int previous = -1;
+					m.for_each_in_range(key, key + 200, [&](const std::pair<const int, int>& pair)
+						{
+							if (pair.first <= previous || pair.second != pair.first)
+								readers_ok.store(false);
+							previous = pair.first;
+						});
+				}
+			});
+	}
+
+	workers[0].join();
+	workers[1].join();
+	done.store(true, std::memory_order_release);
+	for (size_t i = 2; i < workers.size(); i++)
+		workers[i].join();
+
+	test_assert(readers_ok.load(), "Readers always see existing keys and ordered ranges");
+	test_assert(m.size() == static_cast<size_t>(KEYS), "All odd keys added by writers");
+	test_assert(is_sorted_map(m), "Final skip list sorted");
+}
+
+// ==================== BENCHMARKS ====================
+
+// map non e' thread-safe: per il confronto multi-thread la si protegge con un shared_mutex
+// (lookup in lettura condivisa, insert in esclusiva)
+class locked_tree_map
+{
+private:
+	STDev::map<int, int> tree;
+	mutable std::shared_mutex mutex;
+
+public:
+	// stessa semantica di try_insert: una chiave esistente non viene toccata
+	void insert(int key, int value)
+	{
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		tree.try_emplace(key, value);
+	}
+
+	bool find(int key) const
+	{
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return tree.contains(key);
+	}
+};
+
+class concurrent_skip_map
+{
+private:
+	skip_list_map<int, int> skip;
+
+public:
+	void insert(int key, int value)
+	{
+		skip.try_insert(key, value);
+	}
+
+	bool find(int key) const
+	{
+		return skip.contains(key);
+	}
+};
+
+// ogni thread esegue la sua fetta della traccia: 1 insert ogni 10 operazioni, il resto lookup
+template<typename Map>
+long long run_mixed_threads(Map& m, const std::vector<int>& trace, int threads)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	std::vector<std::thread> workers;
+	size_t chunk = trace.size() / threads;
+	for (int t = 0; t < threads; t++)
+	{
+		workers.emplace_back([&m, &trace, chunk, t]()
+			{
+				size_t found = 0;
+				for (size_t i = t * chunk; i < (t + 1) * chunk; i++)
+				{
+					if (i % 10 == 0)
+						m.insert(trace[i], static_cast<int>(i));
+					else
+						found += m.find(trace[i]);
+				}
+				volatile size_t sink = found;
+				(void)sink;
+			});
+	}
+	for (auto& w : workers)
+		w.join();
+
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+void benchmark_single_thread()
+{
+	section_header("BENCHMARK 1: SINGLE-THREADED SKIP LIST VS RB-TREE");
+
+	const int N = 200000;
+	std::vector<int> keys(N);
+	for (int i = 0; i < N; i++)
+		keys[i] = i;
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+	std::cout << "\nElementi: " << N << " (chiavi casuali)" << std::endl;
+	std::cout << "Operation\tRB-Tree(ms)\tSkipList(ms)" << std::endl;
+	std::cout << "----------------------------------------------" << std::endl;
+
+	STDev::map<int, int> tree;
+	skip_list_map<int, int> skip;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int k : keys)
+		tree.insert(k, k);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto tree_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int k : keys)
+		skip.insert(k, k);
+	end = std::chrono::high_resolution_clock::now();
+	auto skip_insert = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "Insert\t\t" << tree_insert << "\t\t" << skip_insert << std::endl;
+
+	size_t found = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (int k : keys)
+		found += tree.contains(k);
+	end = std::chrono::high_resolution_clock::now();
+	auto tree_find = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int k : keys)
+		found += skip.contains(k);
+	end = std::chrono::high_resolution_clock::now();
+	auto skip_find = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "Find\t\t" << tree_find << "\t\t" << skip_find << std::endl;
+
+	long long sum = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& pair : tree)
+		sum += pair.second;
+	end = std::chrono::high_resolution_clock::now();
+	auto tree_scan = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& pair : skip)
+		sum += pair.second;
+	end = std::chrono::high_resolution_clock::now();
+	auto skip_scan = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+	std::cout << "Full scan\t" << tree_scan << "\t\t" << skip_scan << std::endl;
+	std::cout << "(checksum " << found << " / " << sum << ", skip list levels: " << skip.level() << ")" << std::endl;
+}
+
+void benchmark_multithreaded()
+{
+	section_header("BENCHMARK 2: MULTI-THREADED MIXED WORKLOAD (90% FIND, 10% INSERT)");
+
+	const int KEYS = 100000;
+	const size_t OPS = 2000000;
+
+	std::mt19937 rng(7);
+	std::vector<int> trace(OPS);
+	for (size_t i = 0; i < OPS; i++)
+		trace[i] = static_cast<int>(rng() % (2 * KEYS));
+
+	std::cout << "\nOperazioni totali: " << OPS << ", hardware threads: "
+		<< std::thread::hardware_concurrency() << std::endl;
+	std::cout << "Threads\tRB-Tree + shared_mutex(ms)\tSkipList lock-free(ms)" << std::endl;
+	std::cout << "--------------------------------------------------------------" << std::endl;
+
+	int thread_counts[] = { 1, 8 };
+	for (int threads : thread_counts)
+	{
+		locked_tree_map tree;
+		concurrent_skip_map skip;
+		for (int k = 0; k < KEYS; k++)
+		{
+			tree.insert(k * 2, k);
+			skip.insert(k * 2, k);
+		}
+
+		long long tree_ms = run_mixed_threads(tree, trace, threads);
+		long long skip_ms = run_mixed_threads(skip, trace, threads);
+
+		std::cout << threads << "\t" << tree_ms << "\t\t\t\t" << skip_ms << std::endl;
+	}
+
+	std::cout << "\nNote: ogni insert sull'RB-Tree blocca tutti i lettori; nella skip list" << std::endl;
+	std::cout << "      insert e lookup procedono in parallelo (una CAS per livello)." << std::endl;
+}
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	skip_list_map<int, std::string> m;
+	int keys[] = { 30, 10, 50, 20, 40, 60, 70, 5 };
+	for (int k : keys)
+		m.insert(k, std::to_string(k));
+
+	m.print_structure();
+}
+
+// ==================== MAIN ====================
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   SKIP_LIST_MAP TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_basic_operations();
+	test_operator_bracket();
+	test_erase();
+	test_iterators();
+	test_range_scan();
+	test_copy_and_move();
+	test_stress_random();
+
+	test_concurrent_insert();
+	test_concurrent_same_keys();
+	test_concurrent_insert_and_lookup();
+
+	g_stats.print_summary();
+
+	benchmark_single_thread();
+	benchmark_multithreaded();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}
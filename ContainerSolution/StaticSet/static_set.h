@@ -0,0 +1,398 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "set.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <xmmintrin.h>
+#endif
+
+namespace STDev
+{
+	// Set ordinato immutabile in layout di Eytzinger: l'array contiene l'albero binario di
+	// ricerca completo in ordine BFS, 1-indicizzato (figli di k in 2k e 2k + 1).
+	//
+	//        [8]                  indice:  1   2   3   4   5   6   7
+	//      /     \                keys_:  [8] [4] [12][2] [6] [10][14]
+	//    [4]     [12]
+	//   /  \     /  \             i primi livelli stanno nelle prime cache line e restano in cache,
+	// [2]  [6] [10] [14]          i discendenti di k a distanza 4 sono contigui (16k .. 16k + 15)
+	//
+	// - contains / lower_bound: discesa senza salti (k = 2k + (keys_[k] < key)) con prefetch
+	//   della cache line dei discendenti di 4 livelli piu' in basso (per chiavi da 4 byte)
+	// - contains_batch / lower_bound_batch: piu' discese intrecciate a livelli, per sovrapporre
+	//   i cache miss di chiavi diverse
+	// - costruzione O(n) da un set o da un intervallo ordinato, poi nessuna modifica
+	// - l'iterazione e' in ordine, ma salta per l'array (successore nell'albero implicito)
+	template<typename K, typename Compare = std::less<K>>
+	class static_set
+	{
+	private:
+
+		static constexpr size_t CACHE_LINE = 64;
+		// una cache line contiene i discendenti di k a distanza log2(KEYS_PER_LINE)
+		static constexpr size_t KEYS_PER_LINE = sizeof(K) < CACHE_LINE ? CACHE_LINE / sizeof(K) : 1;
+		static constexpr size_t BATCH_LANES = 16;
+
+		// array allineato alla cache line: keys_[16k .. 16k + 15] e' una sola riga
+		template<typename U>
+		struct line_allocator
+		{
+			typedef U value_type;
+
+			line_allocator() = default;
+
+			template<typename V>
+			line_allocator(const line_allocator<V>&)
+			{}
+
+			U* allocate(size_t count)
+			{
+				return static_cast<U*>(::operator new(count * sizeof(U), std::align_val_t(CACHE_LINE)));
+			}
+
+			void deallocate(U* ptr, size_t)
+			{
+				::operator delete(ptr, std::align_val_t(CACHE_LINE));
+			}
+
+			template<typename V>
+			bool operator==(const line_allocator<V>&) const { return true; }
+			template<typename V>
+			bool operator!=(const line_allocator<V>&) const { return false; }
+		};
+
+		// keys_[0] e' solo riempimento, gli elementi sono in keys_[1 .. count]
+		std::vector<K, line_allocator<K>> keys_;
+		size_t count;
+		Compare comp;
+
+		static void prefetch(const void* address)
+		{
+#if defined(_MSC_VER)
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+			__builtin_prefetch(address);
+#endif
+		}
+
+		// numero di bit 1 meno significativi consecutivi
+		static unsigned trailing_ones(size_t value)
+		{
+			value = ~value;
+#if defined(_MSC_VER) && defined(_WIN64)
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+			unsigned ones = 0;
+			while (!(value & 1))
+			{
+				value >>= 1;
+				ones++;
+			}
+			return ones;
+#else
+			return static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(value)));
+#endif
+		}
+
+		static unsigned trailing_zeros(size_t value)
+		{
+			return trailing_ones(~value);
+		}
+
+		const K* line_of_descendants(size_t index) const
+		{
+			return keys_.data() + index * KEYS_PER_LINE;
+		}
+
+		// alla fine della discesa k codifica il percorso: i bit 1 finali sono i passi a destra
+		// dopo l'ultimo passo a sinistra, che e' l'antenato cercato (0 se si e' andati sempre a destra)
+		static size_t resolve(size_t index)
+		{
+			return index >> (trailing_ones(index) + 1);
+		}
+
+		template<typename KeyLike>
+		size_t lower_index(const KeyLike& key) const
+		{
+			size_t index = 1;
+			while (index <= count)
+			{
+				prefetch(line_of_descendants(index));
+				index = 2 * index + (comp(keys_[index], key) ? 1 : 0);
+			}
+			return resolve(index);
+		}
+
+		template<typename KeyLike>
+		bool matches(size_t index, const KeyLike& key) const
+		{
+			return index != 0 && !comp(key, keys_[index]);
+		}
+
+		// G discese alla volta, un livello per giro: mentre una aspetta la memoria le altre avanzano.
+		// Le discese hanno tutte la stessa lunghezza (l'albero e' completo) a meno dell'ultimo livello
+		template<typename KeyLike, typename Sink>
+		void lower_index_batch(const KeyLike* keys, size_t key_count, Sink sink) const
+		{
+			size_t lanes[BATCH_LANES];
+			for (size_t first = 0; first < key_count; first += BATCH_LANES)
+			{
+				size_t group = std::min(BATCH_LANES, key_count - first);
+				for (size_t lane = 0; lane < group; lane++)
+					lanes[lane] = 1;
+
+				bool active = count > 0;
+				while (active)
+				{
+					active = false;
+					for (size_t lane = 0; lane < group; lane++)
+					{
+						size_t index = lanes[lane];
+						if (index > count)
+							continue;
+
+						prefetch(line_of_descendants(index));
+						lanes[lane] = 2 * index + (comp(keys_[index], keys[first + lane]) ? 1 : 0);
+						active |= lanes[lane] <= count;
+					}
+				}
+
+				for (size_t lane = 0; lane < group; lane++)
+					sink(first + lane, resolve(lanes[lane]));
+			}
+		}
+
+		// visita in ordine dell'albero implicito, senza stack
+		size_t first_index() const
+		{
+			if (count == 0)
+				return 0;
+
+			size_t index = 1;
+			while (2 * index <= count)
+				index = 2 * index;
+			return index;
+		}
+
+		size_t last_index() const
+		{
+			if (count == 0)
+				return 0;
+
+			size_t index = 1;
+			while (2 * index + 1 <= count)
+				index = 2 * index + 1;
+			return index;
+		}
+
+		size_t next_index(size_t index) const
+		{
+			if (2 * index + 1 <= count)
+			{
+				index = 2 * index + 1;
+				while (2 * index <= count)
+					index = 2 * index;
+				return index;
+			}
+			// risale finche' e' figlio destro, poi ancora un passo: 0 oltre l'ultimo
+			return index >> (trailing_ones(index) + 1);
+		}
+
+		size_t previous_index(size_t index) const
+		{
+			if (index == 0)
+				return last_index();
+
+			if (2 * index <= count)
+			{
+				index = 2 * index;
+				while (2 * index + 1 <= count)
+					index = 2 * index + 1;
+				return index;
+			}
+			return index >> (trailing_zeros(index) + 1);
+		}
+
+		// sorted: chiavi ordinate e distinte. rank[k] = posizione in ordine del nodo k
+		template<typename Source>
+		void build(Source& sorted)
+		{
+			count = sorted.size();
+			keys_.clear();
+			if (count == 0)
+				return;
+
+			std::vector<size_t> rank(count + 1);
+			size_t position = 0;
+			for (size_t index = first_index(); index != 0; index = next_index(index))
+				rank[index] = position++;
+
+			keys_.reserve(count + 1);
+			keys_.push_back(sorted[0]);
+			for (size_t index = 1; index <= count; index++)
+				keys_.push_back(std::move(sorted[rank[index]]));
+		}
+
+		bool equivalent(const K& a, const K& b) const
+		{
+			return !comp(a, b) && !comp(b, a);
+		}
+
+	public:
+
+		class const_iterator
+		{
+		private:
+			const static_set* owner;
+			size_t index;
+
+			const_iterator(const static_set* o, size_t i) : owner(o), index(i)
+			{}
+
+			friend class static_set;
+
+		public:
+			typedef std::bidirectional_iterator_tag iterator_category;
+			typedef K value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const K* pointer;
+			typedef const K& reference;
+
+			const_iterator() : owner(nullptr), index(0)
+			{}
+
+			const K& operator*() const { return owner->keys_[index]; }
+			const K* operator->() const { return &owner->keys_[index]; }
+
+			const_iterator& operator++()
+			{
+				index = owner->next_index(index);
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator temp = *this;
+				++(*this);
+				return temp;
+			}
+
+			const_iterator& operator--()
+			{
+				index = owner->previous_index(index);
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator temp = *this;
+				--(*this);
+				return temp;
+			}
+
+			bool operator==(const const_iterator& other) const { return index == other.index && owner == other.owner; }
+			bool operator!=(const const_iterator& other) const { return !(*this == other); }
+		};
+
+		typedef const_iterator iterator;
+
+		static_set() : count(0), comp()
+		{}
+
+		// stesso ordine del set: lo visita in ordine, O(n)
+		template<SetTreeType Type, typename Allocator>
+		explicit static_set(const set<K, Type, Compare, Allocator>& source) : count(0), comp(source.key_comp())
+		{
+			std::vector<K> sorted(source.begin(), source.end());
+			build(sorted);
+		}
+
+		// [first, last) deve essere ordinato secondo Compare; i duplicati vengono scartati
+		template<typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+		static_set(InputIt first, InputIt last, const Compare& compare = Compare()) : count(0), comp(compare)
+		{
+			std::vector<K> sorted(first, last);
+			for (size_t i = 1; i < sorted.size(); i++)
+			{
+				if (comp(sorted[i], sorted[i - 1]))
+					throw std::invalid_argument("static_set: range is not sorted");
+			}
+			sorted.erase(std::unique(sorted.begin(), sorted.end(), [this](const K& a, const K& b) { return equivalent(a, b); }), sorted.end());
+			build(sorted);
+		}
+
+		bool contains(const K& key) const
+		{
+			return matches(lower_index(key), key);
+		}
+
+		// ricerca eterogenea, solo con Compare::is_transparent
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		bool contains(const KeyLike& key) const
+		{
+			return matches(lower_index(key), key);
+		}
+
+		const_iterator find(const K& key) const
+		{
+			size_t index = lower_index(key);
+			return const_iterator(this, matches(index, key) ? index : 0);
+		}
+
+		const_iterator lower_bound(const K& key) const
+		{
+			return const_iterator(this, lower_index(key));
+		}
+
+		template<typename KeyLike, typename C = Compare, typename = typename C::is_transparent>
+		const_iterator lower_bound(const KeyLike& key) const
+		{
+			return const_iterator(this, lower_index(key));
+		}
+
+		const_iterator upper_bound(const K& key) const
+		{
+			size_t index = lower_index(key);
+			if (matches(index, key))
+				index = next_index(index);
+			return const_iterator(this, index);
+		}
+
+		// out[i] = contains(keys[i])
+		void contains_batch(const K* keys, size_t key_count, bool* out) const
+		{
+			lower_index_batch(keys, key_count, [this, keys, out](size_t i, size_t index) { out[i] = matches(index, keys[i]); });
+		}
+
+		// out[i] = lower_bound(keys[i])
+		void lower_bound_batch(const K* keys, size_t key_count, const_iterator* out) const
+		{
+			lower_index_batch(keys, key_count, [this, out](size_t i, size_t index) { out[i] = const_iterator(this, index); });
+		}
+
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+
+		Compare key_comp() const
+		{
+			return comp;
+		}
+
+		const_iterator begin() const { return const_iterator(this, first_index()); }
+		const_iterator end() const { return const_iterator(this, 0); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+	};
+}
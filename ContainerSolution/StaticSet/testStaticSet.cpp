@@ -0,0 +1,307 @@
+#include "static_set.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <type_traits>
+
+using namespace STDev;
+
+// ==================== UTILITIES ====================
+
+class TestStats
+{
+private:
+	int total = 0;
+	int passed = 0;
+	int failed = 0;
+
+public:
+	void record_pass() { passed++; total++; }
+	void record_fail() { failed++; total++; }
+
+	void print_summary() const
+	{
+		std::cout << "\n========================================" << std::endl;
+		std::cout << "TEST SUMMARY" << std::endl;
+		std::cout << "========================================" << std::endl;
+		std::cout << "Total tests:  " << total << std::endl;
+		std::cout << "Passed:       " << passed << " (" << (total > 0 ? (passed * 100 / total) : 0) << "%)" << std::endl;
+		std::cout << "Failed:       " << failed << std::endl;
+		std::cout << "========================================\n" << std::endl;
+	}
+};
+
+TestStats g_stats;
+
+void test_assert(bool condition, const std::string& test_name)
+{
+	if (condition)
+	{
+		std::cout << "[PASS] " << test_name << std::endl;
+		g_stats.record_pass();
+	}
+	else
+	{
+		std::cout << "[FAIL] " << test_name << std::endl;
+		g_stats.record_fail();
+	}
+}
+
+void section_header(const std::string& section_name)
+{
+	std::cout << "\n========================================" << std::endl;
+	std::cout << section_name << std::endl;
+	std::cout << "========================================" << std::endl;
+}
+
+// ==================== TESTS ====================
+
+void test_construction()
+{
+	section_header("TEST 1: CONSTRUCTION");
+
+	static_set<int> empty;
+	test_assert(empty.empty() && empty.begin() == empty.end() && !empty.contains(0), "Empty static_set");
+	test_assert(empty.lower_bound(5) == empty.end(), "lower_bound on empty set");
+
+	set<int> source;
+	for (int key : { 50, 20, 80, 10, 30, 70, 90 })
+		source.insert(key);
+
+	static_set<int> from_set(source);
+	test_assert(from_set.size() == 7 && std::equal(from_set.begin(), from_set.end(), source.begin(), source.end()), "Built from set keeps the order");
+
+	std::vector<int> sorted = { 1, 2, 2, 3, 5, 5, 5, 8 };
+	static_set<int> from_range(sorted.begin(), sorted.end());
+	test_assert(std::vector<int>(from_range.begin(), from_range.end()) == std::vector<int>({ 1, 2, 3, 5, 8 }), "Built from sorted range, duplicates dropped");
+
+	bool thrown = false;
+	try
+	{
+		std::vector<int> unsorted = { 3, 1, 2 };
+		static_set<int> bad(unsorted.begin(), unsorted.end());
+	}
+	catch (const std::invalid_argument&)
+	{
+		thrown = true;
+	}
+	test_assert(thrown, "Unsorted range throws invalid_argument");
+
+	std::vector<int> descending = { 9, 7, 4, 1 };
+	static_set<int, std::greater<int>> reversed(descending.begin(), descending.end());
+	test_assert(*reversed.begin() == 9 && reversed.contains(4) && *reversed.lower_bound(5) == 4, "Custom comparator");
+}
+
+void test_lookup_all_shapes()
+{
+	section_header("TEST 2: LOOKUP ON EVERY TREE SHAPE");
+
+	// 0..300 elementi: ultimo livello vuoto, parziale e pieno
+	bool lookups_ok = true;
+	bool iteration_ok = true;
+	for (int n = 0; n <= 300; n++)
+	{
+		std::vector<int> sorted(n);
+		for (int i = 0; i < n; i++)
+			sorted[i] = 2 * i + 1; // dispari: le chiavi pari mancano
+
+		static_set<int> s(sorted.begin(), sorted.end());
+
+		for (int key = -1; key <= 2 * n + 1; key++)
+		{
+			auto expected = std::lower_bound(sorted.begin(), sorted.end(), key);
+			auto it = s.lower_bound(key);
+			if ((expected == sorted.end()) != (it == s.end()) || (it != s.end() && *it != *expected))
+				lookups_ok = false;
+			if (s.contains(key) != (key % 2 != 0 && key > 0 && key < 2 * n))
+				lookups_ok = false;
+
+			auto upper = s.upper_bound(key);
+			auto expected_upper = std::upper_bound(sorted.begin(), sorted.end(), key);
+			if ((expected_upper == sorted.end()) != (upper == s.end()) || (upper != s.end() && *upper != *expected_upper))
+				lookups_ok = false;
+		}
+
+		std::vector<int> backwards;
+		for (auto it = s.end(); it != s.begin();)
+			backwards.push_back(*--it);
+		std::reverse(backwards.begin(), backwards.end());
+		if (std::vector<int>(s.begin(), s.end()) != sorted || backwards != sorted)
+			iteration_ok = false;
+	}
+	test_assert(lookups_ok, "contains / lower_bound / upper_bound match std::lower_bound for n = 0..300");
+	test_assert(iteration_ok, "Forward and backward iteration in sorted order");
+
+	static_assert(std::is_same<std::iterator_traits<static_set<int>::iterator>::iterator_category, std::bidirectional_iterator_tag>::value, "static_set iterator must be bidirectional");
+}
+
+void test_batch_lookup()
+{
+	section_header("TEST 3: BATCH LOOKUP");
+
+	std::mt19937 rng(48);
+	std::uniform_int_distribution<int> dist(0, 1000000);
+
+	std::vector<int> sorted(50000);
+	for (int& key : sorted)
+		key = dist(rng);
+	std::sort(sorted.begin(), sorted.end());
+	static_set<int> s(sorted.begin(), sorted.end());
+
+	// 1003 chiavi: non multiplo della dimensione del gruppo
+	std::vector<int> queries(1003);
+	for (size_t i = 0; i < queries.size(); i++)
+		queries[i] = (i % 2 == 0) ? sorted[dist(rng) % sorted.size()] : dist(rng);
+
+	std::unique_ptr<bool[]> found(new bool[queries.size()]);
+	std::vector<static_set<int>::const_iterator> bounds(queries.size());
+	s.contains_batch(queries.data(), queries.size(), found.get());
+	s.lower_bound_batch(queries.data(), queries.size(), bounds.data());
+
+	bool contains_ok = true;
+	bool bounds_ok = true;
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+		if (found[i] != s.contains(queries[i]))
+			contains_ok = false;
+		if (bounds[i] != s.lower_bound(queries[i]))
+			bounds_ok = false;
+	}
+	test_assert(contains_ok, "contains_batch matches contains");
+	test_assert(bounds_ok, "lower_bound_batch matches lower_bound");
+
+	static_set<int> empty;
+	bool flag = true;
+	empty.contains_batch(queries.data(), 1, &flag);
+	test_assert(!flag, "Batch lookup on empty set");
+}
+
+void test_strings()
+{
+	section_header("TEST 4: STRING KEYS");
+
+	set<std::string, SetTreeType::RedBlackTree, std::less<>> words;
+	for (const char* word : { "delta", "alpha", "charlie", "bravo", "echo" })
+		words.insert(word);
+
+	static_set<std::string, std::less<>> s(words);
+	test_assert(s.contains("charlie") && !s.contains("foxtrot"), "contains with std::string keys");
+	test_assert(s.contains(std::string_view("echo")) && *s.lower_bound(std::string_view("c")) == "charlie", "Transparent lookup");
+	test_assert(*s.find("bravo") == "bravo" && s.find("zulu") == s.end(), "find");
+}
+
+// ==================== BENCHMARKS ====================
+
+void benchmark_lookup()
+{
+	section_header("BENCHMARK 1: LOOKUP - static_set VS set VS SORTED ARRAY");
+
+	const int LOOKUPS = 2000000;
+	const int sizes[] = { 10000, 1000000, 4000000 };
+
+	for (int n : sizes)
+	{
+		std::mt19937 rng(n);
+		std::uniform_int_distribution<int> dist(0, n * 4);
+
+		set<int> tree;
+		for (int i = 0; i < n; i++)
+			tree.insert(dist(rng));
+
+		std::vector<int> sorted(tree.begin(), tree.end());
+		static_set<int> eytzinger(tree);
+
+		std::vector<int> queries(LOOKUPS);
+		for (int& query : queries)
+			query = dist(rng);
+
+		size_t hits[4] = { 0, 0, 0, 0 };
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+			hits[0] += tree.find(query);
+		auto end = std::chrono::high_resolution_clock::now();
+		auto tree_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+			hits[1] += std::binary_search(sorted.begin(), sorted.end(), query);
+		end = std::chrono::high_resolution_clock::now();
+		auto array_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int query : queries)
+			hits[2] += eytzinger.contains(query);
+		end = std::chrono::high_resolution_clock::now();
+		auto eytzinger_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		const size_t BLOCK = 256;
+		bool found[BLOCK];
+		start = std::chrono::high_resolution_clock::now();
+		for (size_t first = 0; first < queries.size(); first += BLOCK)
+		{
+			size_t block = std::min(BLOCK, queries.size() - first);
+			eytzinger.contains_batch(queries.data() + first, block, found);
+			for (size_t i = 0; i < block; i++)
+				hits[3] += found[i];
+		}
+		end = std::chrono::high_resolution_clock::now();
+		auto batch_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / LOOKUPS;
+
+		std::cout << "\n" << eytzinger.size() << " chiavi, " << LOOKUPS << " ricerche:" << std::endl;
+		std::cout << "  set::find (RB-Tree):         " << tree_ns << " ns/lookup" << std::endl;
+		std::cout << "  array ordinato (binary):     " << array_ns << " ns/lookup" << std::endl;
+		std::cout << "  static_set::contains:        " << eytzinger_ns << " ns/lookup" << std::endl;
+		std::cout << "  static_set::contains_batch:  " << batch_ns << " ns/lookup (blocchi da " << BLOCK << ")" << std::endl;
+		if (hits[0] != hits[1] || hits[1] != hits[2] || hits[2] != hits[3])
+			std::cout << "  RISULTATI DIVERSI!" << std::endl;
+	}
+}
+
+// ==================== VISUAL DEMO ====================
+
+void test_visual_demonstration()
+{
+	section_header("VISUAL DEMONSTRATION");
+
+	std::vector<int> sorted = { 2, 4, 6, 8, 10, 12, 14 };
+	static_set<int> s(sorted.begin(), sorted.end());
+
+	std::cout << "Ordine:    ";
+	for (int key : s)
+		std::cout << key << " ";
+	std::cout << std::endl;
+	std::cout << "lower_bound(7) = " << *s.lower_bound(7) << ", contains(12) = " << std::boolalpha << s.contains(12) << std::endl;
+}
+
+int main()
+{
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "   STATIC_SET TEST SUITE" << std::endl;
+	std::cout << "========================================" << std::endl;
+
+	test_construction();
+	test_lookup_all_shapes();
+	test_batch_lookup();
+	test_strings();
+
+	g_stats.print_summary();
+
+	benchmark_lookup();
+
+	test_visual_demonstration();
+
+	std::cout << "\n";
+	std::cout << "========================================" << std::endl;
+	std::cout << "           ALL TESTS COMPLETE" << std::endl;
+	std::cout << "========================================" << std::endl;
+	std::cout << "\n";
+
+	return 0;
+}